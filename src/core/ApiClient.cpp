@@ -1,10 +1,210 @@
 #include "ApiClient.h"
 #include "CurlHttpClient.h"
-#include <sstream>
+#include "ModelParser.h"
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <future>
+#include <iterator>
+#include <mutex>
+#include <string_view>
+#include <thread>
+#include <type_traits>
 #include <glog/logging.h>
 
 namespace rickmorty {
 
+namespace {
+
+// Runs task(i) for every i in [0, count) on at most maxWorkers threads, the
+// calling thread included. After the first failure no new tasks are started,
+// and the first exception is rethrown once every worker has joined.
+template<typename Task>
+void runBounded(size_t count, size_t maxWorkers, Task&& task) {
+    std::atomic<size_t> next{0};
+    std::atomic<bool> failed{false};
+    std::exception_ptr firstError;
+    std::mutex errorMutex;
+
+    auto worker = [&]() {
+        for (size_t i = next++; i < count && !failed; i = next++) {
+            try {
+                task(i);
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(errorMutex);
+                if (!firstError) {
+                    firstError = std::current_exception();
+                }
+                failed = true;
+            }
+        }
+    };
+
+    const size_t workerCount = std::min(count, std::max<size_t>(maxWorkers, 1));
+    std::vector<std::thread> threads;
+    try {
+        for (size_t w = 1; w < workerCount; ++w) {
+            threads.emplace_back(worker);
+        }
+    } catch (...) {
+        failed = true;
+        for (auto& t : threads) {
+            t.join();
+        }
+        throw;
+    }
+
+    worker();
+    for (auto& t : threads) {
+        t.join();
+    }
+
+    if (firstError) {
+        std::rethrow_exception(firstError);
+    }
+}
+
+// Builds the URL of a given page using the API's "?page=N" query convention
+std::string pageUrl(const std::string& baseUrl, int page) {
+    const char separator = baseUrl.find('?') == std::string::npos ? '?' : '&';
+    return baseUrl + separator + "page=" + std::to_string(page);
+}
+
+// Parses one page of a paginated response, appending its results to out
+template<typename T>
+PaginationInfo parsePage(std::string_view response, std::vector<T>& out) {
+    try {
+        return parsePageJson(response, out);
+    } catch (const ModelParseError& e) {
+        LOG(ERROR) << "JSON parse error: " << e.what();
+        LOG(ERROR) << "Response (first 500 chars): " << response.substr(0, 500);
+        throw ApiException(ApiException::Type::ParseError,
+            "JSON parse error: " + std::string(e.what()));
+    }
+}
+
+// Maps a transport error onto the API error taxonomy
+ApiException toApiException(const HttpException& e) {
+    switch (e.type()) {
+        case HttpException::Type::NotFound:
+            return ApiException(ApiException::Type::NotFound, e.what());
+        case HttpException::Type::Timeout:
+        case HttpException::Type::NetworkError:
+        case HttpException::Type::InvalidResponse:
+        default:
+            return ApiException(ApiException::Type::NetworkError, e.what());
+    }
+}
+
+// Parses a single resource object (episode, character, location)
+template<typename T>
+T parseSingle(std::string_view response) {
+    try {
+        if constexpr (std::is_same_v<T, Episode>) {
+            return parseEpisodeJson(response);
+        } else if constexpr (std::is_same_v<T, Character>) {
+            return parseCharacterJson(response);
+        } else {
+            return parseLocationJson(response);
+        }
+    } catch (const ModelParseError& e) {
+        throw ApiException(ApiException::Type::ParseError,
+            "JSON parse error: " + std::string(e.what()));
+    }
+}
+
+// Parses a multi-id character response, which is an object for a single id
+std::vector<Character> parseCharacters(std::string_view response) {
+    try {
+        std::vector<Character> characters = parseCharacterListJson(response);
+        LOG(INFO) << "Successfully parsed " << characters.size() << " characters";
+        return characters;
+    } catch (const ModelParseError& e) {
+        LOG(ERROR) << "JSON parse error in fetchCharacters: " << e.what();
+        LOG(ERROR) << "Response (first 500 chars): " << response.substr(0, 500);
+        throw ApiException(ApiException::Type::ParseError,
+            "JSON parse error: " + std::string(e.what()));
+    }
+}
+
+// Splits ids into comma-separated multi-get URLs holding at most maxIds ids and,
+// unless a single id is already longer, at most maxUrlLength bytes each. Ids
+// keep their request order across and within the chunks.
+std::vector<std::string> characterChunkUrls(const std::string& baseUrl, const std::vector<int>& ids,
+                                            size_t maxIds, size_t maxUrlLength) {
+    const std::string prefix = baseUrl + "/character/";
+    std::vector<std::string> urls;
+    std::string url;
+    size_t count = 0;
+    for (int id : ids) {
+        const std::string idText = std::to_string(id);
+        if (count > 0 && (count == maxIds || url.size() + 1 + idText.size() > maxUrlLength)) {
+            urls.push_back(std::move(url));
+            count = 0;
+        }
+        if (count == 0) {
+            url = prefix;
+        } else {
+            url += ',';
+        }
+        url += idText;
+        ++count;
+    }
+    if (count > 0) {
+        urls.push_back(std::move(url));
+    }
+    return urls;
+}
+
+// True for a chunk URL naming one id. The API answers such a request with a
+// 404 when the id is unknown, where a multi-get would simply have left it
+// out; a 404 for several ids points at the URL itself.
+bool isSingleIdChunk(const std::string& url) {
+    return url.find(',', url.rfind('/')) == std::string::npos;
+}
+
+// Concatenates per-chunk results in chunk order
+std::vector<Character> mergeChunks(std::vector<std::vector<Character>>& chunks) {
+    size_t total = 0;
+    for (const auto& chunk : chunks) {
+        total += chunk.size();
+    }
+    std::vector<Character> characters;
+    characters.reserve(total);
+    for (auto& chunk : chunks) {
+        std::move(chunk.begin(), chunk.end(), std::back_inserter(characters));
+    }
+    return characters;
+}
+
+// Issues an async GET and fulfils the returned future with parse(body) on the
+// client's completion thread. HttpException is converted to ApiException, and
+// with NotFoundAsEmpty a 404 yields a default-constructed result instead.
+template<typename Result, bool NotFoundAsEmpty, typename Parse>
+std::future<Result> fetchAsync(IHttpClient& http, const std::string& url, Parse parse) {
+    auto promise = std::make_shared<std::promise<Result>>();
+    std::future<Result> future = promise->get_future();
+    http.getAsync(url, [promise, parse](std::string body, std::exception_ptr error) {
+        try {
+            if (error) {
+                std::rethrow_exception(error);
+            }
+            promise->set_value(parse(body));
+        } catch (const HttpException& e) {
+            if (NotFoundAsEmpty && e.type() == HttpException::Type::NotFound) {
+                promise->set_value(Result{});
+            } else {
+                promise->set_exception(std::make_exception_ptr(toApiException(e)));
+            }
+        } catch (...) {
+            promise->set_exception(std::current_exception());
+        }
+    });
+    return future;
+}
+
+} // namespace
+
 ApiClient::ApiClient()
     : httpClient_(std::make_unique<CurlHttpClient>())
 {
@@ -22,48 +222,86 @@ ApiClient::ApiClient(std::unique_ptr<IHttpClient> httpClient)
 
 ApiClient::~ApiClient() = default;
 
+void ApiClient::setMaxConcurrentRequests(size_t maxConcurrentRequests) {
+    maxConcurrentRequests_ = std::max<size_t>(maxConcurrentRequests, 1);
+}
+
+void ApiClient::setCharacterChunkSize(size_t idsPerRequest) {
+    characterChunkSize_ = std::max<size_t>(idsPerRequest, 1);
+}
+
+void ApiClient::setBaseUrl(std::string baseUrl) {
+    while (!baseUrl.empty() && baseUrl.back() == '/') {
+        baseUrl.pop_back();
+    }
+    baseUrl_ = std::move(baseUrl);
+}
+
+void ApiClient::getOrThrow(const std::string& url, ResponseBuffer& buffer) {
+    try {
+        httpClient_->get(url, buffer);
+    } catch (const HttpException& e) {
+        throw toApiException(e);
+    }
+}
+
 template<typename T>
-std::vector<T> ApiClient::fetchAllPaginated(const std::string& endpoint) {
+std::vector<T> ApiClient::fetchAllPaginated(const std::string& endpoint, const PageProgress& onPage) {
     LOG(INFO) << "Fetching all paginated: " << endpoint;
-    std::vector<T> results;
-    std::string url = std::string(BASE_URL) + endpoint;
-    int page = 1;
+    const std::string firstUrl = baseUrl_ + endpoint;
 
-    while (!url.empty()) {
-        std::string response;
-        try {
-            response = httpClient_->get(url);
-        } catch (const HttpException& e) {
-            // Convert HttpException to ApiException
-            switch (e.type()) {
-                case HttpException::Type::NotFound:
-                    throw ApiException(ApiException::Type::NotFound, e.what());
-                case HttpException::Type::Timeout:
-                case HttpException::Type::NetworkError:
-                    throw ApiException(ApiException::Type::NetworkError, e.what());
-                case HttpException::Type::InvalidResponse:
-                default:
-                    throw ApiException(ApiException::Type::NetworkError, e.what());
-            }
-        }
-
-        try {
-            nlohmann::json j = nlohmann::json::parse(response);
+    std::vector<T> results;
+    ResponseBuffer buffer;
+    getOrThrow(firstUrl, buffer);
+    PaginationInfo info = parsePage(buffer.view(), results);
+    LOG(INFO) << "Page 1/" << info.pages << " - total count: " << info.count;
 
-            PaginationInfo info = j.at("info").get<PaginationInfo>();
-            LOG(INFO) << "Page " << page << "/" << info.pages << " - total count: " << info.count;
+    const size_t total = static_cast<size_t>(std::max(info.count, 0));
+    if (onPage) {
+        onPage(results.size(), total);
+    }
 
-            for (const auto& item : j.at("results")) {
-                results.push_back(item.get<T>());
+    if (info.next && info.pages > 1 && maxConcurrentRequests_ > 1
+        && httpClient_->supportsConcurrentRequests()) {
+        // The first page reveals the page count, so the rest can be fetched
+        // concurrently and stitched back together in page order.
+        const size_t remaining = static_cast<size_t>(info.pages - 1);
+        std::vector<std::vector<T>> pages(remaining);
+        std::mutex progressMutex;
+        size_t fetched = results.size();
+        runBounded(remaining, maxConcurrentRequests_, [&](size_t i) {
+            const int page = static_cast<int>(i) + 2;
+            ResponseBuffer pageBuffer;
+            getOrThrow(pageUrl(firstUrl, page), pageBuffer);
+            parsePage(pageBuffer.view(), pages[i]);
+            LOG(INFO) << "Page " << page << "/" << info.pages << " fetched";
+            if (onPage) {
+                std::lock_guard<std::mutex> lock(progressMutex);
+                fetched += pages[i].size();
+                onPage(fetched, total);
             }
+        });
 
-            url = info.next.value_or("");
+        size_t merged = results.size();
+        for (const auto& items : pages) {
+            merged += items.size();
+        }
+        results.reserve(merged);
+        for (auto& items : pages) {
+            std::move(items.begin(), items.end(), std::back_inserter(results));
+        }
+    } else {
+        std::string url = info.next.value_or("");
+        int page = 2;
+        while (!url.empty()) {
+            getOrThrow(url, buffer);
+            PaginationInfo pageInfo = parsePage(buffer.view(), results);
+            LOG(INFO) << "Page " << page << "/" << pageInfo.pages << " - total count: " << pageInfo.count;
+            if (onPage) {
+                onPage(results.size(), total);
+            }
+            url = pageInfo.next.value_or("");
             page++;
-        } catch (const nlohmann::json::exception& e) {
-            LOG(ERROR) << "JSON parse error: " << e.what();
-            LOG(ERROR) << "Response (first 500 chars): " << response.substr(0, 500);
-            throw ApiException(ApiException::Type::ParseError,
-                "JSON parse error: " + std::string(e.what()));
         }
     }
 
@@ -71,94 +309,89 @@ std::vector<T> ApiClient::fetchAllPaginated(const std::string& endpoint) {
     return results;
 }
 
-std::vector<Episode> ApiClient::fetchAllEpisodes() {
-    return fetchAllPaginated<Episode>("/episode");
+std::vector<Episode> ApiClient::fetchAllEpisodes(const PageProgress& onPage) {
+    return fetchAllPaginated<Episode>("/episode", onPage);
+}
+
+std::vector<Character> ApiClient::fetchAllCharacters(const PageProgress& onPage) {
+    return fetchAllPaginated<Character>("/character", onPage);
+}
+
+std::vector<Location> ApiClient::fetchAllLocations(const PageProgress& onPage) {
+    return fetchAllPaginated<Location>("/location", onPage);
 }
 
 std::optional<Episode> ApiClient::fetchEpisode(int id) {
     try {
-        std::string url = std::string(BASE_URL) + "/episode/" + std::to_string(id);
-        std::string response = httpClient_->get(url);
+        std::string url = baseUrl_ + "/episode/" + std::to_string(id);
+        ResponseBuffer buffer;
+        httpClient_->get(url, buffer);
 
-        nlohmann::json j = nlohmann::json::parse(response);
-        return j.get<Episode>();
+        return parseEpisodeJson(buffer.view());
     } catch (const HttpException& e) {
         if (e.type() == HttpException::Type::NotFound) {
             return std::nullopt;
         }
         // Convert other HttpException types to ApiException
         throw ApiException(ApiException::Type::NetworkError, e.what());
-    } catch (const nlohmann::json::exception& e) {
+    } catch (const ModelParseError& e) {
         throw ApiException(ApiException::Type::ParseError,
             "JSON parse error: " + std::string(e.what()));
     }
 }
 
-std::vector<Character> ApiClient::fetchCharacters(const std::vector<int>& ids) {
+std::vector<Character> ApiClient::fetchCharacters(const std::vector<int>& ids, const BeforeRequest& beforeRequest) {
     if (ids.empty()) {
         LOG(INFO) << "fetchCharacters called with empty ids";
         return {};
     }
 
-    LOG(INFO) << "Fetching " << ids.size() << " characters";
-
-    std::ostringstream idList;
-    for (size_t i = 0; i < ids.size(); ++i) {
-        if (i > 0) idList << ",";
-        idList << ids[i];
-    }
+    const auto urls = characterChunkUrls(baseUrl_, ids, characterChunkSize_, MAX_URL_LENGTH);
+    LOG(INFO) << "Fetching " << ids.size() << " characters in " << urls.size() << " request(s)";
 
-    std::string url = std::string(BASE_URL) + "/character/" + idList.str();
-    std::string response;
-    try {
-        response = httpClient_->get(url);
-    } catch (const HttpException& e) {
-        // Convert HttpException to ApiException
-        switch (e.type()) {
-            case HttpException::Type::NotFound:
-                throw ApiException(ApiException::Type::NotFound, e.what());
-            case HttpException::Type::Timeout:
-            case HttpException::Type::NetworkError:
-            case HttpException::Type::InvalidResponse:
-            default:
-                throw ApiException(ApiException::Type::NetworkError, e.what());
+    if (urls.size() == 1) {
+        if (beforeRequest) {
+            beforeRequest();
         }
+        ResponseBuffer buffer;
+        getOrThrow(urls.front(), buffer);
+        return parseCharacters(buffer.view());
     }
 
-    try {
-        nlohmann::json j = nlohmann::json::parse(response);
-
-        std::vector<Character> characters;
-        if (j.is_array()) {
-            characters = j.get<std::vector<Character>>();
-        } else {
-            characters = { j.get<Character>() };
+    std::vector<std::vector<Character>> chunks(urls.size());
+    const size_t workers = httpClient_->supportsConcurrentRequests() ? maxConcurrentRequests_ : 1;
+    runBounded(urls.size(), workers, [&](size_t i) {
+        if (beforeRequest) {
+            beforeRequest();
         }
-
-        LOG(INFO) << "Successfully parsed " << characters.size() << " characters";
-        return characters;
-    } catch (const nlohmann::json::exception& e) {
-        LOG(ERROR) << "JSON parse error in fetchCharacters: " << e.what();
-        LOG(ERROR) << "Response (first 500 chars): " << response.substr(0, 500);
-        throw ApiException(ApiException::Type::ParseError,
-            "JSON parse error: " + std::string(e.what()));
-    }
+        ResponseBuffer chunkBuffer;
+        try {
+            httpClient_->get(urls[i], chunkBuffer);
+        } catch (const HttpException& e) {
+            if (e.type() == HttpException::Type::NotFound && isSingleIdChunk(urls[i])) {
+                return;
+            }
+            throw toApiException(e);
+        }
+        chunks[i] = parseCharacters(chunkBuffer.view());
+    });
+    return mergeChunks(chunks);
 }
 
 std::optional<Character> ApiClient::fetchCharacter(int id) {
     try {
-        std::string url = std::string(BASE_URL) + "/character/" + std::to_string(id);
-        std::string response = httpClient_->get(url);
+        std::string url = baseUrl_ + "/character/" + std::to_string(id);
+        ResponseBuffer buffer;
+        httpClient_->get(url, buffer);
 
-        nlohmann::json j = nlohmann::json::parse(response);
-        return j.get<Character>();
+        return parseCharacterJson(buffer.view());
     } catch (const HttpException& e) {
         if (e.type() == HttpException::Type::NotFound) {
             return std::nullopt;
         }
         // Convert other HttpException types to ApiException
         throw ApiException(ApiException::Type::NetworkError, e.what());
-    } catch (const nlohmann::json::exception& e) {
+    } catch (const ModelParseError& e) {
         throw ApiException(ApiException::Type::ParseError,
             "JSON parse error: " + std::string(e.what()));
     }
@@ -166,21 +399,67 @@ std::optional<Character> ApiClient::fetchCharacter(int id) {
 
 std::optional<Location> ApiClient::fetchLocation(int id) {
     try {
-        std::string url = std::string(BASE_URL) + "/location/" + std::to_string(id);
-        std::string response = httpClient_->get(url);
+        std::string url = baseUrl_ + "/location/" + std::to_string(id);
+        ResponseBuffer buffer;
+        httpClient_->get(url, buffer);
 
-        nlohmann::json j = nlohmann::json::parse(response);
-        return j.get<Location>();
+        return parseLocationJson(buffer.view());
     } catch (const HttpException& e) {
         if (e.type() == HttpException::Type::NotFound) {
             return std::nullopt;
         }
         // Convert other HttpException types to ApiException
         throw ApiException(ApiException::Type::NetworkError, e.what());
-    } catch (const nlohmann::json::exception& e) {
+    } catch (const ModelParseError& e) {
         throw ApiException(ApiException::Type::ParseError,
             "JSON parse error: " + std::string(e.what()));
     }
 }
 
+std::future<std::optional<Episode>> ApiClient::fetchEpisodeAsync(int id) {
+    std::string url = baseUrl_ + "/episode/" + std::to_string(id);
+    return fetchAsync<std::optional<Episode>, true>(*httpClient_, url,
+        [](const std::string& body) { return std::optional<Episode>(parseSingle<Episode>(body)); });
+}
+
+std::future<std::vector<Character>> ApiClient::fetchCharactersAsync(const std::vector<int>& ids) {
+    if (ids.empty()) {
+        std::promise<std::vector<Character>> ready;
+        ready.set_value({});
+        return ready.get_future();
+    }
+
+    const auto urls = characterChunkUrls(baseUrl_, ids, characterChunkSize_, MAX_URL_LENGTH);
+    LOG(INFO) << "Fetching " << ids.size() << " characters in " << urls.size() << " request(s) (async)";
+
+    auto parse = [](const std::string& body) { return parseCharacters(body); };
+    if (urls.size() == 1) {
+        return fetchAsync<std::vector<Character>, false>(*httpClient_, urls.front(), parse);
+    }
+
+    // Every chunk is issued up front; the transport's own connection limits
+    // bound how many are on the wire, and a blocking getAsync() (as in the
+    // decorators) runs them one by one. The merge runs in the caller's get().
+    std::vector<std::future<std::vector<Character>>> parts;
+    parts.reserve(urls.size());
+    for (const auto& url : urls) {
+        parts.push_back(isSingleIdChunk(url) ? fetchAsync<std::vector<Character>, true>(*httpClient_, url, parse)
+                                             : fetchAsync<std::vector<Character>, false>(*httpClient_, url, parse));
+    }
+    return std::async(std::launch::deferred, [parts = std::move(parts)]() mutable {
+        std::vector<std::vector<Character>> chunks;
+        chunks.reserve(parts.size());
+        for (auto& part : parts) {
+            chunks.push_back(part.get());
+        }
+        return mergeChunks(chunks);
+    });
+}
+
+std::future<std::optional<Location>> ApiClient::fetchLocationAsync(int id) {
+    std::string url = baseUrl_ + "/location/" + std::to_string(id);
+    return fetchAsync<std::optional<Location>, true>(*httpClient_, url,
+        [](const std::string& body) { return std::optional<Location>(parseSingle<Location>(body)); });
+}
+
 } // namespace rickmorty
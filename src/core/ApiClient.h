@@ -3,6 +3,8 @@
 #include <string>
 #include <vector>
 #include <optional>
+#include <functional>
+#include <future>
 #include <stdexcept>
 #include <memory>
 #include "Models.h"
@@ -77,21 +79,110 @@ public:
     ApiClient(const ApiClient&) = delete;
     ApiClient& operator=(const ApiClient&) = delete;
 
-    std::vector<Episode> fetchAllEpisodes();
+    /**
+     * @brief Called after each page of a paginated fetch.
+     *
+     * Receives the number of items fetched so far and the endpoint's total
+     * count. With parallel fan-out it runs on the worker threads, one call at
+     * a time. Throwing from it abandons the fetch and rethrows to the caller.
+     */
+    using PageProgress = std::function<void(size_t fetched, size_t total)>;
+
+    std::vector<Episode> fetchAllEpisodes(const PageProgress& onPage = {});
     std::optional<Episode> fetchEpisode(int id);
 
-    std::vector<Character> fetchCharacters(const std::vector<int>& ids);
+    /**
+     * @brief Bulk variants for warming a full local copy of the dataset.
+     *
+     * Walk /character and /location page by page (in parallel where
+     * allowed) instead of one request per episode or per location.
+     */
+    std::vector<Character> fetchAllCharacters(const PageProgress& onPage = {});
+    std::vector<Location> fetchAllLocations(const PageProgress& onPage = {});
+
+    /**
+     * @brief Called before each HTTP request of a fetchCharacters call.
+     *
+     * Runs on the worker threads when chunks are fetched in parallel.
+     * Throwing from it skips that request and every one not yet started,
+     * and the exception is rethrown to the caller, so a caller can drop a
+     * fetch it no longer needs.
+     */
+    using BeforeRequest = std::function<void()>;
+
+    // When ids are split over several requests, a 404 for a chunk naming one
+    // id leaves that id out; a 404 for several ids throws ApiException::NotFound
+    std::vector<Character> fetchCharacters(const std::vector<int>& ids, const BeforeRequest& beforeRequest = {});
     std::optional<Character> fetchCharacter(int id);
 
     std::optional<Location> fetchLocation(int id);
 
+    /**
+     * @brief Non-blocking variants of fetchEpisode, fetchCharacters and fetchLocation.
+     *
+     * Requests go through IHttpClient::getAsync, so with a bare
+     * CurlHttpClient no thread is blocked while they are in flight. The
+     * returned futures yield the same results and throw the same
+     * ApiException types as the blocking calls; parsing happens on the HTTP
+     * client's completion thread. When fetchCharactersAsync splits ids into
+     * several requests, the chunks are merged in the caller's future::get().
+     *
+     * The Coalescing, Caching and RateLimited decorators keep IHttpClient's
+     * blocking getAsync() so that these requests are coalesced, cached and
+     * throttled too. Through them, as in the application's stack, each call
+     * runs its requests on the calling thread, one chunk after another, and
+     * returns once they have all completed; only the chunk merge is left
+     * for future::get().
+     */
+    std::future<std::optional<Episode>> fetchEpisodeAsync(int id);
+    std::future<std::vector<Character>> fetchCharactersAsync(const std::vector<int>& ids);
+    std::future<std::optional<Location>> fetchLocationAsync(int id);
+
+    /**
+     * @brief Limits how many requests a single call may have in flight at once.
+     * @param maxConcurrentRequests Upper bound on parallel requests (values below 1 are treated as 1).
+     *
+     * Parallel fan-out is only used when the injected IHttpClient reports
+     * supportsConcurrentRequests(); otherwise requests are always serial.
+     */
+    void setMaxConcurrentRequests(size_t maxConcurrentRequests);
+    size_t maxConcurrentRequests() const { return maxConcurrentRequests_; }
+
+    /**
+     * @brief Bounds how many ids fetchCharacters puts into one multi-get URL.
+     * @param idsPerRequest Maximum ids per /character/1,2,3 request (values below 1 are treated as 1).
+     *
+     * Longer id lists are split into chunks, each also kept under
+     * MAX_URL_LENGTH bytes, which are fetched concurrently within the
+     * setMaxConcurrentRequests() limit and merged back in request order.
+     */
+    void setCharacterChunkSize(size_t idsPerRequest);
+    size_t characterChunkSize() const { return characterChunkSize_; }
+
+    /**
+     * @brief Points the client at another API root, e.g. a local stand-in server.
+     * @param baseUrl Root URL without a trailing slash (default https://rickandmortyapi.com/api).
+     */
+    void setBaseUrl(std::string baseUrl);
+    const std::string& baseUrl() const { return baseUrl_; }
+
 private:
-    static constexpr const char* BASE_URL = "https://rickandmortyapi.com/api";
+    static constexpr const char* DEFAULT_BASE_URL = "https://rickandmortyapi.com/api";
+    static constexpr size_t DEFAULT_MAX_CONCURRENT_REQUESTS = 6;
+    static constexpr size_t DEFAULT_CHARACTER_CHUNK_SIZE = 100;
+    // Conservative limit that common servers and proxies accept for a request line
+    static constexpr size_t MAX_URL_LENGTH = 2048;
+
+    // Performs a GET into a pooled buffer and converts HttpException into ApiException
+    void getOrThrow(const std::string& url, ResponseBuffer& buffer);
 
     template<typename T>
-    std::vector<T> fetchAllPaginated(const std::string& endpoint);
+    std::vector<T> fetchAllPaginated(const std::string& endpoint, const PageProgress& onPage);
 
     std::unique_ptr<IHttpClient> httpClient_;
+    size_t maxConcurrentRequests_ = DEFAULT_MAX_CONCURRENT_REQUESTS;
+    size_t characterChunkSize_ = DEFAULT_CHARACTER_CHUNK_SIZE;
+    std::string baseUrl_ = DEFAULT_BASE_URL;
 };
 
 } // namespace rickmorty
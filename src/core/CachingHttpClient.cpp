@@ -0,0 +1,255 @@
+#include "CachingHttpClient.h"
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <sstream>
+#include <thread>
+#include <glog/logging.h>
+
+namespace rickmorty {
+
+namespace {
+
+// FNV-1a, used for stable on-disk file names (std::hash is not guaranteed stable)
+uint64_t fnv1a(const std::string& text) {
+    uint64_t hash = 14695981039346656037ULL;
+    for (unsigned char c : text) {
+        hash ^= c;
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+size_t entryBytes(const std::string& url, const HttpValidators& validators, const std::string& body) {
+    return url.size() + validators.etag.size() + validators.lastModified.size() + body.size();
+}
+
+} // namespace
+
+CachingHttpClient::CachingHttpClient(std::unique_ptr<IHttpClient> inner, std::string cacheDirectory)
+    : inner_(std::move(inner))
+    , cacheDirectory_(std::move(cacheDirectory))
+{
+    if (!inner_) {
+        throw HttpException(HttpException::Type::NetworkError, "Wrapped HTTP client cannot be null");
+    }
+
+    if (!cacheDirectory_.empty()) {
+        std::error_code ec;
+        std::filesystem::create_directories(cacheDirectory_, ec);
+        if (ec) {
+            LOG(WARNING) << "Cannot create HTTP cache directory " << cacheDirectory_
+                         << ": " << ec.message() << "; caching in memory only";
+            cacheDirectory_.clear();
+        } else {
+            LOG(INFO) << "HTTP cache directory: " << cacheDirectory_;
+        }
+    }
+}
+
+CachingHttpClient::~CachingHttpClient() = default;
+
+std::string CachingHttpClient::get(const std::string& url) {
+    std::string body;
+    getInto(url, body);
+    return body;
+}
+
+void CachingHttpClient::getInto(const std::string& url, std::string& body) {
+    const EntryPtr cached = lookup(url);
+
+    // Lend the caller's storage to the transfer, so a full response is written in place
+    HttpResponse response;
+    response.body.swap(body);
+    try {
+        inner_->getConditionalInto(url, cached ? cached->validators : HttpValidators{}, response);
+    } catch (...) {
+        body.swap(response.body);
+        throw;
+    }
+    body.swap(response.body);
+
+    if (response.notModified()) {
+        if (!cached) {
+            // Only possible if the server ignores the (empty) validators; treat as a bad answer
+            throw HttpException(HttpException::Type::InvalidResponse,
+                "Unexpected 304 Not Modified without a cached copy", 304);
+        }
+        LOG(INFO) << "HTTP cache revalidated: " << url;
+        notModified_++;
+        bytesSaved_ += cached->body.size();
+        // The one copy of a revalidated body, into the caller's capacity if it fits
+        body.assign(cached->body);
+        return;
+    }
+
+    fullResponses_++;
+    if (!response.validators.empty()) {
+        store(url, std::make_shared<const Entry>(Entry{std::move(response.validators), body}));
+    }
+}
+
+HttpResponse CachingHttpClient::getConditional(const std::string& url, const HttpValidators& validators) {
+    return inner_->getConditional(url, validators);
+}
+
+void CachingHttpClient::setTimeout(long timeoutMs) {
+    inner_->setTimeout(timeoutMs);
+}
+
+void CachingHttpClient::setUserAgent(const std::string& userAgent) {
+    inner_->setUserAgent(userAgent);
+}
+
+bool CachingHttpClient::supportsConcurrentRequests() const {
+    return inner_->supportsConcurrentRequests();
+}
+
+void CachingHttpClient::setMemoryBudget(size_t bytes) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    memoryBudget_ = bytes;
+    evictOverBudget();
+}
+
+void CachingHttpClient::clear() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    entries_.clear();
+    recency_.clear();
+    memoryBytes_ = 0;
+    if (!cacheDirectory_.empty()) {
+        std::error_code ec;
+        for (const auto& file : std::filesystem::directory_iterator(cacheDirectory_, ec)) {
+            // Including temporaries left behind by an interrupted write
+            if (file.path().extension() == ".entry" || file.path().extension() == ".tmp") {
+                std::filesystem::remove(file.path(), ec);
+            }
+        }
+    }
+}
+
+CachingHttpClient::Stats CachingHttpClient::stats() const {
+    Stats stats;
+    stats.fullResponses = fullResponses_.load();
+    stats.notModified = notModified_.load();
+    stats.bytesSaved = bytesSaved_.load();
+    std::lock_guard<std::mutex> lock(mutex_);
+    stats.memoryEntries = entries_.size();
+    stats.memoryBytes = memoryBytes_;
+    return stats;
+}
+
+CachingHttpClient::EntryPtr CachingHttpClient::lookup(const std::string& url) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = entries_.find(url);
+        if (it != entries_.end()) {
+            recency_.splice(recency_.begin(), recency_, it->second.recency);
+            return it->second.entry;
+        }
+    }
+
+    // Read without the lock, so other lookups never wait on the disk
+    EntryPtr entry = load(url);
+    if (entry) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        remember(url, entry);
+    }
+    return entry;
+}
+
+CachingHttpClient::EntryPtr CachingHttpClient::load(const std::string& url) const {
+    if (cacheDirectory_.empty()) {
+        return nullptr;
+    }
+
+    // Entry file layout: URL, ETag and Last-Modified on one line each, then the body
+    std::ifstream file(entryPath(url), std::ios::binary);
+    if (!file) {
+        return nullptr;
+    }
+    std::string storedUrl;
+    Entry entry;
+    if (!std::getline(file, storedUrl) || storedUrl != url
+        || !std::getline(file, entry.validators.etag)
+        || !std::getline(file, entry.validators.lastModified)) {
+        return nullptr;
+    }
+    entry.body.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    return std::make_shared<const Entry>(std::move(entry));
+}
+
+void CachingHttpClient::store(const std::string& url, EntryPtr entry) {
+    // Written before taking the lock, so lookups never wait on the disk
+    if (!cacheDirectory_.empty()) {
+        persist(url, *entry);
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    remember(url, std::move(entry));
+}
+
+void CachingHttpClient::remember(const std::string& url, EntryPtr entry) {
+    const size_t bytes = entryBytes(url, entry->validators, entry->body);
+    auto it = entries_.find(url);
+    if (it != entries_.end()) {
+        const Entry& old = *it->second.entry;
+        memoryBytes_ -= entryBytes(url, old.validators, old.body);
+        it->second.entry = std::move(entry);
+        recency_.splice(recency_.begin(), recency_, it->second.recency);
+    } else {
+        recency_.push_front(url);
+        entries_.emplace(url, Resident{std::move(entry), recency_.begin()});
+    }
+    memoryBytes_ += bytes;
+    evictOverBudget();
+}
+
+void CachingHttpClient::evictOverBudget() {
+    while (memoryBytes_ > memoryBudget_ && !recency_.empty()) {
+        auto it = entries_.find(recency_.back());
+        const Entry& victim = *it->second.entry;
+        memoryBytes_ -= entryBytes(it->first, victim.validators, victim.body);
+        entries_.erase(it);
+        recency_.pop_back();
+    }
+}
+
+void CachingHttpClient::persist(const std::string& url, const Entry& entry) const {
+    // Write to a temporary file and rename, so readers never see a partial
+    // entry. The name is per thread, as two threads may store the same URL.
+    const std::string path = entryPath(url);
+    const std::string tmpPath =
+        path + "." + std::to_string(std::hash<std::thread::id>()(std::this_thread::get_id())) + ".tmp";
+    bool written = false;
+    {
+        std::ofstream file(tmpPath, std::ios::binary | std::ios::trunc);
+        file << url << '\n'
+             << entry.validators.etag << '\n'
+             << entry.validators.lastModified << '\n'
+             << entry.body;
+        file.flush();
+        written = file.good();
+    }
+
+    std::error_code ec;
+    if (!written) {
+        // A truncated body would be served on every later 304
+        LOG(WARNING) << "Failed to write HTTP cache entry for " << url << "; not persisted";
+        std::filesystem::remove(tmpPath, ec);
+        return;
+    }
+    std::filesystem::rename(tmpPath, path, ec);
+    if (ec) {
+        LOG(WARNING) << "Failed to persist HTTP cache entry for " << url << ": " << ec.message();
+        std::filesystem::remove(tmpPath, ec);
+    }
+}
+
+std::string CachingHttpClient::entryPath(const std::string& url) const {
+    char name[32];
+    std::snprintf(name, sizeof(name), "%016llx.entry", static_cast<unsigned long long>(fnv1a(url)));
+    return (std::filesystem::path(cacheDirectory_) / name).string();
+}
+
+} // namespace rickmorty
@@ -0,0 +1,156 @@
+#pragma once
+
+/**
+ * @file CachingHttpClient.h
+ * @brief IHttpClient decorator that revalidates cached responses with conditional GETs.
+ */
+
+#include "IHttpClient.h"
+#include <atomic>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace rickmorty {
+
+/**
+ * @class CachingHttpClient
+ * @brief HTTP response cache keyed by URL, revalidated with ETag / Last-Modified.
+ *
+ * Wraps another IHttpClient. The first request for a URL is a normal GET;
+ * the body is stored together with the ETag and Last-Modified validators the
+ * server returned. Later requests for the same URL are sent as conditional
+ * GETs (If-None-Match / If-Modified-Since) and a 304 Not Modified answer is
+ * served from the cache, saving the download. Responses without validators
+ * are not cached.
+ *
+ * When constructed with a cache directory, entries are also written to disk
+ * and read back on demand, so revalidation keeps working across restarts.
+ *
+ * Entries held in memory are bounded by setMemoryBudget(); beyond it the
+ * least recently used are dropped from memory. With a cache directory they
+ * are read back from disk when next requested, otherwise that request is a
+ * plain GET.
+ *
+ * @note Thread-safe as long as the wrapped client is; supportsConcurrentRequests()
+ *       forwards to it. getAsync() uses the blocking default from IHttpClient
+ *       so that it goes through the cache.
+ *
+ * Example usage:
+ * @code
+ * auto http = std::make_unique<CachingHttpClient>(
+ *     std::make_unique<CurlHttpClient>(), "/home/user/.cache/app/http");
+ * ApiClient client(std::move(http));
+ * @endcode
+ */
+class CachingHttpClient : public IHttpClient {
+public:
+    /**
+     * @struct Stats
+     * @brief Counters describing how requests were answered.
+     */
+    struct Stats {
+        uint64_t fullResponses = 0;  ///< Requests answered with a full body
+        uint64_t notModified = 0;    ///< Revalidations answered with 304 and served from cache
+        uint64_t bytesSaved = 0;     ///< Body bytes not downloaded thanks to 304 answers
+        size_t memoryEntries = 0;    ///< Entries currently held in memory
+        size_t memoryBytes = 0;      ///< Their URLs, validators and bodies
+    };
+
+    static constexpr size_t DEFAULT_MEMORY_BUDGET = 8 * 1024 * 1024;
+
+    /**
+     * @brief Wraps an HTTP client with an in-memory (and optionally on-disk) cache.
+     * @param inner The client that performs the actual requests (must not be null).
+     * @param cacheDirectory Directory for persistent entries; empty keeps the cache in memory only.
+     * @throws HttpException if inner is null.
+     */
+    explicit CachingHttpClient(std::unique_ptr<IHttpClient> inner, std::string cacheDirectory = {});
+    ~CachingHttpClient() override;
+
+    CachingHttpClient(const CachingHttpClient&) = delete;
+    CachingHttpClient& operator=(const CachingHttpClient&) = delete;
+
+    /**
+     * @brief Returns the body for url, revalidating a cached copy if there is one.
+     * @throws HttpException as thrown by the wrapped client.
+     */
+    std::string get(const std::string& url) override;
+
+    using IHttpClient::get;
+
+    /**
+     * @brief As get(), writing a full response into body in place and
+     *        copying a revalidated one into its existing capacity. A full
+     *        response with validators is copied once more, into the cache.
+     */
+    void getInto(const std::string& url, std::string& body) override;
+
+    /**
+     * @brief Forwards to the wrapped client without consulting the cache.
+     */
+    HttpResponse getConditional(const std::string& url, const HttpValidators& validators) override;
+
+    void setTimeout(long timeoutMs) override;
+    void setUserAgent(const std::string& userAgent) override;
+    bool supportsConcurrentRequests() const override;
+
+    /**
+     * @brief Caps the bytes of entries kept in memory, evicting at once if over.
+     * @param bytes Budget; entries larger than it are not kept in memory at all.
+     */
+    void setMemoryBudget(size_t bytes);
+
+    /**
+     * @brief Drops all cached entries from memory and disk.
+     */
+    void clear();
+
+    /**
+     * @brief Returns a snapshot of the cache counters.
+     */
+    Stats stats() const;
+
+private:
+    struct Entry {
+        HttpValidators validators;
+        std::string body;
+    };
+    // Shared with requests in progress, so a lookup copies no body
+    using EntryPtr = std::shared_ptr<const Entry>;
+
+    struct Resident {
+        EntryPtr entry;
+        std::list<std::string>::iterator recency;
+    };
+
+    // nullptr when the URL has no cached entry
+    EntryPtr lookup(const std::string& url);
+    EntryPtr load(const std::string& url) const;
+    void store(const std::string& url, EntryPtr entry);
+    // Keeps the entry in memory as the most recently used; caller holds mutex_
+    void remember(const std::string& url, EntryPtr entry);
+    // Drops least recently used entries until within budget; caller holds mutex_
+    void evictOverBudget();
+    // Writes the entry file; leaves any previous file in place if the write fails
+    void persist(const std::string& url, const Entry& entry) const;
+    std::string entryPath(const std::string& url) const;
+
+    std::unique_ptr<IHttpClient> inner_;
+    std::string cacheDirectory_;
+
+    mutable std::mutex mutex_;
+    std::unordered_map<std::string, Resident> entries_;
+    std::list<std::string> recency_;   // URLs, most recently used first
+    size_t memoryBytes_ = 0;
+    size_t memoryBudget_ = DEFAULT_MEMORY_BUDGET;
+
+    std::atomic<uint64_t> fullResponses_{0};
+    std::atomic<uint64_t> notModified_{0};
+    std::atomic<uint64_t> bytesSaved_{0};
+};
+
+} // namespace rickmorty
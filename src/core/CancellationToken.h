@@ -0,0 +1,43 @@
+#pragma once
+
+/**
+ * @file CancellationToken.h
+ * @brief Shared flag for telling a running load that its result is no longer wanted.
+ */
+
+#include <atomic>
+#include <memory>
+#include <stdexcept>
+
+namespace rickmorty {
+
+/**
+ * @class CancellationToken
+ * @brief Cooperative cancellation: the requester calls cancel(), the worker
+ *        polls isCancelled() at points where stopping is safe.
+ *
+ * Copies share one flag, so the caller keeps a copy to cancel and hands
+ * another to the work. Cancelling never interrupts a request already on
+ * the wire; it stops the work before its next one. Thread-safe.
+ */
+class CancellationToken {
+public:
+    CancellationToken() : cancelled_(std::make_shared<std::atomic<bool>>(false)) {}
+
+    void cancel() const { cancelled_->store(true); }
+    bool isCancelled() const { return cancelled_->load(); }
+
+private:
+    std::shared_ptr<std::atomic<bool>> cancelled_;
+};
+
+/**
+ * @class LoadCancelled
+ * @brief Thrown inside a load to unwind it once every requester has cancelled.
+ */
+class LoadCancelled : public std::runtime_error {
+public:
+    LoadCancelled() : std::runtime_error("Load cancelled") {}
+};
+
+} // namespace rickmorty
@@ -0,0 +1,301 @@
+#include "CharacterTable.h"
+#include "StringPool.h"
+#include <algorithm>
+#include <cstddef>
+#include <numeric>
+
+namespace rickmorty {
+
+namespace {
+
+// First 8 bytes of the name, big-endian and zero-padded, so that comparing
+// prefixes as integers orders names like std::string::compare
+uint64_t namePrefix(std::string_view name) {
+    uint64_t prefix = 0;
+    for (size_t i = 0; i < sizeof(prefix); ++i) {
+        prefix <<= 8;
+        if (i < name.size()) {
+            prefix |= static_cast<unsigned char>(name[i]);
+        }
+    }
+    return prefix;
+}
+
+} // namespace
+
+void CharacterTable::upsert(Character character) {
+    std::optional<Row> existing = findRow(character.id);
+    const Row row = existing ? *existing : static_cast<Row>(records_.size());
+
+    if (!existing) {
+        if (character.id >= 0 && character.id < MAX_DENSE_ID) {
+            if (static_cast<size_t>(character.id) >= rowById_.size()) {
+                rowById_.resize(static_cast<size_t>(character.id) + 1, -1);
+            }
+            rowById_[character.id] = static_cast<int32_t>(row);
+        } else {
+            sparseRows_[character.id] = row;
+        }
+        ids_.push_back(character.id);
+        status_.emplace_back();
+        gender_.emplace_back();
+        species_.emplace_back();
+        names_.emplace_back();
+        namePrefixes_.emplace_back();
+        records_.emplace_back();
+        nameRank_.push_back(NO_RANK);
+        nameOrderStale_ = true;
+    }
+
+    status_[row] = character.status;
+    gender_[row] = character.gender;
+    species_[row] = internSpecies(character.species);
+    setName(row, character.name);
+    records_[row] = std::make_shared<const Character>(std::move(character));
+}
+
+bool CharacterTable::remove(int id) {
+    const std::optional<Row> found = findRow(id);
+    if (!found) {
+        return false;
+    }
+    const Row row = *found;
+    const Row last = static_cast<Row>(records_.size() - 1);
+
+    auto setRow = [this](int key, int32_t value) {
+        if (key >= 0 && key < MAX_DENSE_ID) {
+            rowById_[key] = value;
+        } else if (value < 0) {
+            sparseRows_.erase(key);
+        } else {
+            sparseRows_[key] = static_cast<Row>(value);
+        }
+    };
+    setRow(id, -1);
+    staleNameBytes_ += names_[row].length;
+    unrank(row);
+    if (row != last) {
+        ids_[row] = ids_[last];
+        status_[row] = status_[last];
+        gender_[row] = gender_[last];
+        species_[row] = species_[last];
+        names_[row] = names_[last];
+        namePrefixes_[row] = namePrefixes_[last];
+        records_[row] = std::move(records_[last]);
+        nameRank_[row] = nameRank_[last];
+        if (nameRank_[row] != NO_RANK) {
+            nameOrder_[nameRank_[row]] = row;
+        }
+        setRow(ids_[row], static_cast<int32_t>(row));
+    }
+
+    ids_.pop_back();
+    status_.pop_back();
+    gender_.pop_back();
+    species_.pop_back();
+    names_.pop_back();
+    namePrefixes_.pop_back();
+    records_.pop_back();
+    nameRank_.pop_back();
+    compactNamesIfSparse();
+    return true;
+}
+
+void CharacterTable::reserve(size_t rows) {
+    ids_.reserve(rows);
+    status_.reserve(rows);
+    gender_.reserve(rows);
+    species_.reserve(rows);
+    names_.reserve(rows);
+    namePrefixes_.reserve(rows);
+    records_.reserve(rows);
+    nameRank_.reserve(rows);
+}
+
+void CharacterTable::clear() {
+    *this = CharacterTable();
+}
+
+std::optional<CharacterTable::Row> CharacterTable::findRow(int id) const {
+    if (id >= 0 && id < MAX_DENSE_ID) {
+        if (static_cast<size_t>(id) < rowById_.size() && rowById_[id] >= 0) {
+            return static_cast<Row>(rowById_[id]);
+        }
+        return std::nullopt;
+    }
+    auto it = sparseRows_.find(id);
+    if (it != sparseRows_.end()) {
+        return it->second;
+    }
+    return std::nullopt;
+}
+
+CharacterPtr CharacterTable::find(int id) const {
+    std::optional<Row> row = findRow(id);
+    return row ? records_[*row] : nullptr;
+}
+
+std::string_view CharacterTable::name(Row row) const {
+    const NameSpan& span = names_[row];
+    return std::string_view(nameArena_).substr(span.offset, span.length);
+}
+
+size_t CharacterTable::rowBytes(Row row) const {
+    // make_shared puts the record and its control block in one allocation
+    constexpr size_t CONTROL_BLOCK_BYTES = 2 * sizeof(long);
+    constexpr size_t COLUMN_BYTES = sizeof(int) + sizeof(CharacterStatus) + sizeof(Gender) + sizeof(SpeciesId) +
+                                    sizeof(NameSpan) + sizeof(uint64_t) + sizeof(CharacterPtr) + sizeof(int32_t);
+    const Character& c = *records_[row];
+    return sizeof(Character) + CONTROL_BLOCK_BYTES + StringPool::heapBytes(c.name.size()) +
+           StringPool::heapBytes(c.imageUrl.size()) + c.episodeIds.capacity() * sizeof(int) +
+           COLUMN_BYTES + names_[row].length;
+}
+
+std::optional<CharacterTable::SpeciesId> CharacterTable::speciesId(std::string_view species) const {
+    for (SpeciesId id = 0; id < speciesNames_.size(); ++id) {
+        if (speciesNames_[id] == species) {
+            return id;
+        }
+    }
+    return std::nullopt;
+}
+
+std::vector<CharacterTable::Row> CharacterTable::rowsWithStatus(CharacterStatus status) const {
+    std::vector<Row> rows;
+    for (Row row = 0; row < status_.size(); ++row) {
+        if (status_[row] == status) {
+            rows.push_back(row);
+        }
+    }
+    return rows;
+}
+
+std::vector<CharacterTable::Row> CharacterTable::rowsWithSpecies(std::string_view species) const {
+    std::vector<Row> rows;
+    const std::optional<SpeciesId> id = speciesId(species);
+    if (!id) {
+        return rows;
+    }
+    for (Row row = 0; row < species_.size(); ++row) {
+        if (species_[row] == *id) {
+            rows.push_back(row);
+        }
+    }
+    return rows;
+}
+
+std::vector<CharacterTable::Row> CharacterTable::rowsSortedByName() const {
+    if (nameOrderCurrent()) {
+        return nameOrder_;
+    }
+    std::vector<Row> rows(records_.size());
+    std::iota(rows.begin(), rows.end(), Row{0});
+    sortByName(rows);
+    return rows;
+}
+
+void CharacterTable::sortByName(std::vector<Row>& rows) const {
+    if (nameOrderCurrent()) {
+        std::sort(rows.begin(), rows.end(), [this](Row a, Row b) { return nameRank_[a] < nameRank_[b]; });
+    } else {
+        std::sort(rows.begin(), rows.end(), [this](Row a, Row b) { return nameLess(a, b); });
+    }
+}
+
+void CharacterTable::refreshNameOrder() {
+    if (nameOrderCurrent()) {
+        return;
+    }
+    std::vector<Row> unranked;
+    for (Row row = 0; row < nameRank_.size(); ++row) {
+        if (nameRank_[row] == NO_RANK) {
+            unranked.push_back(row);
+        }
+    }
+    std::sort(unranked.begin(), unranked.end(), [this](Row a, Row b) { return nameLess(a, b); });
+
+    // The rows still ranked keep their relative order, so one merge pass
+    // restores the full order
+    nameOrder_.erase(std::remove(nameOrder_.begin(), nameOrder_.end(), NO_ROW), nameOrder_.end());
+    const auto ranked = static_cast<std::ptrdiff_t>(nameOrder_.size());
+    nameOrder_.insert(nameOrder_.end(), unranked.begin(), unranked.end());
+    std::inplace_merge(nameOrder_.begin(), nameOrder_.begin() + ranked, nameOrder_.end(),
+                       [this](Row a, Row b) { return nameLess(a, b); });
+
+    for (uint32_t rank = 0; rank < nameOrder_.size(); ++rank) {
+        nameRank_[nameOrder_[rank]] = rank;
+    }
+    nameOrderStale_ = false;
+}
+
+bool CharacterTable::nameLess(Row a, Row b) const {
+    if (namePrefixes_[a] != namePrefixes_[b]) {
+        return namePrefixes_[a] < namePrefixes_[b];
+    }
+    const int order = name(a).compare(name(b));
+    return order != 0 ? order < 0 : ids_[a] < ids_[b];
+}
+
+void CharacterTable::unrank(Row row) {
+    if (nameRank_[row] != NO_RANK) {
+        nameOrder_[nameRank_[row]] = NO_ROW;
+        nameRank_[row] = NO_RANK;
+    }
+    nameOrderStale_ = true;
+}
+
+std::vector<CharacterPtr> CharacterTable::select(const std::vector<Row>& rows) const {
+    std::vector<CharacterPtr> result;
+    result.reserve(rows.size());
+    for (Row row : rows) {
+        result.push_back(records_[row]);
+    }
+    return result;
+}
+
+CharacterTable::SpeciesId CharacterTable::internSpecies(const InternedString& species) {
+    // Interned strings share one address per value, so the pointer is the key
+    auto [it, inserted] = speciesIndex_.try_emplace(species.pooled(), static_cast<SpeciesId>(speciesNames_.size()));
+    if (inserted) {
+        speciesNames_.push_back(species);
+    }
+    return it->second;
+}
+
+void CharacterTable::setName(Row row, const std::string& name) {
+    NameSpan& span = names_[row];
+    if (this->name(row) == name) {
+        return;
+    }
+    unrank(row);
+    namePrefixes_[row] = namePrefix(name);
+    if (name.size() == span.length) {
+        nameArena_.replace(span.offset, span.length, name);
+        return;
+    }
+
+    staleNameBytes_ += span.length;
+    span.offset = static_cast<uint32_t>(nameArena_.size());
+    span.length = static_cast<uint32_t>(name.size());
+    nameArena_ += name;
+
+    // Renames append
+    compactNamesIfSparse();
+}
+
+void CharacterTable::compactNamesIfSparse() {
+    if (staleNameBytes_ <= nameArena_.size() / 2) {
+        return;
+    }
+    std::string compacted;
+    compacted.reserve(nameArena_.size() - staleNameBytes_);
+    for (NameSpan& live : names_) {
+        const uint32_t offset = static_cast<uint32_t>(compacted.size());
+        compacted.append(nameArena_, live.offset, live.length);
+        live.offset = offset;
+    }
+    nameArena_ = std::move(compacted);
+    staleNameBytes_ = 0;
+}
+
+} // namespace rickmorty
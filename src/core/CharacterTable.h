@@ -0,0 +1,140 @@
+#pragma once
+
+/**
+ * @file CharacterTable.h
+ * @brief Column-oriented store for the DataStore's character cache.
+ */
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include "Models.h"
+
+namespace rickmorty {
+
+/**
+ * @class CharacterTable
+ * @brief Characters stored by row, with the fields scans touch split into
+ *        dense columns.
+ *
+ * Rows are assigned in insertion order and only move when a removal fills
+ * the gap with the last row, so a row number is a handle until the next
+ * remove(). Ids map to rows through a dense vector, since API ids are
+ * small and contiguous; ids outside that range fall back to a hash map.
+ *
+ * Status, gender, species and name live in their own arrays: species as an
+ * index into a per-table dictionary, names as spans of one character arena.
+ * refreshNameOrder() stores the name order as a rank per row, so sorts
+ * compare integers until the next change. Changes leave the order in place
+ * with the changed rows taken out, and the next refresh merges just those
+ * back in. Full records are held through
+ * CharacterPtr handles: results, and copies of the table, share them
+ * rather than copying every string.
+ *
+ * const members never modify the table, so any number of threads may read
+ * one that nobody is writing; DataStore only publishes finished tables.
+ */
+class CharacterTable {
+public:
+    using Row = uint32_t;
+    using SpeciesId = uint32_t;
+
+    /// Inserts the character, or replaces the one with the same id in place
+    void upsert(Character character);
+    /// Drops the character and moves the last row into its place; returns
+    /// false if the id is not cached
+    bool remove(int id);
+
+    void reserve(size_t rows);
+    void clear();
+
+    size_t size() const { return records_.size(); }
+    bool empty() const { return records_.empty(); }
+    bool contains(int id) const { return findRow(id).has_value(); }
+
+    std::optional<Row> findRow(int id) const;
+    /// nullptr when the id is not cached
+    CharacterPtr find(int id) const;
+
+    const Character& record(Row row) const { return *records_[row]; }
+    /// The row's record; an upsert replaces the table's handle, not the record
+    const CharacterPtr& handle(Row row) const { return records_[row]; }
+    const std::vector<CharacterPtr>& records() const { return records_; }
+
+    CharacterStatus status(Row row) const { return status_[row]; }
+    Gender gender(Row row) const { return gender_[row]; }
+    SpeciesId species(Row row) const { return species_[row]; }
+    std::string_view name(Row row) const;
+
+    /// Estimated memory the row holds: its record with the record's own
+    /// strings and ids, the shared_ptr control block, and its column
+    /// entries. Interned strings are shared between rows and not counted.
+    size_t rowBytes(Row row) const;
+
+    /// Dictionary id of a species, if any cached character has had it
+    std::optional<SpeciesId> speciesId(std::string_view species) const;
+    const InternedString& speciesName(SpeciesId id) const { return speciesNames_[id]; }
+    size_t speciesCount() const { return speciesNames_.size(); }
+
+    std::vector<Row> rowsWithStatus(CharacterStatus status) const;
+    std::vector<Row> rowsWithSpecies(std::string_view species) const;
+    /// Every row, ordered like Character::operator< (by name, ties by id)
+    std::vector<Row> rowsSortedByName() const;
+    /// Sorts the given rows in place, in the same order
+    void sortByName(std::vector<Row>& rows) const;
+    /// Caches the name order for the sorts above; no-op if names are unchanged.
+    /// Sorts only the rows added or renamed since the last refresh and merges
+    /// them into the order it left.
+    void refreshNameOrder();
+
+    /// Handles to the records at rows
+    std::vector<CharacterPtr> select(const std::vector<Row>& rows) const;
+
+private:
+    struct NameSpan {
+        uint32_t offset = 0;
+        uint32_t length = 0;
+    };
+
+    SpeciesId internSpecies(const InternedString& species);
+    void setName(Row row, const std::string& name);
+    // Rebuilds the name arena once most of it is dead
+    void compactNamesIfSparse();
+    bool nameOrderCurrent() const { return !nameOrderStale_; }
+    bool nameLess(Row a, Row b) const;
+    // Takes the row out of the cached order until the next refresh
+    void unrank(Row row);
+
+    // Hot columns, one entry per row
+    std::vector<int> ids_;
+    std::vector<CharacterStatus> status_;
+    std::vector<Gender> gender_;
+    std::vector<SpeciesId> species_;
+    std::vector<NameSpan> names_;
+    std::vector<uint64_t> namePrefixes_;   // First 8 bytes, settling most comparisons
+
+    // Cold data: the full records, row-aligned with the columns
+    std::vector<CharacterPtr> records_;
+
+    static constexpr int MAX_DENSE_ID = 1 << 20;
+    std::vector<int32_t> rowById_;   // -1 for ids not in the table
+    std::unordered_map<int, Row> sparseRows_;
+    std::string nameArena_;
+    size_t staleNameBytes_ = 0;      // Arena bytes left behind by renames and removals
+    std::vector<InternedString> speciesNames_;
+    std::unordered_map<const std::string*, SpeciesId> speciesIndex_;
+
+    // Set by refreshNameOrder(); ignored once names or rows change. Until the
+    // next refresh, unranked rows are NO_RANK in nameRank_ and leave NO_ROW
+    // behind in nameOrder_; removals renumber the moved row in both.
+    static constexpr Row NO_ROW = UINT32_MAX;
+    static constexpr uint32_t NO_RANK = UINT32_MAX;
+    std::vector<Row> nameOrder_;
+    std::vector<uint32_t> nameRank_;   // One entry per row
+    bool nameOrderStale_ = false;
+};
+
+} // namespace rickmorty
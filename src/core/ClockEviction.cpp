@@ -0,0 +1,77 @@
+#include "ClockEviction.h"
+
+namespace rickmorty {
+
+void ClockEviction::insert(int key, size_t bytes) {
+    auto [it, inserted] = slots_.try_emplace(key, ring_.size());
+    if (inserted) {
+        ring_.push_back({key, bytes, true});
+        residentBytes_ += bytes;
+        return;
+    }
+    Entry& entry = ring_[it->second];
+    residentBytes_ = residentBytes_ - entry.bytes + bytes;
+    entry.bytes = bytes;
+    entry.referenced = true;
+}
+
+bool ClockEviction::touch(int key) {
+    auto it = slots_.find(key);
+    if (it == slots_.end()) {
+        return false;
+    }
+    ring_[it->second].referenced = true;
+    return true;
+}
+
+void ClockEviction::erase(int key) {
+    auto it = slots_.find(key);
+    if (it != slots_.end()) {
+        removeAt(it->second);
+    }
+}
+
+std::vector<int> ClockEviction::evict(size_t budgetBytes, const Pinned& pinned) {
+    std::vector<int> victims;
+    // Two full turns without a victim means every remaining entry is pinned:
+    // the first turn clears the reference bits, the second would find one
+    size_t sinceLastVictim = 0;
+    while (residentBytes_ > budgetBytes && !ring_.empty() && sinceLastVictim < 2 * ring_.size()) {
+        if (hand_ >= ring_.size()) {
+            hand_ = 0;
+        }
+        Entry& entry = ring_[hand_];
+        if (pinned && pinned(entry.key)) {
+            ++hand_;
+            ++sinceLastVictim;
+        } else if (entry.referenced) {
+            entry.referenced = false;
+            ++hand_;
+            ++sinceLastVictim;
+        } else {
+            victims.push_back(entry.key);
+            removeAt(hand_);
+            sinceLastVictim = 0;
+        }
+    }
+    return victims;
+}
+
+void ClockEviction::clear() {
+    ring_.clear();
+    slots_.clear();
+    hand_ = 0;
+    residentBytes_ = 0;
+}
+
+void ClockEviction::removeAt(size_t slot) {
+    residentBytes_ -= ring_[slot].bytes;
+    slots_.erase(ring_[slot].key);
+    if (slot + 1 != ring_.size()) {
+        ring_[slot] = ring_.back();
+        slots_[ring_[slot].key] = slot;
+    }
+    ring_.pop_back();
+}
+
+} // namespace rickmorty
@@ -0,0 +1,66 @@
+#pragma once
+
+/**
+ * @file ClockEviction.h
+ * @brief CLOCK replacement policy for a byte-budgeted cache of int-keyed entries.
+ */
+
+#include <cstddef>
+#include <functional>
+#include <unordered_map>
+#include <vector>
+
+namespace rickmorty {
+
+/**
+ * @class ClockEviction
+ * @brief Tracks which cached entries were used recently and picks the ones
+ *        to drop when the cache is over its byte budget.
+ *
+ * CLOCK approximates LRU with one reference bit per entry: a use sets the
+ * bit, and the hand sweeping the ring clears set bits and evicts the first
+ * entry it finds clear. A use is a flag store rather than a move to the
+ * front of a list.
+ *
+ * Only bookkeeping lives here. The caller owns the entries, reports what
+ * it adds, uses and removes, and removes the victims evict() returns.
+ * Not thread-safe; DataStore updates it under its own lock.
+ */
+class ClockEviction {
+public:
+    /// Returns true for keys that must stay resident during this eviction
+    using Pinned = std::function<bool(int key)>;
+
+    /// Adds the entry, or updates its size; either way it counts as used
+    void insert(int key, size_t bytes);
+    /// Marks the entry used; returns false if the key is not tracked
+    bool touch(int key);
+    /// Stops tracking the key; no-op if not tracked
+    void erase(int key);
+
+    /// Untracks and returns entries, in eviction order, until the tracked
+    /// bytes fit budgetBytes. Stops short if only pinned entries are left.
+    std::vector<int> evict(size_t budgetBytes, const Pinned& pinned = {});
+
+    bool contains(int key) const { return slots_.count(key) > 0; }
+    size_t size() const { return ring_.size(); }
+    size_t residentBytes() const { return residentBytes_; }
+    void clear();
+
+private:
+    struct Entry {
+        int key = 0;
+        size_t bytes = 0;
+        bool referenced = false;
+    };
+
+    // Moves the last entry into the slot; the hand stays put so it looks at that entry next
+    void removeAt(size_t slot);
+
+    std::vector<Entry> ring_;
+    std::unordered_map<int, size_t> slots_;   // Key -> position in ring_
+    size_t hand_ = 0;
+    size_t residentBytes_ = 0;
+};
+
+} // namespace rickmorty
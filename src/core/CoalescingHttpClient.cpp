@@ -0,0 +1,94 @@
+#include "CoalescingHttpClient.h"
+#include <glog/logging.h>
+
+namespace rickmorty {
+
+CoalescingHttpClient::CoalescingHttpClient(std::unique_ptr<IHttpClient> inner)
+    : inner_(std::move(inner))
+{
+    if (!inner_) {
+        throw HttpException(HttpException::Type::NetworkError, "Wrapped HTTP client cannot be null");
+    }
+}
+
+CoalescingHttpClient::~CoalescingHttpClient() = default;
+
+std::string CoalescingHttpClient::get(const std::string& url) {
+    std::string body;
+    getInto(url, body);
+    return body;
+}
+
+void CoalescingHttpClient::getInto(const std::string& url, std::string& body) {
+    requests_++;
+
+    std::promise<std::string> promise;
+    std::shared_future<std::string> pending;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = inFlight_.find(url);
+        if (it != inFlight_.end()) {
+            ++it->second.waiters;
+            pending = it->second.result;
+        } else {
+            inFlight_.emplace(url, InFlight{promise.get_future().share(), 0});
+        }
+    }
+
+    if (pending.valid()) {
+        deduplicated_++;
+        LOG(INFO) << "Joining in-flight request: " << url;
+        // Rethrows the first caller's exception if its request failed
+        body.assign(pending.get());
+        return;
+    }
+
+    networkRequests_++;
+    try {
+        inner_->getInto(url, body);
+    } catch (...) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            inFlight_.erase(url);
+        }
+        promise.set_exception(std::current_exception());
+        throw;
+    }
+
+    // Leave the map before publishing, so callers arriving afterwards start a fresh request
+    size_t waiters = 0;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = inFlight_.find(url);
+        waiters = it->second.waiters;
+        inFlight_.erase(it);
+    }
+    // Copied only for callers that joined; the body itself stays in the caller's storage
+    promise.set_value(waiters > 0 ? body : std::string());
+}
+
+HttpResponse CoalescingHttpClient::getConditional(const std::string& url, const HttpValidators& validators) {
+    return inner_->getConditional(url, validators);
+}
+
+void CoalescingHttpClient::setTimeout(long timeoutMs) {
+    inner_->setTimeout(timeoutMs);
+}
+
+void CoalescingHttpClient::setUserAgent(const std::string& userAgent) {
+    inner_->setUserAgent(userAgent);
+}
+
+bool CoalescingHttpClient::supportsConcurrentRequests() const {
+    return inner_->supportsConcurrentRequests();
+}
+
+CoalescingHttpClient::Stats CoalescingHttpClient::stats() const {
+    Stats stats;
+    stats.requests = requests_.load();
+    stats.networkRequests = networkRequests_.load();
+    stats.deduplicated = deduplicated_.load();
+    return stats;
+}
+
+} // namespace rickmorty
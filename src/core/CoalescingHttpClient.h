@@ -0,0 +1,112 @@
+#pragma once
+
+/**
+ * @file CoalescingHttpClient.h
+ * @brief IHttpClient decorator that merges identical in-flight GET requests.
+ */
+
+#include "IHttpClient.h"
+#include <atomic>
+#include <cstdint>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace rickmorty {
+
+/**
+ * @class CoalescingHttpClient
+ * @brief Single-flight wrapper: one network request per URL at a time.
+ *
+ * Wraps another IHttpClient. When get() is called for a URL that is already
+ * being fetched, the caller does not start a second request; it waits for the
+ * first one and receives a copy of its body (or the same exception). Once a
+ * request completes, the URL leaves the in-flight map, so later calls always
+ * see fresh data.
+ *
+ * Typical case: rapid clicks in the episode list issue several
+ * loadCharactersForEpisode() tasks for the same character set.
+ *
+ * @note Thread-safe as long as the wrapped client is. getConditional() is
+ *       forwarded unmerged because callers may send different validators.
+ *       getAsync() uses the blocking default from IHttpClient so that it is
+ *       coalesced too: it returns only once the request has completed.
+ *
+ * Example usage:
+ * @code
+ * auto http = std::make_unique<CoalescingHttpClient>(std::make_unique<CurlHttpClient>());
+ * ApiClient client(std::move(http));
+ * @endcode
+ */
+class CoalescingHttpClient : public IHttpClient {
+public:
+    /**
+     * @struct Stats
+     * @brief Counters describing how get() calls were served.
+     */
+    struct Stats {
+        uint64_t requests = 0;       ///< get() calls received
+        uint64_t networkRequests = 0; ///< Calls forwarded to the wrapped client
+        uint64_t deduplicated = 0;   ///< Calls that waited on an identical in-flight request
+    };
+
+    /**
+     * @brief Wraps an HTTP client with request coalescing.
+     * @param inner The client that performs the actual requests (must not be null).
+     * @throws HttpException if inner is null.
+     */
+    explicit CoalescingHttpClient(std::unique_ptr<IHttpClient> inner);
+    ~CoalescingHttpClient() override;
+
+    CoalescingHttpClient(const CoalescingHttpClient&) = delete;
+    CoalescingHttpClient& operator=(const CoalescingHttpClient&) = delete;
+
+    /**
+     * @brief Returns the body for url, joining an identical request if one is in flight.
+     * @throws HttpException as thrown by the wrapped client (to every waiting caller).
+     */
+    std::string get(const std::string& url) override;
+
+    using IHttpClient::get;
+
+    /**
+     * @brief As get(), with the leading request written into body in place.
+     *
+     * The body is copied for joined callers only, so a request nobody
+     * shares costs no more than the wrapped client's getInto().
+     */
+    void getInto(const std::string& url, std::string& body) override;
+
+    /**
+     * @brief Forwards to the wrapped client without coalescing.
+     */
+    HttpResponse getConditional(const std::string& url, const HttpValidators& validators) override;
+
+    void setTimeout(long timeoutMs) override;
+    void setUserAgent(const std::string& userAgent) override;
+    bool supportsConcurrentRequests() const override;
+
+    /**
+     * @brief Returns a snapshot of the coalescing counters.
+     */
+    Stats stats() const;
+
+private:
+    std::unique_ptr<IHttpClient> inner_;
+
+    struct InFlight {
+        std::shared_future<std::string> result;
+        size_t waiters = 0;   // Callers that joined; guarded by mutex_
+    };
+
+    std::mutex mutex_;
+    std::unordered_map<std::string, InFlight> inFlight_;
+
+    std::atomic<uint64_t> requests_{0};
+    std::atomic<uint64_t> networkRequests_{0};
+    std::atomic<uint64_t> deduplicated_{0};
+};
+
+} // namespace rickmorty
@@ -1,118 +1,642 @@
 #include "CurlHttpClient.h"
+#include <atomic>
+#include <cctype>
+#include <charconv>
+#include <mutex>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <vector>
 #include <glog/logging.h>
 
 namespace rickmorty {
 
+namespace {
+
+// curl_global_init/cleanup are process-wide; reference count them so that
+// several clients (or a client outliving another) don't tear down libcurl.
+std::mutex globalInitMutex;
+int globalInitRefs = 0;
+
+void acquireCurlGlobal() {
+    std::lock_guard<std::mutex> lock(globalInitMutex);
+    if (globalInitRefs++ == 0) {
+        curl_global_init(CURL_GLOBAL_DEFAULT);
+    }
+}
+
+void releaseCurlGlobal() {
+    std::lock_guard<std::mutex> lock(globalInitMutex);
+    if (--globalInitRefs == 0) {
+        curl_global_cleanup();
+    }
+}
+
+// libcurl's built-in CA bundle; nullptr when the TLS backend uses the
+// system's native store instead
+const char* defaultCaBundle() {
+    const curl_version_info_data* info = curl_version_info(CURLVERSION_NOW);
+    return info ? info->cainfo : nullptr;
+}
+
+// Invokes an async completion handler, keeping its exceptions out of the event loop
+void complete(const IHttpClient::ResponseCallback& onComplete, std::string body, std::exception_ptr error) {
+    try {
+        onComplete(std::move(body), error);
+    } catch (const std::exception& e) {
+        LOG(ERROR) << "Async completion handler threw: " << e.what();
+    } catch (...) {
+        LOG(ERROR) << "Async completion handler threw an unknown exception";
+    }
+}
+
+// Bodies announced larger than this are not reserved up front (guards against bogus headers)
+constexpr size_t MAX_RESERVE_BYTES = 64 * 1024 * 1024;
+
+// Returns the trimmed value if line is the given header (name matched case-insensitively)
+bool matchHeader(std::string_view line, const char* name, std::string_view& value) {
+    const size_t nameLen = std::char_traits<char>::length(name);
+    if (line.size() <= nameLen || line[nameLen] != ':') {
+        return false;
+    }
+    for (size_t i = 0; i < nameLen; ++i) {
+        if (std::tolower(static_cast<unsigned char>(line[i])) != std::tolower(static_cast<unsigned char>(name[i]))) {
+            return false;
+        }
+    }
+    size_t begin = nameLen + 1;
+    size_t end = line.size();
+    while (begin < end && std::isspace(static_cast<unsigned char>(line[begin]))) ++begin;
+    while (end > begin && std::isspace(static_cast<unsigned char>(line[end - 1]))) --end;
+    value = line.substr(begin, end - begin);
+    return true;
+}
+
+} // namespace
+
+struct CurlHttpClient::Pool {
+    CURLSH* share = nullptr;
+    std::mutex shareLocks[CURL_LOCK_DATA_LAST];
+
+    std::mutex idleMutex;
+    std::vector<CURL*> idleHandles;
+
+    std::mutex configMutex;
+    long timeoutMs = 30000;
+    std::string userAgent = "RickAndMortyViewer/1.0";
+    bool http2 = false;
+    bool compression = true;
+    std::string caBundlePath;
+    TransferObserver transferObserver;
+
+    std::atomic<uint64_t> requests{0};
+    std::atomic<uint64_t> newConnections{0};
+    std::atomic<uint64_t> reusedConnections{0};
+    std::atomic<uint64_t> handlesCreated{0};
+    std::atomic<uint64_t> http2Responses{0};
+    std::atomic<uint64_t> wireBytes{0};
+    std::atomic<uint64_t> decodedBytes{0};
+
+    // Asynchronous requests waiting to be picked up by the event loop
+    struct PendingRequest {
+        std::string url;
+        ResponseCallback onComplete;
+    };
+
+    // A request attached to the multi handle
+    struct Transfer {
+        std::string url;
+        std::string body;
+        ResponseSink sink;
+        ResponseCallback onComplete;
+    };
+
+    std::mutex loopMutex;
+    std::vector<PendingRequest> pending;
+    bool stopping = false;
+    CURLM* multi = nullptr;
+    std::thread loopThread;
+
+    static void lockShared(CURL*, curl_lock_data data, curl_lock_access, void* userptr) {
+        static_cast<Pool*>(userptr)->shareLocks[data].lock();
+    }
+
+    static void unlockShared(CURL*, curl_lock_data data, void* userptr) {
+        static_cast<Pool*>(userptr)->shareLocks[data].unlock();
+    }
+
+    CURL* acquire() {
+        {
+            std::lock_guard<std::mutex> lock(idleMutex);
+            if (!idleHandles.empty()) {
+                CURL* handle = idleHandles.back();
+                idleHandles.pop_back();
+                return handle;
+            }
+        }
+
+        CURL* handle = curl_easy_init();
+        if (!handle) {
+            LOG(ERROR) << "Failed to initialize CURL easy handle";
+            throw HttpException(HttpException::Type::NetworkError, "Failed to initialize CURL");
+        }
+        curl_easy_setopt(handle, CURLOPT_SHARE, share);
+        curl_easy_setopt(handle, CURLOPT_FOLLOWLOCATION, 1L);
+        // Signals cannot be used for timeouts when handles run on several threads
+        curl_easy_setopt(handle, CURLOPT_NOSIGNAL, 1L);
+        handlesCreated++;
+        LOG(INFO) << "Created pooled CURL handle #" << handlesCreated.load();
+        return handle;
+    }
+
+    void release(CURL* handle) {
+        std::lock_guard<std::mutex> lock(idleMutex);
+        idleHandles.push_back(handle);
+    }
+
+    // Sets the per-request options from the current configuration. Every
+    // option a request may set is reset here, as handles are reused. sink
+    // must stay valid until the transfer completes.
+    void prepare(CURL* curl, const std::string& url, ResponseSink* sink, curl_slist* requestHeaders = nullptr) {
+        curl_easy_setopt(curl, CURLOPT_URL, url.c_str());
+        curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, writeCallback);
+        curl_easy_setopt(curl, CURLOPT_WRITEDATA, sink->body);
+        curl_easy_setopt(curl, CURLOPT_HEADERFUNCTION, headerCallback);
+        curl_easy_setopt(curl, CURLOPT_HEADERDATA, sink);
+        curl_easy_setopt(curl, CURLOPT_HTTPHEADER, requestHeaders);
+
+        // curl copies string options, so they are set straight from the
+        // configuration under its lock rather than from local copies
+        std::lock_guard<std::mutex> lock(configMutex);
+        curl_easy_setopt(curl, CURLOPT_TIMEOUT_MS, timeoutMs);
+        curl_easy_setopt(curl, CURLOPT_USERAGENT, userAgent.c_str());
+        // "" advertises every encoding libcurl was built with; the body is
+        // decoded chunk by chunk before it reaches writeCallback
+        curl_easy_setopt(curl, CURLOPT_ACCEPT_ENCODING, compression ? "" : nullptr);
+        // Always set, so a handle reused after the path is cleared drops the old bundle
+        curl_easy_setopt(curl, CURLOPT_CAINFO, caBundlePath.empty() ? defaultCaBundle() : caBundlePath.c_str());
+
+        // HTTP/2 is negotiated via ALPN on TLS connections; PIPEWAIT makes a
+        // transfer wait for an existing connection to multiplex on instead of
+        // opening a new one. HTTP/1.1 is pinned otherwise.
+        curl_easy_setopt(curl, CURLOPT_HTTP_VERSION,
+            http2 ? CURL_HTTP_VERSION_2TLS : CURL_HTTP_VERSION_1_1);
+        curl_easy_setopt(curl, CURLOPT_PIPEWAIT, http2 ? 1L : 0L);
+    }
+
+    // Records connection reuse and throws HttpException if the transfer failed.
+    // Returns the HTTP status code, which is 2xx or 304 Not Modified.
+    long checkTransfer(CURL* curl, CURLcode res, const std::string& url, size_t responseSize) {
+        // Handle CURL-level errors
+        if (res != CURLE_OK) {
+            const char* errorMsg = curl_easy_strerror(res);
+            LOG(ERROR) << "CURL error: " << errorMsg;
+
+            // Map specific CURL errors to appropriate HttpException types
+            if (res == CURLE_OPERATION_TIMEDOUT) {
+                throw HttpException(HttpException::Type::Timeout,
+                    "HTTP request timed out: " + std::string(errorMsg));
+            }
+            throw HttpException(HttpException::Type::NetworkError,
+                "HTTP request failed: " + std::string(errorMsg));
+        }
+
+        // Connection accounting: NUM_CONNECTS is 0 when a pooled connection was reused
+        long connects = 0;
+        curl_easy_getinfo(curl, CURLINFO_NUM_CONNECTS, &connects);
+        requests++;
+        if (connects > 0) {
+            newConnections++;
+        } else {
+            reusedConnections++;
+        }
+
+        long httpVersion = 0;
+        curl_easy_getinfo(curl, CURLINFO_HTTP_VERSION, &httpVersion);
+        if (httpVersion == CURL_HTTP_VERSION_2_0) {
+            http2Responses++;
+        }
+
+        // Get HTTP response code
+        long httpCode = 0;
+        curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &httpCode);
+
+        // SIZE_DOWNLOAD counts body bytes as received, before content decoding
+        curl_off_t downloaded = 0;
+        curl_easy_getinfo(curl, CURLINFO_SIZE_DOWNLOAD_T, &downloaded);
+        const uint64_t wire = static_cast<uint64_t>(downloaded);
+        wireBytes += wire;
+        decodedBytes += responseSize;
+
+        LOG(INFO) << "HTTP response code: " << httpCode << ", size: " << responseSize << " bytes"
+                  << " (" << wire << " on the wire)"
+                  << ", connection: " << (connects > 0 ? "new" : "reused")
+                  << (httpVersion == CURL_HTTP_VERSION_2_0 ? ", HTTP/2" : "");
+
+        TransferObserver observer;
+        {
+            std::lock_guard<std::mutex> lock(configMutex);
+            observer = transferObserver;
+        }
+        if (observer) {
+            observer(TransferInfo{url, httpCode, wire, responseSize});
+        }
+
+        // Handle HTTP-level errors
+        if (httpCode == 404) {
+            LOG(WARNING) << "Resource not found: " << url;
+            throw HttpException(HttpException::Type::NotFound, "Resource not found", 404);
+        }
+
+        // 304 answers a conditional request: the caller's cached copy is current
+        if (httpCode == 304) {
+            return httpCode;
+        }
+
+        if (httpCode < 200 || httpCode >= 300) {
+            // Retry-After (seconds or HTTP date) is parsed by curl into seconds from now
+            curl_off_t retryAfter = 0;
+            curl_easy_getinfo(curl, CURLINFO_RETRY_AFTER, &retryAfter);
+            LOG(ERROR) << "HTTP error " << httpCode << " for URL: " << url
+                       << (retryAfter > 0 ? ", Retry-After: " + std::to_string(retryAfter) + "s" : "");
+            throw HttpException(HttpException::Type::InvalidResponse,
+                "HTTP error: " + std::to_string(httpCode), static_cast<int>(httpCode),
+                static_cast<long>(retryAfter) * 1000);
+        }
+        return httpCode;
+    }
+
+    // Queues an async request, starting the event loop on first use
+    void submit(PendingRequest request) {
+        std::lock_guard<std::mutex> lock(loopMutex);
+        if (stopping) {
+            throw HttpException(HttpException::Type::NetworkError, "CurlHttpClient is shutting down");
+        }
+        if (!multi) {
+            multi = curl_multi_init();
+            if (!multi) {
+                LOG(ERROR) << "Failed to initialize CURL multi handle";
+                throw HttpException(HttpException::Type::NetworkError, "Failed to initialize CURL multi");
+            }
+            // Lets HTTP/2 transfers share one connection as parallel streams
+            curl_multi_setopt(multi, CURLMOPT_PIPELINING, CURLPIPE_MULTIPLEX);
+            loopThread = std::thread(&Pool::runLoop, this);
+            LOG(INFO) << "Started CURL multi event loop";
+        }
+        pending.push_back(std::move(request));
+        curl_multi_wakeup(multi);
+    }
+
+    // Event loop: attaches queued requests, drives transfers, dispatches completions
+    void runLoop() {
+        std::unordered_map<CURL*, Transfer> transfers;
+
+        for (;;) {
+            std::vector<PendingRequest> incoming;
+            {
+                std::lock_guard<std::mutex> lock(loopMutex);
+                if (stopping) {
+                    break;
+                }
+                incoming.swap(pending);
+            }
+
+            for (auto& request : incoming) {
+                CURL* curl = nullptr;
+                try {
+                    curl = acquire();
+                } catch (const HttpException&) {
+                    complete(request.onComplete, {}, std::current_exception());
+                    continue;
+                }
+                LOG(INFO) << "HTTP GET (async): " << request.url;
+                Transfer& transfer = transfers[curl];
+                transfer.url = std::move(request.url);
+                transfer.onComplete = std::move(request.onComplete);
+                transfer.sink = ResponseSink{&transfer.body, nullptr};
+                prepare(curl, transfer.url, &transfer.sink);
+                curl_multi_add_handle(multi, curl);
+            }
+
+            int running = 0;
+            curl_multi_perform(multi, &running);
+
+            int queued = 0;
+            while (CURLMsg* msg = curl_multi_info_read(multi, &queued)) {
+                if (msg->msg != CURLMSG_DONE) {
+                    continue;
+                }
+                CURL* curl = msg->easy_handle;
+                CURLcode res = msg->data.result;
+                curl_multi_remove_handle(multi, curl);
+
+                auto it = transfers.find(curl);
+                Transfer transfer = std::move(it->second);
+                transfers.erase(it);
+
+                std::exception_ptr error;
+                try {
+                    checkTransfer(curl, res, transfer.url, transfer.body.size());
+                } catch (...) {
+                    error = std::current_exception();
+                }
+                release(curl);
+
+                if (error) {
+                    transfer.body.clear();
+                }
+                complete(transfer.onComplete, std::move(transfer.body), error);
+            }
+
+            curl_multi_poll(multi, nullptr, 0, 1000, nullptr);
+        }
+
+        // Fail whatever is still queued or in flight
+        auto shutdownError = std::make_exception_ptr(
+            HttpException(HttpException::Type::NetworkError, "CurlHttpClient destroyed before request completed"));
+        for (auto& [curl, transfer] : transfers) {
+            curl_multi_remove_handle(multi, curl);
+            release(curl);
+            complete(transfer.onComplete, {}, shutdownError);
+        }
+        std::vector<PendingRequest> leftover;
+        {
+            std::lock_guard<std::mutex> lock(loopMutex);
+            leftover.swap(pending);
+        }
+        for (auto& request : leftover) {
+            complete(request.onComplete, {}, shutdownError);
+        }
+    }
+
+    void stopLoop() {
+        {
+            std::lock_guard<std::mutex> lock(loopMutex);
+            stopping = true;
+            if (multi) {
+                curl_multi_wakeup(multi);
+            }
+        }
+        if (loopThread.joinable()) {
+            loopThread.join();
+        }
+        if (multi) {
+            curl_multi_cleanup(multi);
+            multi = nullptr;
+        }
+    }
+};
+
 size_t CurlHttpClient::writeCallback(char* ptr, size_t size, size_t nmemb, std::string* data) {
     data->append(ptr, size * nmemb);
     return size * nmemb;
 }
 
+size_t CurlHttpClient::headerCallback(char* buffer, size_t size, size_t nitems, ResponseSink* sink) {
+    const size_t length = size * nitems;
+    const std::string_view line(buffer, length);
+    std::string_view value;
+
+    // A new status line starts the headers of a redirect target; keep only the final ones
+    if (line.compare(0, 5, "HTTP/") == 0) {
+        if (sink->validators) {
+            *sink->validators = HttpValidators{};
+        }
+    } else if (matchHeader(line, "Content-Length", value)) {
+        // Size the body once instead of growing it chunk by chunk. For encoded
+        // responses this is the compressed size, which still saves most regrowth.
+        size_t contentLength = 0;
+        auto [end, ec] = std::from_chars(value.data(), value.data() + value.size(), contentLength);
+        (void)end;
+        if (ec == std::errc() && contentLength <= MAX_RESERVE_BYTES) {
+            sink->body->reserve(contentLength);
+        }
+    } else if (sink->validators) {
+        if (matchHeader(line, "ETag", value)) {
+            sink->validators->etag.assign(value);
+        } else if (matchHeader(line, "Last-Modified", value)) {
+            sink->validators->lastModified.assign(value);
+        }
+    }
+    return length;
+}
+
 CurlHttpClient::CurlHttpClient()
-    : curl_(nullptr)
-    , timeoutMs_(30000)
-    , userAgent_("RickAndMortyViewer/1.0")
+    : pool_(std::make_unique<Pool>())
 {
     LOG(INFO) << "Initializing CurlHttpClient";
-    curl_global_init(CURL_GLOBAL_DEFAULT);
-    curl_ = curl_easy_init();
-    if (!curl_) {
-        LOG(ERROR) << "Failed to initialize CURL";
+    acquireCurlGlobal();
+
+    pool_->share = curl_share_init();
+    if (!pool_->share) {
+        LOG(ERROR) << "Failed to initialize CURL share handle";
+        releaseCurlGlobal();
         throw HttpException(HttpException::Type::NetworkError, "Failed to initialize CURL");
     }
 
-    // Set default options
-    curl_easy_setopt(curl_, CURLOPT_FOLLOWLOCATION, 1L);
-    curl_easy_setopt(curl_, CURLOPT_TIMEOUT_MS, timeoutMs_);
-    curl_easy_setopt(curl_, CURLOPT_USERAGENT, userAgent_.c_str());
+    // Share DNS, TLS sessions and live connections between all pooled handles
+    curl_share_setopt(pool_->share, CURLSHOPT_LOCKFUNC, &Pool::lockShared);
+    curl_share_setopt(pool_->share, CURLSHOPT_UNLOCKFUNC, &Pool::unlockShared);
+    curl_share_setopt(pool_->share, CURLSHOPT_USERDATA, pool_.get());
+    curl_share_setopt(pool_->share, CURLSHOPT_SHARE, CURL_LOCK_DATA_DNS);
+    curl_share_setopt(pool_->share, CURLSHOPT_SHARE, CURL_LOCK_DATA_SSL_SESSION);
+    curl_share_setopt(pool_->share, CURLSHOPT_SHARE, CURL_LOCK_DATA_CONNECT);
     LOG(INFO) << "CurlHttpClient initialized successfully";
 }
 
 CurlHttpClient::~CurlHttpClient() {
-    if (curl_) {
-        curl_easy_cleanup(curl_);
-        curl_ = nullptr;
+    if (!pool_) {
+        return;
+    }
+    pool_->stopLoop();
+    for (CURL* handle : pool_->idleHandles) {
+        curl_easy_cleanup(handle);
     }
-    curl_global_cleanup();
+    pool_->idleHandles.clear();
+    curl_share_cleanup(pool_->share);
+    pool_->share = nullptr;
+    releaseCurlGlobal();
 }
 
-CurlHttpClient::CurlHttpClient(CurlHttpClient&& other) noexcept
-    : curl_(other.curl_)
-    , timeoutMs_(other.timeoutMs_)
-    , userAgent_(std::move(other.userAgent_))
-{
-    other.curl_ = nullptr;
-}
+CurlHttpClient::CurlHttpClient(CurlHttpClient&& other) noexcept = default;
 
 CurlHttpClient& CurlHttpClient::operator=(CurlHttpClient&& other) noexcept {
     if (this != &other) {
-        if (curl_) {
-            curl_easy_cleanup(curl_);
-        }
-        curl_ = other.curl_;
-        timeoutMs_ = other.timeoutMs_;
-        userAgent_ = std::move(other.userAgent_);
-        other.curl_ = nullptr;
+        CurlHttpClient discarded(std::move(*this));
+        pool_ = std::move(other.pool_);
     }
     return *this;
 }
 
 std::string CurlHttpClient::get(const std::string& url) {
-    LOG(INFO) << "HTTP GET: " << url;
     std::string response;
+    getInto(url, response);
+    return response;
+}
 
-    curl_easy_setopt(curl_, CURLOPT_URL, url.c_str());
-    curl_easy_setopt(curl_, CURLOPT_WRITEFUNCTION, writeCallback);
-    curl_easy_setopt(curl_, CURLOPT_WRITEDATA, &response);
+void CurlHttpClient::getInto(const std::string& url, std::string& body) {
+    if (!pool_) {
+        throw HttpException(HttpException::Type::NetworkError, "CurlHttpClient has been moved from");
+    }
 
-    CURLcode res = curl_easy_perform(curl_);
+    LOG(INFO) << "HTTP GET: " << url;
+    body.clear();
 
-    // Handle CURL-level errors
-    if (res != CURLE_OK) {
-        const char* errorMsg = curl_easy_strerror(res);
-        LOG(ERROR) << "CURL error: " << errorMsg;
+    CURL* curl = pool_->acquire();
+    struct Lease {
+        Pool& pool;
+        CURL* handle;
+        ~Lease() { pool.release(handle); }
+    } lease{*pool_, curl};
 
-        // Map specific CURL errors to appropriate HttpException types
-        if (res == CURLE_OPERATION_TIMEDOUT) {
-            throw HttpException(HttpException::Type::Timeout,
-                "HTTP request timed out: " + std::string(errorMsg));
-        }
-        throw HttpException(HttpException::Type::NetworkError,
-            "HTTP request failed: " + std::string(errorMsg));
+    ResponseSink sink{&body, nullptr};
+    pool_->prepare(curl, url, &sink);
+    CURLcode res = curl_easy_perform(curl);
+    pool_->checkTransfer(curl, res, url, body.size());
+}
+
+HttpResponse CurlHttpClient::getConditional(const std::string& url, const HttpValidators& validators) {
+    HttpResponse response;
+    getConditionalInto(url, validators, response);
+    return response;
+}
+
+void CurlHttpClient::getConditionalInto(const std::string& url, const HttpValidators& validators,
+                                        HttpResponse& response) {
+    if (!pool_) {
+        throw HttpException(HttpException::Type::NetworkError, "CurlHttpClient has been moved from");
     }
 
-    // Get HTTP response code
-    long httpCode = 0;
-    curl_easy_getinfo(curl_, CURLINFO_RESPONSE_CODE, &httpCode);
-    LOG(INFO) << "HTTP response code: " << httpCode << ", size: " << response.size() << " bytes";
+    LOG(INFO) << "HTTP GET (conditional): " << url;
+    response.status = 200;
+    response.body.clear();
+    response.validators.etag.clear();
+    response.validators.lastModified.clear();
 
-    // Handle HTTP-level errors
-    if (httpCode == 404) {
-        LOG(WARNING) << "Resource not found: " << url;
-        throw HttpException(HttpException::Type::NotFound, "Resource not found", 404);
+    curl_slist* requestHeaders = nullptr;
+    if (!validators.etag.empty()) {
+        requestHeaders = curl_slist_append(requestHeaders, ("If-None-Match: " + validators.etag).c_str());
+    }
+    if (!validators.lastModified.empty()) {
+        requestHeaders = curl_slist_append(requestHeaders, ("If-Modified-Since: " + validators.lastModified).c_str());
     }
 
-    if (httpCode < 200 || httpCode >= 300) {
-        LOG(ERROR) << "HTTP error " << httpCode << " for URL: " << url;
-        throw HttpException(HttpException::Type::InvalidResponse,
-            "HTTP error: " + std::to_string(httpCode), static_cast<int>(httpCode));
+    CURL* curl = pool_->acquire();
+    struct Lease {
+        Pool& pool;
+        CURL* handle;
+        curl_slist* headers;
+        ~Lease() {
+            // Detach the header list before freeing it so a reused handle never sees it
+            curl_easy_setopt(handle, CURLOPT_HTTPHEADER, nullptr);
+            curl_slist_free_all(headers);
+            pool.release(handle);
+        }
+    } lease{*pool_, curl, requestHeaders};
+
+    ResponseSink sink{&response.body, &response.validators};
+    pool_->prepare(curl, url, &sink, requestHeaders);
+    CURLcode res = curl_easy_perform(curl);
+    response.status = pool_->checkTransfer(curl, res, url, response.body.size());
+
+    if (response.notModified()) {
+        LOG(INFO) << "Not modified: " << url;
     }
+}
 
-    return response;
+void CurlHttpClient::getAsync(const std::string& url, ResponseCallback onComplete) {
+    if (!pool_) {
+        complete(onComplete, {}, std::make_exception_ptr(
+            HttpException(HttpException::Type::NetworkError, "CurlHttpClient has been moved from")));
+        return;
+    }
+
+    try {
+        pool_->submit(Pool::PendingRequest{url, onComplete});
+    } catch (const HttpException&) {
+        complete(onComplete, {}, std::current_exception());
+    }
 }
 
 void CurlHttpClient::setTimeout(long timeoutMs) {
-    timeoutMs_ = timeoutMs;
-    if (curl_) {
-        curl_easy_setopt(curl_, CURLOPT_TIMEOUT_MS, timeoutMs_);
+    if (pool_) {
+        std::lock_guard<std::mutex> lock(pool_->configMutex);
+        pool_->timeoutMs = timeoutMs;
     }
 }
 
 void CurlHttpClient::setUserAgent(const std::string& userAgent) {
-    userAgent_ = userAgent;
-    if (curl_) {
-        curl_easy_setopt(curl_, CURLOPT_USERAGENT, userAgent_.c_str());
+    if (pool_) {
+        std::lock_guard<std::mutex> lock(pool_->configMutex);
+        pool_->userAgent = userAgent;
+    }
+}
+
+bool CurlHttpClient::setHttp2Enabled(bool enabled) {
+    if (!pool_) {
+        return false;
+    }
+
+    if (enabled && !isHttp2Supported()) {
+        LOG(WARNING) << "libcurl was built without HTTP/2 support, staying on HTTP/1.1";
+        enabled = false;
+    }
+
+    std::lock_guard<std::mutex> lock(pool_->configMutex);
+    pool_->http2 = enabled;
+    return enabled;
+}
+
+bool CurlHttpClient::http2Enabled() const {
+    if (!pool_) {
+        return false;
+    }
+    std::lock_guard<std::mutex> lock(pool_->configMutex);
+    return pool_->http2;
+}
+
+bool CurlHttpClient::isHttp2Supported() {
+    const curl_version_info_data* info = curl_version_info(CURLVERSION_NOW);
+    return info && (info->features & CURL_VERSION_HTTP2);
+}
+
+void CurlHttpClient::setCaBundlePath(const std::string& path) {
+    if (pool_) {
+        std::lock_guard<std::mutex> lock(pool_->configMutex);
+        pool_->caBundlePath = path;
+    }
+}
+
+void CurlHttpClient::setCompressionEnabled(bool enabled) {
+    if (pool_) {
+        std::lock_guard<std::mutex> lock(pool_->configMutex);
+        pool_->compression = enabled;
+    }
+}
+
+void CurlHttpClient::setTransferObserver(TransferObserver observer) {
+    if (pool_) {
+        std::lock_guard<std::mutex> lock(pool_->configMutex);
+        pool_->transferObserver = std::move(observer);
+    }
+}
+
+bool CurlHttpClient::supportsConcurrentRequests() const {
+    return true;
+}
+
+CurlHttpClient::ConnectionStats CurlHttpClient::connectionStats() const {
+    ConnectionStats stats;
+    if (pool_) {
+        stats.requests = pool_->requests.load();
+        stats.newConnections = pool_->newConnections.load();
+        stats.reusedConnections = pool_->reusedConnections.load();
+        stats.handlesCreated = pool_->handlesCreated.load();
+        stats.http2Responses = pool_->http2Responses.load();
+        stats.wireBytes = pool_->wireBytes.load();
+        stats.decodedBytes = pool_->decodedBytes.load();
     }
+    return stats;
 }
 
 } // namespace rickmorty
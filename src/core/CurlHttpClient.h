@@ -10,25 +10,46 @@
 
 #include "IHttpClient.h"
 #include <curl/curl.h>
+#include <cstdint>
+#include <functional>
+#include <memory>
 #include <string>
 
 namespace rickmorty {
 
 /**
  * @class CurlHttpClient
- * @brief HTTP client implementation using libcurl.
+ * @brief Thread-safe HTTP client implementation using libcurl.
  *
  * This class provides HTTP functionality using the libcurl library.
- * It manages the CURL handle lifecycle and translates CURL errors
- * to HttpException for consistent error handling.
+ * Each request checks out a CURL easy handle from an internal pool and
+ * returns it afterwards, so concurrent callers never share a handle.
+ * All pooled handles are attached to a single CURLSH share handle that
+ * shares the DNS cache, the TLS session cache and the connection cache,
+ * which lets concurrent requests reuse warm keep-alive connections
+ * instead of paying a fresh TCP and TLS handshake each time.
+ * CURL errors are translated to HttpException for consistent error handling.
  *
- * @note This class is NOT thread-safe. Each thread should have its own
- *       CurlHttpClient instance. The CURL handle is not designed to be
- *       shared across threads without external synchronization.
+ * getAsync() hands requests to a single background thread that drives a
+ * curl_multi handle, so any number of in-flight requests cost one thread.
+ * The thread is started on the first asynchronous request and shares the
+ * same handle pool and connection cache as the blocking get().
  *
- * @note This class manages curl_global_init/curl_global_cleanup. In applications
- *       with multiple CurlHttpClient instances, consider managing global CURL
- *       initialization separately to avoid redundant init/cleanup calls.
+ * Responses are requested with every content encoding libcurl supports
+ * (gzip, deflate, br, zstd in the superbuild) and decoded as they stream in,
+ * so callers always receive the plain body. connectionStats() and the
+ * optional TransferObserver report wire bytes vs decoded bytes.
+ *
+ * HTTP/1.1 is used by default. setHttp2Enabled(true) opts in to HTTP/2 over
+ * TLS, in which case parallel getAsync() requests to the same host are
+ * multiplexed as streams on a single connection.
+ *
+ * @note This class is thread-safe: get() may be called from several threads
+ *       at once, and supportsConcurrentRequests() returns true.
+ *
+ * @note curl_global_init/curl_global_cleanup are reference counted across
+ *       all CurlHttpClient instances, so creating several clients only
+ *       initializes libcurl once.
  *
  * Example usage:
  * @code
@@ -39,28 +60,64 @@ namespace rickmorty {
  * } catch (const HttpException& e) {
  *     // Handle error
  * }
+ * auto stats = client.connectionStats();  // reused vs new connections
+ *
+ * auto future = client.getAsync("https://api.example.com/data");
+ * std::string body = future.get();  // rethrows HttpException on failure
  * @endcode
  */
 class CurlHttpClient : public IHttpClient {
 public:
     /**
-     * @brief Constructs a CurlHttpClient and initializes the CURL handle.
+     * @struct ConnectionStats
+     * @brief Counters describing how requests were served by the connection pool.
+     */
+    struct ConnectionStats {
+        uint64_t requests = 0;          ///< Completed transfers (successful or HTTP error)
+        uint64_t newConnections = 0;    ///< Transfers that opened a new connection (TCP+TLS handshake)
+        uint64_t reusedConnections = 0; ///< Transfers served on an already-open pooled connection
+        uint64_t handlesCreated = 0;    ///< CURL easy handles created for the pool
+        uint64_t http2Responses = 0;    ///< Transfers that were served over HTTP/2
+        uint64_t wireBytes = 0;         ///< Body bytes received, before content decoding
+        uint64_t decodedBytes = 0;      ///< Body bytes delivered to callers after decoding
+    };
+
+    /**
+     * @struct TransferInfo
+     * @brief Per-request transfer sizes reported to a TransferObserver.
+     */
+    struct TransferInfo {
+        std::string url;           ///< Requested URL
+        long httpCode = 0;         ///< HTTP status code of the response
+        uint64_t wireBytes = 0;    ///< Body bytes received (compressed size if encoded)
+        uint64_t decodedBytes = 0; ///< Body bytes after content decoding
+    };
+
+    /// Called after every completed HTTP exchange, on the thread that ran it
+    using TransferObserver = std::function<void(const TransferInfo&)>;
+
+    /**
+     * @brief Constructs a CurlHttpClient and initializes the shared CURL state.
      * @throws HttpException if CURL initialization fails.
      *
-     * Initializes libcurl globally and creates a CURL easy handle.
-     * Sets default options including follow redirects, 30-second timeout,
-     * and a default User-Agent string.
+     * Initializes libcurl globally (once per process) and creates the share
+     * handle. Easy handles are created lazily as concurrent requests need
+     * them. Defaults are: follow redirects, 30-second timeout, and a default
+     * User-Agent string.
      */
     CurlHttpClient();
 
     /**
      * @brief Destructor that cleans up CURL resources.
      *
-     * Releases the CURL easy handle and performs global CURL cleanup.
+     * Stops the asynchronous event loop (failing any unfinished requests
+     * with HttpException::Type::NetworkError), releases all pooled easy
+     * handles and the share handle, then drops this instance's reference
+     * on the global CURL state.
      */
     ~CurlHttpClient() override;
 
-    // Non-copyable to prevent multiple handles pointing to same resource
+    // Non-copyable to prevent multiple owners of the same pool
     CurlHttpClient(const CurlHttpClient&) = delete;
     CurlHttpClient& operator=(const CurlHttpClient&) = delete;
 
@@ -78,16 +135,57 @@ public:
      * - CURL errors (connection failed, etc.) throw HttpException::Type::NetworkError
      * - HTTP 404 throws HttpException::Type::NotFound
      * - Other HTTP errors (4xx, 5xx) throw HttpException::Type::InvalidResponse
+     * - 304 Not Modified is not an error (it only answers conditional requests)
      * - Timeout errors throw HttpException::Type::Timeout
      */
     std::string get(const std::string& url) override;
 
+    using IHttpClient::get;
+
+    /**
+     * @brief Performs an HTTP GET, writing the body straight into body.
+     * @param url The complete URL to request.
+     * @param body Cleared, reserved from Content-Length and filled in place;
+     *        its capacity is reused across calls.
+     * @throws HttpException as get().
+     */
+    void getInto(const std::string& url, std::string& body) override;
+
+    /**
+     * @brief Performs a conditional HTTP GET with If-None-Match / If-Modified-Since.
+     * @param url The complete URL to request.
+     * @param validators Validators from the cached copy (may be empty).
+     * @return The response with the server's ETag and Last-Modified values;
+     *         status 304 (with an empty body) if the cached copy is current.
+     * @throws HttpException with the same error mapping as get().
+     */
+    HttpResponse getConditional(const std::string& url, const HttpValidators& validators) override;
+
+    /**
+     * @brief As getConditional(), writing the body into response.body in place.
+     */
+    void getConditionalInto(const std::string& url, const HttpValidators& validators,
+                            HttpResponse& response) override;
+
+    using IHttpClient::getAsync;
+
+    /**
+     * @brief Queues an HTTP GET request on the curl_multi event loop.
+     * @param url The complete URL to request.
+     * @param onComplete Invoked on the event loop thread with the body or
+     *        an HttpException, using the same error mapping as get().
+     *
+     * Returns immediately. onComplete must not block or call get().
+     */
+    void getAsync(const std::string& url, ResponseCallback onComplete) override;
+
     /**
      * @brief Sets the timeout for HTTP requests.
      * @param timeoutMs Timeout in milliseconds.
      *
      * The timeout applies to the entire request operation including
      * connection, transfer, etc. Default is 30000ms (30 seconds).
+     * Takes effect for requests started after the call.
      */
     void setTimeout(long timeoutMs) override;
 
@@ -96,13 +194,79 @@ public:
      * @param userAgent The User-Agent string to use.
      *
      * Default User-Agent is "RickAndMortyViewer/1.0".
+     * Takes effect for requests started after the call.
      */
     void setUserAgent(const std::string& userAgent) override;
 
+    /**
+     * @brief Opts in to (or out of) HTTP/2 for subsequent requests.
+     * @param enabled True to negotiate HTTP/2 over TLS, false for HTTP/1.1.
+     * @return True if HTTP/2 is now enabled; false if it was disabled or the
+     *         linked libcurl has no HTTP/2 support.
+     *
+     * Servers that do not offer HTTP/2 via ALPN are still spoken to over
+     * HTTP/1.1. Stream multiplexing only applies to getAsync() requests,
+     * which share the curl_multi handle; blocking get() calls each use
+     * their own connection.
+     */
+    bool setHttp2Enabled(bool enabled);
+
+    /**
+     * @brief Returns whether HTTP/2 is currently enabled.
+     */
+    bool http2Enabled() const;
+
+    /**
+     * @brief Returns whether the linked libcurl was built with HTTP/2 support.
+     */
+    static bool isHttp2Supported();
+
+    /**
+     * @brief Uses a custom CA bundle to verify TLS peers.
+     * @param path Path to a PEM bundle, or empty for libcurl's default;
+     *        applies to requests started after the call.
+     *
+     * Mainly useful for talking to local TLS stand-in servers with a
+     * self-signed certificate.
+     */
+    void setCaBundlePath(const std::string& path);
+
+    /**
+     * @brief Enables or disables compressed transfers (Accept-Encoding).
+     * @param enabled True (the default) to accept gzip/deflate/br/zstd
+     *        responses, false to request identity encoding only.
+     */
+    void setCompressionEnabled(bool enabled);
+
+    /**
+     * @brief Installs a callback that receives sizes for every completed request.
+     * @param observer The callback, or an empty function to remove it.
+     *
+     * The observer runs on the requesting thread (or the event loop thread
+     * for getAsync()) and must be thread-safe and quick.
+     */
+    void setTransferObserver(TransferObserver observer);
+
+    /**
+     * @brief Pooled handles make concurrent requests safe.
+     * @return Always true.
+     */
+    bool supportsConcurrentRequests() const override;
+
+    /**
+     * @brief Returns a snapshot of the connection reuse counters.
+     */
+    ConnectionStats connectionStats() const;
+
 private:
-    CURL* curl_;           ///< The CURL easy handle
-    long timeoutMs_;       ///< Current timeout in milliseconds
-    std::string userAgent_; ///< Current User-Agent string
+    struct Pool;                 ///< Share handle, idle easy handles, event loop and counters
+    std::unique_ptr<Pool> pool_;
+
+    /// Where a transfer's body and (optionally) validators go
+    struct ResponseSink {
+        std::string* body;
+        HttpValidators* validators;
+    };
 
     /**
      * @brief CURL write callback function for receiving response data.
@@ -113,6 +277,19 @@ private:
      * @return Number of bytes processed.
      */
     static size_t writeCallback(char* ptr, size_t size, size_t nmemb, std::string* data);
+
+    /**
+     * @brief CURL header callback: pre-sizes the body and captures validators.
+     * @param buffer Pointer to one header line (not null-terminated).
+     * @param size Size of each data element.
+     * @param nitems Number of data elements.
+     * @param sink Destination of the transfer.
+     * @return Number of bytes processed.
+     *
+     * Reserves the body from Content-Length and fills in ETag / Last-Modified
+     * when the sink asks for validators.
+     */
+    static size_t headerCallback(char* buffer, size_t size, size_t nitems, ResponseSink* sink);
 };
 
 } // namespace rickmorty
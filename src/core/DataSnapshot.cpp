@@ -0,0 +1,229 @@
+#include "DataSnapshot.h"
+#include <algorithm>
+#include <iterator>
+#include <tuple>
+
+namespace rickmorty {
+
+namespace {
+
+// Sorted union of two id lists; `a` may be in any order
+std::vector<int> mergeIds(std::vector<int> a, const std::vector<int>& b) {
+    std::sort(a.begin(), a.end());
+    std::vector<int> merged;
+    merged.reserve(a.size() + b.size());
+    std::set_union(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(merged));
+    merged.erase(std::unique(merged.begin(), merged.end()), merged.end());
+    return merged;
+}
+
+// Broadcast order; the id breaks ties between episodes with unparsed codes
+std::tuple<int, int, int> airingKey(const Episode& e) {
+    return {e.season, e.episodeNumber, e.id};
+}
+
+} // namespace
+
+bool DataSnapshot::charactersLoadedForEpisode(int episodeId) const {
+    return loadedEpisodeCharacters_->count(episodeId) > 0;
+}
+
+const Episode* DataSnapshot::findEpisode(int id) const {
+    auto it = episodes_->index.find(id);
+    return it != episodes_->index.end() ? &episodes_->list[it->second] : nullptr;
+}
+
+const Location* DataSnapshot::findLocation(int id) const {
+    auto it = locations_->find(id);
+    return it != locations_->end() ? &it->second : nullptr;
+}
+
+std::vector<int> DataSnapshot::adjacentEpisodes(int episodeId) const {
+    const Episode* episode = findEpisode(episodeId);
+    if (!episode) {
+        return {};
+    }
+
+    // One pass for the nearest key on either side; the list is in API order
+    const auto key = airingKey(*episode);
+    const Episode* previous = nullptr;
+    const Episode* next = nullptr;
+    for (const auto& e : episodes_->list) {
+        const auto candidate = airingKey(e);
+        if (candidate < key && (!previous || candidate > airingKey(*previous))) {
+            previous = &e;
+        } else if (candidate > key && (!next || candidate < airingKey(*next))) {
+            next = &e;
+        }
+    }
+
+    std::vector<int> result;
+    if (next) {
+        result.push_back(next->id);
+    }
+    if (previous) {
+        result.push_back(previous->id);
+    }
+    return result;
+}
+
+std::vector<CharacterPtr> DataSnapshot::charactersForEpisode(int episodeId) const {
+    const Episode* episode = findEpisode(episodeId);
+    return cachedCharacters(episode ? episode->characterIds : std::vector<int>());
+}
+
+std::vector<CharacterPtr> DataSnapshot::charactersWithStatus(CharacterStatus status) const {
+    const CharacterTable& table = characters_->table;
+    auto rows = table.rowsWithStatus(status);
+    table.sortByName(rows);
+    return table.select(rows);
+}
+
+std::vector<CharacterPtr> DataSnapshot::charactersOfSpecies(std::string_view species) const {
+    const CharacterTable& table = characters_->table;
+    auto rows = table.rowsWithSpecies(species);
+    table.sortByName(rows);
+    return table.select(rows);
+}
+
+std::vector<Episode> DataSnapshot::episodesForCharacter(int characterId) const {
+    const CharacterPtr character = findCharacter(characterId);
+    const std::vector<int> episodeIds = mergeIds(character ? character->episodeIds : std::vector<int>(),
+                                                 episodes_->byCharacter.get(characterId));
+
+    std::vector<Episode> result;
+    result.reserve(episodeIds.size());
+    for (int episodeId : episodeIds) {
+        if (const Episode* episode = findEpisode(episodeId)) {
+            result.push_back(*episode);
+        }
+    }
+    return result;
+}
+
+std::vector<CharacterPtr> DataSnapshot::residentsOfLocation(int locationId) const {
+    const Location* location = findLocation(locationId);
+    return cachedCharacters(mergeIds(location ? location->residentIds : std::vector<int>(),
+                                     characters_->byLocation.get(locationId)));
+}
+
+std::vector<CharacterPtr> DataSnapshot::charactersFromOrigin(int locationId) const {
+    return cachedCharacters(characters_->byOrigin.get(locationId));
+}
+
+CharacterMemoryReport DataSnapshot::characterMemoryReport() const {
+    CharacterMemoryReport report;
+    std::unordered_set<const std::string*> distinct;
+
+    auto count = [&](const InternedString& field) {
+        ++report.internedFields;
+        report.stringBytes += sizeof(std::string) + StringPool::heapBytes(field.size());
+        report.internedBytes += sizeof(InternedString);
+        if (!field.empty() && distinct.insert(field.pooled()).second) {
+            report.internedBytes += StringPool::entryBytes(field.str());
+        }
+    };
+    auto stringCost = [](const std::string& value) {
+        return sizeof(std::string) + StringPool::heapBytes(value.size());
+    };
+    for (const auto& handle : characters_->table.records()) {
+        const Character& c = *handle;
+        ++report.characters;
+        count(c.species);
+        count(c.type);
+        count(c.origin.name);
+        count(c.location.name);
+        report.derivedBytes += stringCost(c.url()) + stringCost(c.origin.url()) +
+                               stringCost(c.location.url()) + stringCost(formatTimestamp(c.createdMs)) -
+                               sizeof(c.createdMs);
+    }
+    report.distinctStrings = distinct.size();
+    return report;
+}
+
+void DataSnapshot::setEpisodes(std::vector<Episode> episodes) {
+    auto data = std::make_shared<EpisodeData>();
+    data->list = std::move(episodes);
+    data->index.reserve(data->list.size());
+    for (size_t i = 0; i < data->list.size(); ++i) {
+        // Like the linear search this replaced, the first of duplicate ids wins
+        data->index.emplace(data->list[i].id, i);
+        for (int charId : data->list[i].characterIds) {
+            data->byCharacter.add(charId, data->list[i].id);
+        }
+    }
+    episodes_ = std::move(data);
+    episodesLoaded_ = true;
+}
+
+void DataSnapshot::addCharacters(std::vector<Character> characters) {
+    auto data = std::make_shared<CharacterData>(*characters_);
+    data->table.reserve(data->table.size() + characters.size());
+    for (auto& character : characters) {
+        if (const CharacterPtr previous = data->table.find(character.id)) {
+            data->byLocation.remove(previous->location.id, previous->id);
+            data->byOrigin.remove(previous->origin.id, previous->id);
+        }
+        // Id -1 means "unknown location" and is not indexed
+        if (character.location.id >= 0) {
+            data->byLocation.add(character.location.id, character.id);
+        }
+        if (character.origin.id >= 0) {
+            data->byOrigin.add(character.origin.id, character.id);
+        }
+        data->table.upsert(std::move(character));
+    }
+    // Readers share the table, so sorting must not need to cache anything
+    data->table.refreshNameOrder();
+    characters_ = std::move(data);
+}
+
+void DataSnapshot::removeCharacters(const std::vector<int>& ids) {
+    auto data = std::make_shared<CharacterData>(*characters_);
+    auto loaded = std::make_shared<std::unordered_set<int>>(*loadedEpisodeCharacters_);
+    for (int id : ids) {
+        const CharacterPtr character = data->table.find(id);
+        if (!character) {
+            continue;
+        }
+        data->byLocation.remove(character->location.id, id);
+        data->byOrigin.remove(character->origin.id, id);
+        data->table.remove(id);
+        for (int episodeId : episodes_->byCharacter.get(id)) {
+            loaded->erase(episodeId);
+        }
+    }
+    data->table.refreshNameOrder();
+    characters_ = std::move(data);
+    loadedEpisodeCharacters_ = std::move(loaded);
+}
+
+void DataSnapshot::addLocations(std::vector<Location> locations) {
+    auto data = std::make_shared<LocationMap>(*locations_);
+    for (auto& location : locations) {
+        (*data)[location.id] = std::move(location);
+    }
+    locations_ = std::move(data);
+}
+
+void DataSnapshot::markCharactersLoaded(const std::vector<int>& episodeIds) {
+    auto loaded = std::make_shared<std::unordered_set<int>>(*loadedEpisodeCharacters_);
+    loaded->insert(episodeIds.begin(), episodeIds.end());
+    loadedEpisodeCharacters_ = std::move(loaded);
+}
+
+std::vector<CharacterPtr> DataSnapshot::cachedCharacters(const std::vector<int>& ids) const {
+    const CharacterTable& table = characters_->table;
+    std::vector<CharacterTable::Row> rows;
+    rows.reserve(ids.size());
+    for (int id : ids) {
+        if (auto row = table.findRow(id)) {
+            rows.push_back(*row);
+        }
+    }
+    // Sort row numbers on the name column, then copy each record once
+    table.sortByName(rows);
+    return table.select(rows);
+}
+
+} // namespace rickmorty
@@ -0,0 +1,121 @@
+#pragma once
+
+/**
+ * @file DataSnapshot.h
+ * @brief One immutable version of everything DataStore has loaded.
+ */
+
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+#include "Models.h"
+#include "CharacterTable.h"
+#include "ReverseIndex.h"
+
+namespace rickmorty {
+
+/**
+ * @brief What the compact Character fields cost in the character cache.
+ *
+ * Interned fields (species, type, origin and location names) are compared
+ * against holding each one as its own std::string. derivedBytes is what the
+ * URL and created strings, now rebuilt on demand, would have taken.
+ */
+struct CharacterMemoryReport {
+    size_t characters = 0;
+    size_t internedFields = 0;
+    size_t distinctStrings = 0;  // Pool entries those fields point at
+    size_t stringBytes = 0;      // As separate std::string copies
+    size_t internedBytes = 0;    // Handles plus one pooled copy per distinct value
+    size_t derivedBytes = 0;     // Dropped strings, less the timestamp that replaced created
+
+    size_t bytesSaved() const {
+        return (stringBytes > internedBytes ? stringBytes - internedBytes : 0) + derivedBytes;
+    }
+};
+
+/**
+ * @class DataSnapshot
+ * @brief A read-only, versioned view of the loaded episodes, characters and
+ *        locations, with the indexes that answer DataStore's queries.
+ *
+ * DataStore publishes each version through an atomic shared_ptr. Readers
+ * hold a snapshot for as long as they like without locking, and it never
+ * changes under them. Writers copy the current snapshot, change the copy
+ * and publish it. Episodes, characters and locations are separate shared
+ * components, so a copy is a few pointers and only the component being
+ * changed is cloned; cloning the characters copies handles, not records.
+ */
+class DataSnapshot {
+public:
+    uint64_t version() const { return version_; }
+
+    bool episodesLoaded() const { return episodesLoaded_; }
+    bool warmedUp() const { return warmedUp_; }
+    bool charactersLoadedForEpisode(int episodeId) const;
+
+    const std::vector<Episode>& episodes() const { return episodes_->list; }
+    const Episode* findEpisode(int id) const;
+    /// The episodes just after and just before this one by season and
+    /// episode number, in that order; fewer at either end of the list
+    std::vector<int> adjacentEpisodes(int episodeId) const;
+    CharacterPtr findCharacter(int id) const { return characters_->table.find(id); }
+    const Location* findLocation(int id) const;
+    const CharacterTable& characters() const { return characters_->table; }
+    size_t locationCount() const { return locations_->size(); }
+
+    /// Cached characters of the episode's cast, sorted by name
+    std::vector<CharacterPtr> charactersForEpisode(int episodeId) const;
+    std::vector<CharacterPtr> charactersWithStatus(CharacterStatus status) const;
+    std::vector<CharacterPtr> charactersOfSpecies(std::string_view species) const;
+
+    // Reverse lookups; each combines both sides of the relation
+    std::vector<Episode> episodesForCharacter(int characterId) const;    // By episode id
+    std::vector<CharacterPtr> residentsOfLocation(int locationId) const;    // By name, cached only
+    std::vector<CharacterPtr> charactersFromOrigin(int locationId) const;   // By name, cached only
+
+    CharacterMemoryReport characterMemoryReport() const;
+
+private:
+    friend class DataStore;   // The only writer; see DataStore::publish
+
+    struct EpisodeData {
+        std::vector<Episode> list;
+        std::unordered_map<int, size_t> index;   // Episode id -> position in list
+        ReverseIndex byCharacter;                // From Episode::characterIds
+    };
+
+    struct CharacterData {
+        CharacterTable table;
+        ReverseIndex byLocation;                 // From Character::location
+        ReverseIndex byOrigin;                   // From Character::origin
+    };
+
+    using LocationMap = std::unordered_map<int, Location>;
+
+    // Writers: each clones the component it changes
+    void setEpisodes(std::vector<Episode> episodes);
+    void addCharacters(std::vector<Character> characters);
+    // Also unmarks the episodes whose casts included them, so that a loaded
+    // episode always has its whole cast cached
+    void removeCharacters(const std::vector<int>& ids);
+    void addLocations(std::vector<Location> locations);
+    void markCharactersLoaded(const std::vector<int>& episodeIds);
+
+    std::vector<CharacterPtr> cachedCharacters(const std::vector<int>& ids) const;
+
+    uint64_t version_ = 0;
+    bool episodesLoaded_ = false;
+    bool warmedUp_ = false;
+    std::shared_ptr<const EpisodeData> episodes_ = std::make_shared<EpisodeData>();
+    std::shared_ptr<const CharacterData> characters_ = std::make_shared<CharacterData>();
+    std::shared_ptr<const LocationMap> locations_ = std::make_shared<LocationMap>();
+    std::shared_ptr<const std::unordered_set<int>> loadedEpisodeCharacters_ =
+        std::make_shared<std::unordered_set<int>>();
+};
+
+} // namespace rickmorty
@@ -3,9 +3,28 @@
 
 namespace rickmorty {
 
+namespace {
+
+bool allCancelled(const std::vector<CancellationToken>& tokens) {
+    return std::all_of(tokens.begin(), tokens.end(), [](const CancellationToken& t) { return t.isCancelled(); });
+}
+
+} // namespace
+
 DataStore::DataStore(std::unique_ptr<ApiClient> apiClient)
     : apiClient_(std::move(apiClient)) {}
 
+DataStore::~DataStore() {
+    prefetchToken_.cancel();
+    waitForPrefetches();
+
+    warmupCancelled_ = true;
+    std::lock_guard<std::mutex> lock(warmupMutex_);
+    if (warmupThread_.joinable()) {
+        warmupThread_.join();
+    }
+}
+
 void DataStore::addObserver(IDataObserver* observer) {
     std::lock_guard<std::mutex> lock(observersMutex_);
     observers_.push_back(observer);
@@ -22,9 +41,9 @@ void DataStore::removeObserver(IDataObserver* observer) {
 void DataStore::loadAllEpisodes() {
     LOG(INFO) << "loadAllEpisodes called";
 
-    if (episodesLoaded_) {
+    if (auto current = snapshot(); current->episodesLoaded()) {
         LOG(INFO) << "Episodes already loaded, notifying observers";
-        notifyEpisodesLoaded(episodes_);
+        notifyEpisodesLoaded(current->episodes());
         return;
     }
 
@@ -35,14 +54,10 @@ void DataStore::loadAllEpisodes() {
         auto episodes = apiClient_->fetchAllEpisodes();
         LOG(INFO) << "Received " << episodes.size() << " episodes from API";
 
-        {
-            std::lock_guard<std::mutex> lock(dataMutex_);
-            episodes_ = std::move(episodes);
-            episodesLoaded_ = true;
-        }
+        auto published = publish([&](DataSnapshot& next) { next.setEpisodes(std::move(episodes)); });
 
         notifyLoadingStateChanged(false);
-        notifyEpisodesLoaded(episodes_);
+        notifyEpisodesLoaded(published->episodes());
         LOG(INFO) << "Episodes loaded and observers notified";
 
     } catch (const std::exception& e) {
@@ -53,173 +68,522 @@ void DataStore::loadAllEpisodes() {
 }
 
 void DataStore::loadCharactersForEpisode(int episodeId) {
-    LOG(INFO) << "[TRACE] loadCharactersForEpisode START for episode " << episodeId;
+    loadCharactersForEpisode(episodeId, CancellationToken());
+}
+
+void DataStore::loadCharactersForEpisode(int episodeId, const CancellationToken& token) {
+    loadEpisodeCharacters(episodeId, token, LoadPriority::Foreground);
+}
 
+void DataStore::loadEpisodeCharacters(int episodeId, const CancellationToken& token, LoadPriority priority) {
+    const bool speculative = priority == LoadPriority::Speculative;
+    LOG(INFO) << "[TRACE] loadCharactersForEpisode START for episode " << episodeId
+              << (speculative ? " (prefetch)" : "");
+
+    // Everything below reads this one version; no pointer into it can go stale
+    const auto current = snapshot();
+    if (current->charactersLoadedForEpisode(episodeId)) {
+        if (speculative) {
+            return;
+        }
+        LOG(INFO) << "[TRACE] Episode " << episodeId << " already in cache, returning cached data";
+        {
+            std::lock_guard<std::mutex> lock(loadsMutex_);
+            if (prefetchedEpisodes_.erase(episodeId) > 0) {
+                ++prefetchStats_.hits;
+            }
+        }
+        if (const Episode* episode = current->findEpisode(episodeId)) {
+            std::lock_guard<std::mutex> lock(cacheMutex_);
+            for (int charId : episode->characterIds) {
+                if (cacheClock_.touch(charId)) {
+                    ++cacheStats_.hits;
+                }
+            }
+        }
+        auto characters = current->charactersForEpisode(episodeId);
+        LOG(INFO) << "[TRACE] Notifying with " << characters.size() << " cached characters for episode " << episodeId;
+        notifyCharactersLoaded(episodeId, characters);
+        prefetchNeighbours(episodeId);
+        return;
+    }
+
+    std::shared_ptr<InFlightLoad> load;
     {
-        std::lock_guard<std::mutex> lock(dataMutex_);
-        if (loadedEpisodeCharacters_.count(episodeId)) {
-            LOG(INFO) << "[TRACE] Episode " << episodeId << " already in cache, returning cached data";
-            auto characters = getCharactersForEpisodeUnlocked(episodeId);  // Use unlocked version
-            LOG(INFO) << "[TRACE] Notifying with " << characters.size() << " cached characters for episode " << episodeId;
-            notifyCharactersLoaded(episodeId, characters);
+        std::lock_guard<std::mutex> lock(loadsMutex_);
+        if (token.isCancelled()) {
+            ++(speculative ? prefetchStats_.cancelled : loadStats_.cancelled);
+            LOG(INFO) << "[TRACE] Load for episode " << episodeId << " cancelled before it started";
             return;
         }
+        auto& entry = loadsInFlight_[episodeId];
+        if (entry && !entry->stopping) {
+            if (speculative) {
+                return;   // Already on its way; nothing for a prefetch to add
+            }
+            entry->callers.push_back(token);
+            ++loadStats_.joined;
+            if (entry->speculative && !entry->wanted) {
+                ++prefetchStats_.hits;
+            }
+            entry->wanted = true;
+            LOG(INFO) << "[TRACE] Episode " << episodeId << " already loading, joined that load";
+            return;
+        }
+        // A stopping load is left to unwind on its own
+        entry = std::make_shared<InFlightLoad>(priority);
+        entry->callers.push_back(token);
+        load = entry;
+        if (speculative) {
+            ++prefetchStats_.started;
+        } else {
+            ++loadStats_.started;
+            ++prefetchStats_.misses;
+            prefetchedEpisodes_.erase(episodeId);
+        }
     }
 
-    notifyLoadingStateChanged(true);
+    // Checked before each request; throws once no caller wants the result
+    auto stopIfAbandoned = [this, &load]() {
+        if (isAbandoned(*load)) {
+            throw LoadCancelled();
+        }
+    };
 
-    try {
-        // Copy character IDs while holding the lock to avoid stale pointer issues
-        std::vector<int> characterIds;
-        std::string episodeName;
-        {
-            std::lock_guard<std::mutex> lock(dataMutex_);
-            auto it = std::find_if(episodes_.begin(), episodes_.end(),
-                [episodeId](const Episode& e) { return e.id == episodeId; });
+    if (!speculative) {
+        notifyLoadingStateChanged(true);
+    }
 
-            if (it == episodes_.end()) {
-                LOG(ERROR) << "[TRACE] Episode " << episodeId << " not found in cache";
-                throw std::runtime_error("Episode not found: " + std::to_string(episodeId));
-            }
-            // Copy data while holding lock - don't keep pointer
-            characterIds = it->characterIds;
-            episodeName = it->name;
-            LOG(INFO) << "[TRACE] Found episode: " << episodeName << " with " << characterIds.size() << " characters";
+    try {
+        stopIfAbandoned();
+        const Episode* episode = current->findEpisode(episodeId);
+        if (!episode) {
+            LOG(ERROR) << "[TRACE] Episode " << episodeId << " not found in cache";
+            throw std::runtime_error("Episode not found: " + std::to_string(episodeId));
         }
+        const std::vector<int>& characterIds = episode->characterIds;
+        LOG(INFO) << "[TRACE] Found episode: " << episode->name << " with " << characterIds.size() << " characters";
 
         std::vector<int> toFetch;
-        {
-            std::lock_guard<std::mutex> lock(dataMutex_);
-            for (int charId : characterIds) {
-                if (characterCache_.find(charId) == characterCache_.end()) {
-                    toFetch.push_back(charId);
-                }
+        std::vector<int> cached;
+        for (int charId : characterIds) {
+            if (current->characters().contains(charId)) {
+                cached.push_back(charId);
+            } else {
+                toFetch.push_back(charId);
             }
         }
+        if (!speculative) {
+            std::lock_guard<std::mutex> lock(cacheMutex_);
+            cacheStats_.hits += cached.size();
+            cacheStats_.misses += toFetch.size();
+        }
 
         LOG(INFO) << "[TRACE] Need to fetch " << toFetch.size() << " characters (out of " << characterIds.size() << ") for episode " << episodeId;
 
+        std::vector<Character> fetched;
         if (!toFetch.empty()) {
-            auto fetched = apiClient_->fetchCharacters(toFetch);
+            fetched = apiClient_->fetchCharacters(toFetch, stopIfAbandoned);
             LOG(INFO) << "Fetched " << fetched.size() << " characters from API";
-
-            std::lock_guard<std::mutex> lock(dataMutex_);
-            for (auto& c : fetched) {
-                characterCache_[c.id] = std::move(c);
-            }
         }
 
-        {
-            std::lock_guard<std::mutex> lock(dataMutex_);
-            loadedEpisodeCharacters_.insert(episodeId);
-        }
+        auto published = publish([&](DataSnapshot& next) {
+            if (!fetched.empty()) {
+                next.addCharacters(std::move(fetched));
+            }
+            // Another load may have evicted some of the cast since it was
+            // found cached; the episode then stays unloaded until refetched
+            const bool castCached = std::all_of(cached.begin(), cached.end(), [&next](int charId) {
+                return next.characters().contains(charId);
+            });
+            if (castCached) {
+                next.markCharactersLoaded({episodeId});
+            }
+            admitCharacters(next, characterIds, true);
+        });
 
         LOG(INFO) << "[TRACE] Getting characters for episode " << episodeId;
-        auto characters = getCharactersForEpisode(episodeId);
+        auto characters = published->charactersForEpisode(episodeId);
         LOG(INFO) << "[TRACE] Final character list has " << characters.size() << " characters for episode " << episodeId;
 
-        LOG(INFO) << "[TRACE] Notifying loading state false for episode " << episodeId;
-        notifyLoadingStateChanged(false);
-        LOG(INFO) << "[TRACE] Notifying characters loaded for episode " << episodeId;
-        notifyCharactersLoaded(episodeId, characters);
+        const bool wanted = finishLoad(episodeId, load, LoadOutcome::Completed);
+        if (!speculative) {
+            LOG(INFO) << "[TRACE] Notifying loading state false for episode " << episodeId;
+            notifyLoadingStateChanged(false);
+        }
+        if (wanted) {
+            LOG(INFO) << "[TRACE] Notifying characters loaded for episode " << episodeId;
+            notifyCharactersLoaded(episodeId, characters);
+        }
         LOG(INFO) << "[TRACE] loadCharactersForEpisode COMPLETE for episode " << episodeId;
+        // A prefetch a selection joined now answers that selection, so it
+        // looks ahead the way the selection's own load would have
+        if (!speculative || wanted) {
+            prefetchNeighbours(episodeId);
+        }
 
+    } catch (const LoadCancelled&) {
+        LOG(INFO) << "[TRACE] Load for episode " << episodeId << " cancelled";
+        finishLoad(episodeId, load, LoadOutcome::Cancelled);
+        if (!speculative) {
+            notifyLoadingStateChanged(false);
+        }
     } catch (const std::exception& e) {
         LOG(ERROR) << "[TRACE] ERROR loading characters for episode " << episodeId << ": " << e.what();
-        notifyLoadingStateChanged(false);
-        notifyError(e.what());
+        const bool wanted = finishLoad(episodeId, load, LoadOutcome::Failed);
+        if (!speculative) {
+            notifyLoadingStateChanged(false);
+        }
+        if (wanted) {
+            notifyError(e.what());
+        }
+    }
+}
+
+EpisodeLoadStats DataStore::getEpisodeLoadStats() const {
+    std::lock_guard<std::mutex> lock(loadsMutex_);
+    return loadStats_;
+}
+
+bool DataStore::isAbandoned(InFlightLoad& load) {
+    std::lock_guard<std::mutex> lock(loadsMutex_);
+    if (allCancelled(load.callers)) {
+        load.stopping = true;
+    }
+    return load.stopping;
+}
+
+bool DataStore::finishLoad(int episodeId, const std::shared_ptr<InFlightLoad>& load, LoadOutcome outcome) {
+    std::lock_guard<std::mutex> lock(loadsMutex_);
+    auto it = loadsInFlight_.find(episodeId);
+    if (it != loadsInFlight_.end() && it->second == load) {
+        loadsInFlight_.erase(it);
+    }
+
+    // Counted against whoever started the load; joined callers were counted on joining
+    auto count = [outcome](auto& stats) {
+        switch (outcome) {
+            case LoadOutcome::Completed: ++stats.completed; break;
+            case LoadOutcome::Cancelled: ++stats.cancelled; break;
+            case LoadOutcome::Failed: ++stats.failed; break;
+        }
+    };
+    if (load->speculative) {
+        count(prefetchStats_);
+        if (outcome == LoadOutcome::Completed && !load->wanted) {
+            prefetchedEpisodes_.insert(episodeId);
+        }
+    } else {
+        count(loadStats_);
+    }
+    return load->wanted;
+}
+
+void DataStore::setPrefetchBudget(size_t maxLoads) {
+    std::lock_guard<std::mutex> lock(prefetchMutex_);
+    prefetchBudget_ = maxLoads;
+}
+
+size_t DataStore::prefetchBudget() const {
+    std::lock_guard<std::mutex> lock(prefetchMutex_);
+    return prefetchBudget_;
+}
+
+PrefetchStats DataStore::getPrefetchStats() const {
+    std::lock_guard<std::mutex> lock(loadsMutex_);
+    return prefetchStats_;
+}
+
+void DataStore::waitForPrefetches() {
+    std::unique_lock<std::mutex> lock(prefetchMutex_);
+    prefetchFinished_.wait(lock, [this]() {
+        return std::all_of(prefetches_.begin(), prefetches_.end(),
+                           [](const PrefetchThread& p) { return p.finished; });
+    });
+    reapPrefetches();
+}
+
+void DataStore::prefetchNeighbours(int episodeId) {
+    const auto current = snapshot();
+    std::lock_guard<std::mutex> lock(prefetchMutex_);
+    if (prefetchBudget_ == 0 || prefetchToken_.isCancelled()) {
+        return;
+    }
+    reapPrefetches();
+
+    for (int neighbour : current->adjacentEpisodes(episodeId)) {
+        if (current->charactersLoadedForEpisode(neighbour) || isLoading(neighbour)) {
+            continue;
+        }
+        if (prefetches_.size() >= prefetchBudget_) {
+            std::lock_guard<std::mutex> loadsLock(loadsMutex_);
+            ++prefetchStats_.skipped;
+            continue;
+        }
+        LOG(INFO) << "Prefetching characters for episode " << neighbour << " after episode " << episodeId;
+        // The thread cannot mark itself finished before this assignment, as it needs the lock
+        PrefetchThread& prefetch = prefetches_.emplace_back();
+        prefetch.thread = std::thread([this, neighbour, &prefetch]() {
+            loadEpisodeCharacters(neighbour, prefetchToken_, LoadPriority::Speculative);
+            std::lock_guard<std::mutex> done(prefetchMutex_);
+            prefetch.finished = true;
+            prefetchFinished_.notify_all();
+        });
     }
 }
 
-const std::vector<Episode>& DataStore::getEpisodes() const {
-    std::lock_guard<std::mutex> lock(dataMutex_);
-    return episodes_;
+void DataStore::setCharacterCacheBudget(size_t bytes) {
+    {
+        std::lock_guard<std::mutex> lock(cacheMutex_);
+        cacheBudget_ = bytes;
+    }
+    publish([this](DataSnapshot& next) { admitCharacters(next, {}, false); });
 }
 
-// Internal version - assumes lock is already held
-std::vector<Character> DataStore::getCharactersForEpisodeUnlocked(int episodeId) const {
-    std::vector<Character> result;
+size_t DataStore::characterCacheBudget() const {
+    std::lock_guard<std::mutex> lock(cacheMutex_);
+    return cacheBudget_;
+}
+
+CharacterCacheStats DataStore::getCharacterCacheStats() const {
+    std::lock_guard<std::mutex> lock(cacheMutex_);
+    CharacterCacheStats stats = cacheStats_;
+    stats.residentBytes = cacheClock_.residentBytes();
+    stats.budgetBytes = cacheBudget_;
+    return stats;
+}
 
-    auto it = std::find_if(episodes_.begin(), episodes_.end(),
-        [episodeId](const Episode& e) { return e.id == episodeId; });
+void DataStore::admitCharacters(DataSnapshot& next, const std::vector<int>& ids, bool pinned) {
+    std::lock_guard<std::mutex> lock(cacheMutex_);
+    const CharacterTable& table = next.characters();
+    for (int id : ids) {
+        if (auto row = table.findRow(id)) {
+            cacheClock_.insert(id, table.rowBytes(*row));
+        }
+    }
+    if (cacheBudget_ == 0 || cacheClock_.residentBytes() <= cacheBudget_) {
+        return;
+    }
 
-    if (it != episodes_.end()) {
-        for (int charId : it->characterIds) {
-            auto charIt = characterCache_.find(charId);
-            if (charIt != characterCache_.end()) {
-                result.push_back(charIt->second);
+    std::unordered_set<int> keep;
+    if (pinned) {
+        keep.insert(ids.begin(), ids.end());
+    }
+    const auto victims = cacheClock_.evict(cacheBudget_, [&keep](int id) { return keep.count(id) > 0; });
+    if (!victims.empty()) {
+        next.removeCharacters(victims);
+        cacheStats_.evictions += victims.size();
+        LOG(INFO) << "Evicted " << victims.size() << " characters to stay within " << cacheBudget_ << " bytes";
+    }
+}
+
+bool DataStore::isLoading(int episodeId) const {
+    std::lock_guard<std::mutex> lock(loadsMutex_);
+    return loadsInFlight_.count(episodeId) > 0;
+}
+
+void DataStore::reapPrefetches() {
+    for (auto it = prefetches_.begin(); it != prefetches_.end();) {
+        if (it->finished) {
+            it->thread.join();   // Already past its last use of the lock
+            it = prefetches_.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+void DataStore::warmUp() {
+    using Stage = WarmupProgress::Stage;
+    LOG(INFO) << "Warming up the full dataset";
+
+    // Reports each page and, by throwing, abandons the walk once cancelled
+    auto reportTo = [this](Stage stage) {
+        return [this, stage](size_t fetched, size_t total) {
+            if (warmupCancelled_) {
+                throw std::runtime_error("Warmup cancelled");
+            }
+            notifyWarmupProgress({stage, fetched, total});
+        };
+    };
+
+    try {
+        if (!areEpisodesLoaded()) {
+            auto episodes = apiClient_->fetchAllEpisodes(reportTo(Stage::Episodes));
+            bool stored = false;
+            auto published = publish([&](DataSnapshot& next) {
+                if (!next.episodesLoaded()) {
+                    next.setEpisodes(std::move(episodes));
+                    stored = true;
+                }
+            });
+            if (stored) {
+                notifyEpisodesLoaded(published->episodes());
+            }
+        }
+
+        auto characters = apiClient_->fetchAllCharacters(reportTo(Stage::Characters));
+        const size_t characterCount = characters.size();
+        std::vector<int> characterIds;
+        characterIds.reserve(characterCount);
+        for (const auto& c : characters) {
+            characterIds.push_back(c.id);
+        }
+        publish([&](DataSnapshot& next) {
+            next.addCharacters(std::move(characters));
+            // Every episode's cast is now in memory, until a budget evicts some
+            std::vector<int> episodeIds;
+            for (const auto& e : next.episodes()) {
+                episodeIds.push_back(e.id);
             }
+            next.markCharactersLoaded(episodeIds);
+            admitCharacters(next, characterIds, false);
+        });
+
+        auto locations = apiClient_->fetchAllLocations(reportTo(Stage::Locations));
+        const size_t locationCount = locations.size();
+        auto published = publish([&](DataSnapshot& next) {
+            next.addLocations(std::move(locations));
+            next.warmedUp_ = true;
+        });
+        const size_t episodeCount = published->episodes().size();
+
+        const size_t itemCount = episodeCount + characterCount + locationCount;
+        LOG(INFO) << "Warmup complete: " << episodeCount << " episodes, " << characterCount
+                  << " characters, " << locationCount << " locations";
+        const CharacterMemoryReport memory = published->characterMemoryReport();
+        LOG(INFO) << "Interned character fields: " << memory.internedBytes << " bytes for "
+                  << memory.distinctStrings << " distinct values instead of " << memory.stringBytes
+                  << " (" << memory.bytesSaved() << " saved)";
+        notifyWarmupProgress({Stage::Done, itemCount, itemCount});
+
+    } catch (const std::exception& e) {
+        if (warmupCancelled_) {
+            LOG(INFO) << "Warmup cancelled";
+            return;
         }
+        LOG(ERROR) << "Error during warmup: " << e.what();
+        notifyError(e.what());
+    }
+}
+
+void DataStore::startWarmup() {
+    std::lock_guard<std::mutex> lock(warmupMutex_);
+    if (warmupThread_.joinable()) {
+        LOG(INFO) << "Warmup already started";
+        return;
     }
+    warmupThread_ = std::thread([this]() { warmUp(); });
+}
+
+bool DataStore::isWarmedUp() const {
+    return snapshot()->warmedUp();
+}
+
+std::shared_ptr<const DataSnapshot> DataStore::snapshot() const {
+    return std::atomic_load(&snapshot_);
+}
+
+std::shared_ptr<const DataSnapshot> DataStore::publish(const std::function<void(DataSnapshot&)>& change) {
+    std::lock_guard<std::mutex> lock(writeMutex_);
+    // Shares every component; change() clones only the ones it touches
+    auto next = std::make_shared<DataSnapshot>(*std::atomic_load(&snapshot_));
+    change(*next);
+    ++next->version_;
+    std::shared_ptr<const DataSnapshot> published = std::move(next);
+    std::atomic_store(&snapshot_, published);
+    return published;
+}
 
-    std::sort(result.begin(), result.end());
+std::vector<Episode> DataStore::getEpisodes() const {
+    return snapshot()->episodes();
+}
 
-    return result;
+std::vector<CharacterPtr> DataStore::getCharactersForEpisode(int episodeId) const {
+    return snapshot()->charactersForEpisode(episodeId);
 }
 
-std::vector<Character> DataStore::getCharactersForEpisode(int episodeId) const {
-    std::lock_guard<std::mutex> lock(dataMutex_);
-    return getCharactersForEpisodeUnlocked(episodeId);
+CharacterPtr DataStore::getCharacter(int id) const {
+    return snapshot()->findCharacter(id);
 }
 
-std::optional<Character> DataStore::getCharacter(int id) const {
-    std::lock_guard<std::mutex> lock(dataMutex_);
-    auto it = characterCache_.find(id);
-    if (it != characterCache_.end()) {
-        return it->second;
+std::optional<Episode> DataStore::getEpisode(int id) const {
+    const auto current = snapshot();
+    if (const Episode* episode = current->findEpisode(id)) {
+        return *episode;
     }
     return std::nullopt;
 }
 
-std::optional<Episode> DataStore::getEpisode(int id) const {
-    std::lock_guard<std::mutex> lock(dataMutex_);
-    auto it = std::find_if(episodes_.begin(), episodes_.end(),
-        [id](const Episode& e) { return e.id == id; });
+std::vector<Episode> DataStore::getEpisodesForCharacter(int characterId) const {
+    return snapshot()->episodesForCharacter(characterId);
+}
 
-    if (it != episodes_.end()) {
-        return *it;
+std::vector<CharacterPtr> DataStore::getResidentsOfLocation(int locationId) const {
+    return snapshot()->residentsOfLocation(locationId);
+}
+
+std::vector<CharacterPtr> DataStore::getCharactersFromOrigin(int locationId) const {
+    return snapshot()->charactersFromOrigin(locationId);
+}
+
+std::optional<Location> DataStore::getLocation(int id) const {
+    const auto current = snapshot();
+    if (const Location* location = current->findLocation(id)) {
+        return *location;
     }
     return std::nullopt;
 }
 
 bool DataStore::areEpisodesLoaded() const {
-    std::lock_guard<std::mutex> lock(dataMutex_);
-    return episodesLoaded_;
+    return snapshot()->episodesLoaded();
 }
 
 bool DataStore::areCharactersLoadedForEpisode(int episodeId) const {
-    std::lock_guard<std::mutex> lock(dataMutex_);
-    return loadedEpisodeCharacters_.count(episodeId) > 0;
+    return snapshot()->charactersLoadedForEpisode(episodeId);
 }
 
-std::vector<Character> DataStore::getAllCachedCharacters() const {
-    std::lock_guard<std::mutex> lock(dataMutex_);
-    std::vector<Character> result;
-    result.reserve(characterCache_.size());
-    for (const auto& [id, character] : characterCache_) {
-        result.push_back(character);
-    }
-    return result;
+std::vector<CharacterPtr> DataStore::getAllCachedCharacters() const {
+    return snapshot()->characters().records();
+}
+
+std::vector<CharacterPtr> DataStore::getCachedCharactersWithStatus(CharacterStatus status) const {
+    return snapshot()->charactersWithStatus(status);
+}
+
+std::vector<CharacterPtr> DataStore::getCachedCharactersOfSpecies(std::string_view species) const {
+    return snapshot()->charactersOfSpecies(species);
+}
+
+std::vector<CharacterPtr> DataStore::getCachedCharactersSortedByName() const {
+    const auto current = snapshot();
+    return current->characters().select(current->characters().rowsSortedByName());
 }
 
-std::optional<Character> DataStore::getRandomCachedCharacter() const {
-    std::lock_guard<std::mutex> lock(dataMutex_);
-    if (characterCache_.empty()) {
-        return std::nullopt;
+CharacterPtr DataStore::getRandomCachedCharacter() const {
+    const auto current = snapshot();
+    const CharacterTable& characters = current->characters();
+    if (characters.empty()) {
+        return nullptr;
     }
 
-    static std::random_device rd;
-    static std::mt19937 gen(rd());
+    // Per thread, since readers no longer serialize on a lock
+    thread_local std::mt19937 gen(std::random_device{}());
 
-    std::uniform_int_distribution<size_t> dist(0, characterCache_.size() - 1);
-    auto it = characterCache_.begin();
-    std::advance(it, dist(gen));
-    return it->second;
+    std::uniform_int_distribution<size_t> dist(0, characters.size() - 1);
+    return characters.records()[dist(gen)];
 }
 
 size_t DataStore::getCachedCharacterCount() const {
-    std::lock_guard<std::mutex> lock(dataMutex_);
-    return characterCache_.size();
+    return snapshot()->characters().size();
+}
+
+size_t DataStore::getCachedLocationCount() const {
+    return snapshot()->locationCount();
+}
+
+CharacterMemoryReport DataStore::getCharacterMemoryReport() const {
+    return snapshot()->characterMemoryReport();
 }
 
 void DataStore::notifyEpisodesLoaded(const std::vector<Episode>& episodes) {
@@ -229,7 +593,7 @@ void DataStore::notifyEpisodesLoaded(const std::vector<Episode>& episodes) {
     }
 }
 
-void DataStore::notifyCharactersLoaded(int episodeId, const std::vector<Character>& characters) {
+void DataStore::notifyCharactersLoaded(int episodeId, const std::vector<CharacterPtr>& characters) {
     std::lock_guard<std::mutex> lock(observersMutex_);
     for (auto* observer : observers_) {
         observer->onCharactersLoaded(episodeId, characters);
@@ -250,4 +614,11 @@ void DataStore::notifyError(const std::string& message) {
     }
 }
 
+void DataStore::notifyWarmupProgress(const WarmupProgress& progress) {
+    std::lock_guard<std::mutex> lock(observersMutex_);
+    for (auto* observer : observers_) {
+        observer->onWarmupProgress(progress);
+    }
+}
+
 } // namespace rickmorty
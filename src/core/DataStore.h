@@ -1,62 +1,228 @@
 #pragma once
 
+#include <condition_variable>
+#include <functional>
+#include <list>
 #include <memory>
-#include <vector>
-#include <unordered_map>
 #include <unordered_set>
+#include <unordered_map>
+#include <vector>
 #include <mutex>
+#include <atomic>
+#include <thread>
 #include <algorithm>
 #include <random>
 #include "Models.h"
+#include "CancellationToken.h"
+#include "ClockEviction.h"
+#include "DataSnapshot.h"
 #include "Observer.h"
 #include "ApiClient.h"
 
 namespace rickmorty {
 
+// Outcomes of the loadCharactersForEpisode calls that were not answered
+// from the cache
+struct EpisodeLoadStats {
+    size_t started = 0;     // Loads that went to the API
+    size_t joined = 0;      // Calls that attached to a load already in flight
+    size_t completed = 0;
+    size_t cancelled = 0;   // Cancelled before starting, or stopped once every caller had
+    size_t failed = 0;      // Reported through onError
+};
+
+// Speculative loads of the episodes next to the selected ones, and how
+// often they saved a selection from waiting on the API
+struct PrefetchStats {
+    size_t started = 0;
+    size_t skipped = 0;     // Neighbours left alone because the budget was in use
+    size_t completed = 0;
+    size_t cancelled = 0;   // Stopped by the store shutting down
+    size_t failed = 0;      // Logged only, unless a selection had joined the load
+    size_t hits = 0;        // Selections answered by a prefetch, finished or still running
+    size_t misses = 0;      // Selections that had to start a load of their own
+
+    double hitRate() const {
+        return hits + misses > 0 ? static_cast<double>(hits) / static_cast<double>(hits + misses) : 0.0;
+    }
+};
+
+// How selections fared against the character cache, and its size
+struct CharacterCacheStats {
+    size_t hits = 0;            // Cast members a selection found cached
+    size_t misses = 0;          // Cast members a selection had to fetch
+    size_t evictions = 0;       // Characters dropped to stay within the budget
+    size_t residentBytes = 0;   // Estimated; see CharacterTable::rowBytes
+    size_t budgetBytes = 0;     // 0 when unbounded
+};
+
 class DataStore : public IDataSubject {
 public:
     explicit DataStore(std::unique_ptr<ApiClient> apiClient);
-    ~DataStore() override = default;
+    // Cancels a running background warmup and any prefetches, and waits
+    // for their threads
+    ~DataStore() override;
+
+    static constexpr size_t DEFAULT_PREFETCH_BUDGET = 2;
 
     void addObserver(IDataObserver* observer) override;
     void removeObserver(IDataObserver* observer) override;
 
     void loadAllEpisodes();
     void loadCharactersForEpisode(int episodeId);
+    // A call for an episode that is already loading joins that load instead
+    // of fetching again; observers hear about it once. A load stops before
+    // its next request once every caller's token is cancelled, and reports
+    // neither characters nor an error. Until it reaches that point, a new
+    // call for the same episode still joins and keeps it going.
+    void loadCharactersForEpisode(int episodeId, const CancellationToken& token);
+    EpisodeLoadStats getEpisodeLoadStats() const;
+
+    // Once a load for a selected episode has been answered, the episodes
+    // just after and before it (by season and episode number) are loaded on
+    // background threads without telling observers, so stepping through a
+    // season finds the next one in memory. A selection that arrives while
+    // its prefetch is still running joins it and gets the characters when
+    // it finishes, without a loading state. At most maxLoads prefetches run
+    // at once and neighbours beyond that are skipped; 0 turns prefetching off.
+    void setPrefetchBudget(size_t maxLoads);
+    size_t prefetchBudget() const;
+    PrefetchStats getPrefetchStats() const;
+    // Blocks until every prefetch started so far has finished
+    void waitForPrefetches();
 
-    const std::vector<Episode>& getEpisodes() const;
-    std::vector<Character> getCharactersForEpisode(int episodeId) const;
-    std::optional<Character> getCharacter(int id) const;
+    // Caps the estimated memory of the cached characters; 0, the default,
+    // leaves it unbounded. Over budget, characters no recent selection has
+    // shown are evicted (CLOCK), and any episode whose cast loses a member
+    // counts as not loaded, so selecting it again fetches what is missing.
+    // A load never evicts the cast it loads, so a budget below one cast is
+    // exceeded by that cast. Takes effect at once; a warmup afterwards
+    // keeps only what fits.
+    void setCharacterCacheBudget(size_t bytes);
+    size_t characterCacheBudget() const;
+    CharacterCacheStats getCharacterCacheStats() const;
+
+    // Loads every episode, character and location so that later episode
+    // selections are answered from memory. Progress is reported through
+    // onWarmupProgress after each page, failures through onError; the
+    // loading state is left alone since nothing waits on it.
+    void warmUp();
+    // Runs warmUp() on a background thread; no-op if one was already started
+    void startWarmup();
+    bool isWarmedUp() const;
+
+    // The current version of everything loaded. Never blocks, and the
+    // snapshot stays valid and unchanged for as long as it is held; prefer
+    // it over several getters when the answers have to agree.
+    std::shared_ptr<const DataSnapshot> snapshot() const;
+
+    std::vector<Episode> getEpisodes() const;
+    // Characters are handed out as handles to the cached records, which
+    // never change; getCharacter returns nullptr for ids not cached
+    std::vector<CharacterPtr> getCharactersForEpisode(int episodeId) const;
+    CharacterPtr getCharacter(int id) const;
     std::optional<Episode> getEpisode(int id) const;
+    std::optional<Location> getLocation(int id) const;
+
+    // Reverse lookups, answered from indexes kept up to date as data arrives.
+    // Each combines both sides of the relation: a character's episodes are
+    // its own episodeIds plus every loaded episode whose cast lists it.
+    std::vector<Episode> getEpisodesForCharacter(int characterId) const;       // By episode id
+    std::vector<CharacterPtr> getResidentsOfLocation(int locationId) const;       // By name, cached only
+    std::vector<CharacterPtr> getCharactersFromOrigin(int locationId) const;      // By name, cached only
 
     bool areEpisodesLoaded() const;
     bool areCharactersLoadedForEpisode(int episodeId) const;
 
     // Random character support for showcase
-    std::vector<Character> getAllCachedCharacters() const;
-    std::optional<Character> getRandomCachedCharacter() const;
+    std::vector<CharacterPtr> getAllCachedCharacters() const;
+    // Scans over the cached characters' columns; results sorted by name
+    std::vector<CharacterPtr> getCachedCharactersWithStatus(CharacterStatus status) const;
+    std::vector<CharacterPtr> getCachedCharactersOfSpecies(std::string_view species) const;
+    std::vector<CharacterPtr> getCachedCharactersSortedByName() const;
+    CharacterPtr getRandomCachedCharacter() const;
     size_t getCachedCharacterCount() const;
+    size_t getCachedLocationCount() const;
+    CharacterMemoryReport getCharacterMemoryReport() const;
 
 protected:
     void notifyEpisodesLoaded(const std::vector<Episode>& episodes) override;
-    void notifyCharactersLoaded(int episodeId, const std::vector<Character>& characters) override;
+    void notifyCharactersLoaded(int episodeId, const std::vector<CharacterPtr>& characters) override;
     void notifyLoadingStateChanged(bool isLoading) override;
     void notifyError(const std::string& message) override;
+    void notifyWarmupProgress(const WarmupProgress& progress) override;
 
 private:
-    // Internal unlocked version - caller must hold dataMutex_
-    std::vector<Character> getCharactersForEpisodeUnlocked(int episodeId) const;
+    // Applies change to a copy of the current snapshot and publishes the
+    // copy as the next version. Writers take turns; readers never wait.
+    // Returns the published snapshot.
+    std::shared_ptr<const DataSnapshot> publish(const std::function<void(DataSnapshot&)>& change);
+
+    enum class LoadPriority { Foreground, Speculative };
+    enum class LoadOutcome { Completed, Cancelled, Failed };
+
+    // Mutable fields guarded by loadsMutex_
+    struct InFlightLoad {
+        explicit InFlightLoad(LoadPriority p) : speculative(p == LoadPriority::Speculative), wanted(!speculative) {}
+
+        std::vector<CancellationToken> callers;
+        bool stopping = false;   // Seen abandoned at a checkpoint; no longer joinable
+        const bool speculative;  // Started by a prefetch; never touches the loading state
+        bool wanted;             // A selection waits on it, so observers hear the result
+    };
+
+    // The body of loadCharactersForEpisode; speculative loads notify
+    // observers only once a selection has joined them
+    void loadEpisodeCharacters(int episodeId, const CancellationToken& token, LoadPriority priority);
+    // True, and from then on always, once every caller has cancelled
+    bool isAbandoned(InFlightLoad& load);
+    // Unregisters the load, unless a newer one has replaced it, and counts the
+    // outcome. Returns whether observers should be told.
+    bool finishLoad(int episodeId, const std::shared_ptr<InFlightLoad>& load, LoadOutcome outcome);
+
+    // Starts speculative loads for the episode's neighbours, within the budget
+    void prefetchNeighbours(int episodeId);
+    bool isLoading(int episodeId) const;
+    // Joins finished prefetch threads; caller holds prefetchMutex_
+    void reapPrefetches();
+
+    // Runs inside publish() changes, once next holds the characters: records
+    // ids as cached and just used, then evicts down to the budget, sparing
+    // ids when pinned
+    void admitCharacters(DataSnapshot& next, const std::vector<int>& ids, bool pinned);
 
     std::unique_ptr<ApiClient> apiClient_;
     std::vector<IDataObserver*> observers_;
     mutable std::mutex observersMutex_;
 
-    std::vector<Episode> episodes_;
-    std::unordered_map<int, Character> characterCache_;
-    std::unordered_set<int> loadedEpisodeCharacters_;
-    mutable std::mutex dataMutex_;
+    // Only ever accessed through std::atomic_load / std::atomic_store
+    std::shared_ptr<const DataSnapshot> snapshot_ = std::make_shared<DataSnapshot>();
+    std::mutex writeMutex_;
+
+    std::unordered_map<int, std::shared_ptr<InFlightLoad>> loadsInFlight_;   // By episode id
+    EpisodeLoadStats loadStats_;
+    PrefetchStats prefetchStats_;
+    std::unordered_set<int> prefetchedEpisodes_;   // Loaded speculatively, not yet selected
+    mutable std::mutex loadsMutex_;
+
+    struct PrefetchThread {
+        std::thread thread;
+        bool finished = false;   // Guarded by prefetchMutex_
+    };
+    std::list<PrefetchThread> prefetches_;   // Running, or finished and not yet joined
+    size_t prefetchBudget_ = DEFAULT_PREFETCH_BUDGET;
+    CancellationToken prefetchToken_;        // The prefetches' caller token; cancelled on destruction
+    mutable std::mutex prefetchMutex_;       // Taken before loadsMutex_ when both are needed
+    std::condition_variable prefetchFinished_;
+
+    ClockEviction cacheClock_;          // Mirrors the characters of the latest snapshot
+    size_t cacheBudget_ = 0;            // Bytes; 0 for unbounded
+    CharacterCacheStats cacheStats_;    // Sizes are filled in when asked for
+    mutable std::mutex cacheMutex_;     // Taken after writeMutex_ when both are needed
 
-    bool episodesLoaded_ = false;
+    std::thread warmupThread_;
+    std::mutex warmupMutex_;
+    std::atomic<bool> warmupCancelled_{false};
 };
 
 } // namespace rickmorty
@@ -9,8 +9,14 @@
  * implementations to be swapped in.
  */
 
-#include <string>
+#include "ResponseBuffer.h"
+#include <exception>
+#include <functional>
+#include <future>
+#include <memory>
 #include <stdexcept>
+#include <string>
+#include <vector>
 
 namespace rickmorty {
 
@@ -41,11 +47,13 @@ public:
      * @param type The category of HTTP error.
      * @param message A descriptive error message.
      * @param httpCode The HTTP status code (0 if not applicable, e.g., for network errors).
+     * @param retryAfterMs Delay requested by a Retry-After header (0 if none was sent).
      */
-    HttpException(Type type, const std::string& message, int httpCode = 0)
+    HttpException(Type type, const std::string& message, int httpCode = 0, long retryAfterMs = 0)
         : std::runtime_error(message)
         , type_(type)
         , httpCode_(httpCode)
+        , retryAfterMs_(retryAfterMs)
     {}
 
     /**
@@ -60,9 +68,43 @@ public:
      */
     int httpCode() const noexcept { return httpCode_; }
 
+    /**
+     * @brief Returns how long the server asked clients to wait before retrying.
+     * @return Milliseconds from a Retry-After header (429/503 answers), or 0 if absent.
+     */
+    long retryAfterMs() const noexcept { return retryAfterMs_; }
+
 private:
     Type type_;
     int httpCode_;
+    long retryAfterMs_;
+};
+
+/**
+ * @struct HttpValidators
+ * @brief Cache validators used for conditional GET requests.
+ *
+ * Holds the ETag and Last-Modified values a server returned for a resource.
+ * Sent back as If-None-Match / If-Modified-Since, they let the server answer
+ * 304 Not Modified instead of resending an unchanged body.
+ */
+struct HttpValidators {
+    std::string etag;         ///< ETag response header, empty if absent
+    std::string lastModified; ///< Last-Modified response header, empty if absent
+
+    bool empty() const { return etag.empty() && lastModified.empty(); }
+};
+
+/**
+ * @struct HttpResponse
+ * @brief Result of a conditional GET request.
+ */
+struct HttpResponse {
+    long status = 200;         ///< HTTP status code (2xx or 304)
+    std::string body;          ///< Response body; empty for 304 Not Modified
+    HttpValidators validators; ///< Validators returned by the server
+
+    bool notModified() const { return status == 304; }
 };
 
 /**
@@ -85,6 +127,15 @@ private:
  */
 class IHttpClient {
 public:
+    /**
+     * @brief Completion handler for asynchronous requests.
+     *
+     * Receives the response body on success, or a non-null exception_ptr
+     * (normally holding an HttpException) on failure, in which case the body
+     * is empty.
+     */
+    using ResponseCallback = std::function<void(std::string body, std::exception_ptr error)>;
+
     /**
      * @brief Virtual destructor for proper cleanup of derived classes.
      */
@@ -98,6 +149,68 @@ public:
      */
     virtual std::string get(const std::string& url) = 0;
 
+    /**
+     * @brief Performs an HTTP GET request into a pooled buffer.
+     * @param url The complete URL to request.
+     * @param buffer Receives the response body; read it with buffer.view().
+     * @throws HttpException on network errors, timeouts, or HTTP error status codes.
+     *
+     * Reuses the buffer's storage, so steady-state requests need no body
+     * allocation in clients that write in place (see getInto()).
+     */
+    void get(const std::string& url, ResponseBuffer& buffer) {
+        getInto(url, buffer.str());
+    }
+
+    /**
+     * @brief Performs an HTTP GET request, replacing the contents of body.
+     * @param url The complete URL to request.
+     * @param body Receives the response body; its capacity is reused.
+     * @throws HttpException on network errors, timeouts, or HTTP error status codes.
+     *         The contents of body are unspecified after an exception.
+     *
+     * The default implementation assigns the result of get(). Implementations
+     * that can write the body in place should override it.
+     */
+    virtual void getInto(const std::string& url, std::string& body) {
+        body = get(url);
+    }
+
+    /**
+     * @brief Performs a conditional HTTP GET request.
+     * @param url The complete URL to request.
+     * @param validators Validators from a previous response; sent as
+     *        If-None-Match / If-Modified-Since when non-empty.
+     * @return The response; status 304 means the cached body is still valid.
+     * @throws HttpException on network errors, timeouts, or HTTP error status codes.
+     *
+     * 304 Not Modified is a success, not an error. The default implementation
+     * ignores the validators and performs a plain get(), so implementations
+     * without conditional request support always return the full body.
+     */
+    virtual HttpResponse getConditional(const std::string& url, const HttpValidators& validators) {
+        (void)validators; // Suppress unused parameter warning
+        HttpResponse response;
+        response.body = get(url);
+        return response;
+    }
+
+    /**
+     * @brief Performs a conditional HTTP GET request, replacing the contents of response.
+     * @param url The complete URL to request.
+     * @param validators As for getConditional().
+     * @param response Receives status, validators and body; the body's capacity is reused.
+     * @throws HttpException as getConditional(). The contents of response are
+     *         unspecified after an exception.
+     *
+     * The default implementation assigns the result of getConditional().
+     * Implementations that can write the body in place should override it.
+     */
+    virtual void getConditionalInto(const std::string& url, const HttpValidators& validators,
+                                    HttpResponse& response) {
+        response = getConditional(url, validators);
+    }
+
     /**
      * @brief Sets the timeout for HTTP requests.
      * @param timeoutMs Timeout in milliseconds.
@@ -119,6 +232,71 @@ public:
     virtual void setUserAgent(const std::string& userAgent) {
         (void)userAgent; // Suppress unused parameter warning
     }
+
+    /**
+     * @brief Reports whether get() may be called from several threads at once.
+     * @return True if concurrent get() calls are safe, false otherwise.
+     *
+     * Callers such as ApiClient use this to decide whether independent
+     * requests can be issued in parallel. The default is false, so
+     * implementations that are not thread-safe are only ever used serially.
+     */
+    virtual bool supportsConcurrentRequests() const {
+        return false;
+    }
+
+    /**
+     * @brief Starts an HTTP GET request and reports the result through a callback.
+     * @param url The complete URL to request.
+     * @param onComplete Invoked exactly once with the body or the error.
+     *
+     * Non-blocking implementations invoke onComplete on their own I/O thread,
+     * so the callback should be short and must not call get() on the same
+     * client. The default implementation performs a blocking get() and
+     * invokes onComplete before returning.
+     */
+    virtual void getAsync(const std::string& url, ResponseCallback onComplete) {
+        std::string body;
+        std::exception_ptr error;
+        try {
+            body = get(url);
+        } catch (...) {
+            error = std::current_exception();
+        }
+        onComplete(std::move(body), error);
+    }
+
+    /**
+     * @brief Starts an HTTP GET request and returns a future for its body.
+     * @param url The complete URL to request.
+     * @return Future that yields the body or rethrows the HttpException.
+     */
+    std::future<std::string> getAsync(const std::string& url) {
+        auto promise = std::make_shared<std::promise<std::string>>();
+        std::future<std::string> future = promise->get_future();
+        getAsync(url, [promise](std::string body, std::exception_ptr error) {
+            if (error) {
+                promise->set_exception(error);
+            } else {
+                promise->set_value(std::move(body));
+            }
+        });
+        return future;
+    }
+
+    /**
+     * @brief Submits several GET requests at once.
+     * @param urls The URLs to request.
+     * @return One future per URL, in the same order as urls.
+     */
+    std::vector<std::future<std::string>> getBatchAsync(const std::vector<std::string>& urls) {
+        std::vector<std::future<std::string>> futures;
+        futures.reserve(urls.size());
+        for (const auto& url : urls) {
+            futures.push_back(getAsync(url));
+        }
+        return futures;
+    }
 };
 
 } // namespace rickmorty
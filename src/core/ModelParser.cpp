@@ -0,0 +1,633 @@
+#include "ModelParser.h"
+#include <array>
+#include <cstdint>
+#include <nlohmann/json.hpp>
+
+namespace rickmorty {
+
+namespace {
+
+using json = nlohmann::json;
+
+constexpr size_t NO_FIELD = static_cast<size_t>(-1);
+
+// Outcome of offering a JSON value to a model field
+enum class Accept {
+    Filled,    // Stored, and the field now counts as present
+    Ignored,   // Fine here but does not make the field present (e.g. origin.url)
+    Rejected   // Wrong JSON type for this field
+};
+
+// Where a value sits below a record field: a key inside a nested object
+// (origin.name) or an element of a list (episode[3]); both empty for the
+// field's own value
+struct Slot {
+    std::string_view sub;
+    bool inArray = false;
+
+    bool direct() const { return sub.empty() && !inArray; }
+};
+
+template<size_t N>
+size_t findField(const std::array<std::string_view, N>& fields, std::string_view key) {
+    for (size_t i = 0; i < N; ++i) {
+        if (fields[i] == key) {
+            return i;
+        }
+    }
+    return NO_FIELD;
+}
+
+// Stores a plain string field
+Accept setString(std::string& target, const Slot& slot, std::string& value) {
+    if (!slot.direct()) {
+        return Accept::Rejected;
+    }
+    target = std::move(value);
+    return Accept::Filled;
+}
+
+Accept setString(InternedString& target, const Slot& slot, const std::string& value) {
+    if (!slot.direct()) {
+        return Accept::Rejected;
+    }
+    target = value;
+    return Accept::Filled;
+}
+
+// The record's own URL is required but not stored: url() rebuilds it from id
+Accept checkString(const Slot& slot) {
+    return slot.direct() ? Accept::Filled : Accept::Rejected;
+}
+
+Accept setTimestamp(int64_t& target, const Slot& slot, const std::string& value) {
+    if (!slot.direct()) {
+        return Accept::Rejected;
+    }
+    target = parseTimestamp(value);
+    return Accept::Filled;
+}
+
+// Stores a list of resource URLs as ids; a bare string counts as a one-element
+// list, as it does when from_json iterates it
+Accept addUrlId(std::vector<int>& target, const Slot& slot, const std::string& value) {
+    if (!slot.sub.empty()) {
+        return Accept::Rejected;
+    }
+    target.push_back(extractIdFromUrl(value));
+    return Accept::Filled;
+}
+
+// {"name": ..., "url": ...} objects: name is required, url may be null
+Accept setReference(LocationReference& ref, const Slot& slot, const std::string& value) {
+    if (slot.inArray || slot.sub.empty()) {
+        return Accept::Rejected;
+    }
+    if (slot.sub == "name") {
+        ref.name = value;
+        return Accept::Filled;
+    }
+    if (slot.sub == "url") {
+        ref.id = extractIdFromUrl(value);
+    }
+    return Accept::Ignored;
+}
+
+Accept referenceNonString(const Slot& slot, bool isNull) {
+    if (slot.inArray || slot.sub.empty() || slot.sub == "name") {
+        return Accept::Rejected;
+    }
+    if (slot.sub == "url") {
+        return isNull ? Accept::Ignored : Accept::Rejected;
+    }
+    return Accept::Ignored;
+}
+
+//=============================================================================
+// Per-model field tables. Field i is tracked as bit i; REQUIRED lists the
+// fields from_json reads with at().
+//=============================================================================
+
+template<typename T>
+struct Fields;
+
+template<>
+struct Fields<Character> {
+    enum Field { ID, NAME, STATUS, SPECIES, TYPE, GENDER, ORIGIN, LOCATION, IMAGE, EPISODE, URL, CREATED };
+    static constexpr std::array<std::string_view, 12> NAMES = {
+        "id", "name", "status", "species", "type", "gender",
+        "origin", "location", "image", "episode", "url", "created"};
+    static constexpr uint32_t REQUIRED = (1u << 12) - 1;
+
+    static Accept onString(Character& c, size_t field, const Slot& slot, std::string& value) {
+        switch (field) {
+            case NAME: return setString(c.name, slot, value);
+            case SPECIES: return setString(c.species, slot, value);
+            case TYPE: return setString(c.type, slot, value);
+            case IMAGE: return setString(c.imageUrl, slot, value);
+            case URL: return checkString(slot);
+            case CREATED: return setTimestamp(c.createdMs, slot, value);
+            case STATUS:
+                if (!slot.direct()) return Accept::Rejected;
+                c.status = statusFromString(value);
+                return Accept::Filled;
+            case GENDER:
+                if (!slot.direct()) return Accept::Rejected;
+                c.gender = genderFromString(value);
+                return Accept::Filled;
+            case ORIGIN: return setReference(c.origin, slot, value);
+            case LOCATION: return setReference(c.location, slot, value);
+            case EPISODE: return addUrlId(c.episodeIds, slot, value);
+            default: return Accept::Rejected;
+        }
+    }
+
+    static Accept onNumber(Character& c, size_t field, const Slot& slot, int64_t value) {
+        if (field == ID && slot.direct()) {
+            c.id = static_cast<int>(value);
+            return Accept::Filled;
+        }
+        return field == ORIGIN || field == LOCATION ? referenceNonString(slot, false) : Accept::Rejected;
+    }
+
+    static Accept onNull(Character&, size_t field, const Slot& slot) {
+        return field == ORIGIN || field == LOCATION ? referenceNonString(slot, true) : Accept::Rejected;
+    }
+
+    static Accept onContainer(size_t field, bool isArray) {
+        if (field == EPISODE && isArray) return Accept::Filled;
+        if ((field == ORIGIN || field == LOCATION) && !isArray) return Accept::Ignored;
+        return Accept::Rejected;
+    }
+
+    static void finish(Character&) {}
+};
+
+template<>
+struct Fields<Episode> {
+    enum Field { ID, NAME, AIR_DATE, EPISODE, CHARACTERS, URL, CREATED };
+    static constexpr std::array<std::string_view, 7> NAMES = {
+        "id", "name", "air_date", "episode", "characters", "url", "created"};
+    static constexpr uint32_t REQUIRED = (1u << 7) - 1;
+
+    static Accept onString(Episode& e, size_t field, const Slot& slot, std::string& value) {
+        switch (field) {
+            case NAME: return setString(e.name, slot, value);
+            case AIR_DATE: return setString(e.airDate, slot, value);
+            case EPISODE: return setString(e.episodeCode, slot, value);
+            case URL: return checkString(slot);
+            case CREATED: return setTimestamp(e.createdMs, slot, value);
+            case CHARACTERS: return addUrlId(e.characterIds, slot, value);
+            default: return Accept::Rejected;
+        }
+    }
+
+    static Accept onNumber(Episode& e, size_t field, const Slot& slot, int64_t value) {
+        if (field == ID && slot.direct()) {
+            e.id = static_cast<int>(value);
+            return Accept::Filled;
+        }
+        return Accept::Rejected;
+    }
+
+    static Accept onNull(Episode&, size_t, const Slot&) {
+        return Accept::Rejected;
+    }
+
+    static Accept onContainer(size_t field, bool isArray) {
+        return field == CHARACTERS && isArray ? Accept::Filled : Accept::Rejected;
+    }
+
+    static void finish(Episode& e) {
+        decodeEpisodeCode(e);
+    }
+};
+
+template<>
+struct Fields<Location> {
+    enum Field { ID, NAME, TYPE, DIMENSION, RESIDENTS, URL, CREATED };
+    static constexpr std::array<std::string_view, 7> NAMES = {
+        "id", "name", "type", "dimension", "residents", "url", "created"};
+    static constexpr uint32_t REQUIRED = (1u << 7) - 1;
+
+    static Accept onString(Location& l, size_t field, const Slot& slot, std::string& value) {
+        switch (field) {
+            case NAME: return setString(l.name, slot, value);
+            case TYPE: return setString(l.type, slot, value);
+            case DIMENSION: return setString(l.dimension, slot, value);
+            case URL: return checkString(slot);
+            case CREATED: return setTimestamp(l.createdMs, slot, value);
+            case RESIDENTS: return addUrlId(l.residentIds, slot, value);
+            default: return Accept::Rejected;
+        }
+    }
+
+    static Accept onNumber(Location& l, size_t field, const Slot& slot, int64_t value) {
+        if (field == ID && slot.direct()) {
+            l.id = static_cast<int>(value);
+            return Accept::Filled;
+        }
+        return Accept::Rejected;
+    }
+
+    static Accept onNull(Location&, size_t, const Slot&) {
+        return Accept::Rejected;
+    }
+
+    static Accept onContainer(size_t field, bool isArray) {
+        return field == RESIDENTS && isArray ? Accept::Filled : Accept::Rejected;
+    }
+
+    static void finish(Location&) {}
+};
+
+template<>
+struct Fields<PaginationInfo> {
+    enum Field { COUNT, PAGES, NEXT, PREV };
+    static constexpr std::array<std::string_view, 4> NAMES = {"count", "pages", "next", "prev"};
+    static constexpr uint32_t REQUIRED = (1u << COUNT) | (1u << PAGES);
+
+    static Accept onString(PaginationInfo& p, size_t field, const Slot&, std::string& value) {
+        if (field == NEXT) {
+            p.next = std::move(value);
+            return Accept::Filled;
+        }
+        if (field == PREV) {
+            p.prev = std::move(value);
+            return Accept::Filled;
+        }
+        return Accept::Rejected;
+    }
+
+    static Accept onNumber(PaginationInfo& p, size_t field, const Slot&, int64_t value) {
+        if (field == COUNT) {
+            p.count = static_cast<int>(value);
+            return Accept::Filled;
+        }
+        if (field == PAGES) {
+            p.pages = static_cast<int>(value);
+            return Accept::Filled;
+        }
+        return Accept::Rejected;
+    }
+
+    static Accept onNull(PaginationInfo&, size_t field, const Slot&) {
+        return field == NEXT || field == PREV ? Accept::Ignored : Accept::Rejected;
+    }
+
+    static Accept onContainer(size_t, bool) {
+        return Accept::Rejected;
+    }
+
+    static void finish(PaginationInfo&) {}
+};
+
+//=============================================================================
+// SAX handler
+//=============================================================================
+
+enum class Layout {
+    Object,          // A single record object
+    ObjectOrArray,   // A record object or an array of them
+    Page             // {"info": {...}, "results": [records]}
+};
+
+/**
+ * Receives nlohmann's SAX events and writes them into records of type T.
+ * A stack of frames tracks what the innermost open container is; values are
+ * routed by the frame and the last key seen.
+ */
+template<typename T>
+class ModelSaxHandler final : public json::json_sax_t {
+public:
+    ModelSaxHandler(Layout layout, std::vector<T>& out, PaginationInfo* info)
+        : layout_(layout), out_(out), info_(info) {}
+
+    const std::string& error() const { return error_; }
+    bool sawInfo() const { return sawInfo_; }
+    bool sawResults() const { return sawResults_; }
+
+    bool null() override {
+        return value([](auto fields, auto& target, size_t field, const Slot& slot) {
+            return decltype(fields)::onNull(target, field, slot);
+        });
+    }
+
+    bool boolean(bool val) override {
+        // from_json's get<int> accepts booleans as well, so they go the same way
+        return value([val](auto fields, auto& target, size_t field, const Slot& slot) {
+            return decltype(fields)::onNumber(target, field, slot, val ? 1 : 0);
+        });
+    }
+
+    bool number_integer(number_integer_t val) override {
+        return number(static_cast<int64_t>(val));
+    }
+
+    bool number_unsigned(number_unsigned_t val) override {
+        return number(static_cast<int64_t>(val));
+    }
+
+    bool number_float(number_float_t val, const string_t&) override {
+        return number(static_cast<int64_t>(val));
+    }
+
+    bool string(string_t& val) override {
+        return value([&val](auto fields, auto& target, size_t field, const Slot& slot) {
+            return decltype(fields)::onString(target, field, slot, val);
+        });
+    }
+
+    bool binary(binary_t&) override {
+        return fail("Unexpected binary value");
+    }
+
+    bool start_object(std::size_t) override {
+        return open(false);
+    }
+
+    bool end_object() override {
+        return close();
+    }
+
+    bool start_array(std::size_t) override {
+        return open(true);
+    }
+
+    bool end_array() override {
+        return close();
+    }
+
+    bool key(string_t& val) override {
+        key_ = std::move(val);
+        if (!stack_.empty()) {
+            if (stack_.back().kind == Kind::Record) {
+                keyField_ = findField(Fields<T>::NAMES, key_);
+            } else if (stack_.back().kind == Kind::Info) {
+                keyField_ = findField(Fields<PaginationInfo>::NAMES, key_);
+            }
+        }
+        return true;
+    }
+
+    bool parse_error(std::size_t, const std::string&, const nlohmann::detail::exception& ex) override {
+        return fail(ex.what());
+    }
+
+private:
+    enum class Kind {
+        Records,      // Top-level array of records
+        PageRoot,     // Top-level page object
+        Results,      // The page's "results" array
+        Record,       // A record object
+        RecordField,  // An object or array below a record field
+        Info,         // The page's "info" object
+        Skip          // A container under an unknown key, ignored wholesale
+    };
+
+    struct Frame {
+        Kind kind;
+        size_t field = NO_FIELD;
+        bool isArray = false;
+    };
+
+    bool fail(std::string message) {
+        if (error_.empty()) {
+            error_ = std::move(message);
+        }
+        return false;
+    }
+
+    template<typename Model>
+    bool mismatch(size_t field) {
+        return fail("Unexpected type for field '" + std::string(Fields<Model>::NAMES[field]) + "'");
+    }
+
+    template<typename Model>
+    bool apply(Accept result, uint32_t& seen, size_t field) {
+        if (result == Accept::Rejected) {
+            return mismatch<Model>(field);
+        }
+        if (result == Accept::Filled) {
+            seen |= 1u << field;
+        }
+        return true;
+    }
+
+    bool number(int64_t val) {
+        return value([val](auto fields, auto& target, size_t field, const Slot& slot) {
+            return decltype(fields)::onNumber(target, field, slot, val);
+        });
+    }
+
+    // Routes a scalar to the field it belongs to; offer(Fields<M>{}, model, field, slot)
+    template<typename Offer>
+    bool value(Offer offer) {
+        if (stack_.empty()) {
+            return fail("Expected a JSON object or array");
+        }
+        const Frame& top = stack_.back();
+        switch (top.kind) {
+            case Kind::Record:
+                return keyField_ == NO_FIELD
+                    || apply<T>(offer(Fields<T>{}, *current_, keyField_, Slot{}), recordSeen_, keyField_);
+            case Kind::RecordField: {
+                const Slot slot = top.isArray ? Slot{{}, true} : Slot{key_, false};
+                return apply<T>(offer(Fields<T>{}, *current_, top.field, slot), recordSeen_, top.field);
+            }
+            case Kind::Info:
+                return keyField_ == NO_FIELD
+                    || apply<PaginationInfo>(offer(Fields<PaginationInfo>{}, *info_, keyField_, Slot{}),
+                                             infoSeen_, keyField_);
+            case Kind::Records:
+            case Kind::Results:
+                return fail("Expected an object in the result list");
+            case Kind::PageRoot:
+            case Kind::Skip:
+            default:
+                return true;
+        }
+    }
+
+    bool open(bool isArray) {
+        if (stack_.empty()) {
+            if (isArray) {
+                if (layout_ != Layout::ObjectOrArray) {
+                    return fail("Expected a JSON object");
+                }
+                stack_.push_back({Kind::Records});
+            } else if (layout_ == Layout::Page) {
+                stack_.push_back({Kind::PageRoot});
+            } else {
+                beginRecord();
+            }
+            return true;
+        }
+
+        const Frame top = stack_.back();
+        switch (top.kind) {
+            case Kind::Records:
+            case Kind::Results:
+                if (isArray) {
+                    return fail("Expected an object in the result list");
+                }
+                beginRecord();
+                return true;
+
+            case Kind::PageRoot:
+                if (key_ == "info" && !isArray) {
+                    sawInfo_ = true;
+                    infoSeen_ = 0;
+                    stack_.push_back({Kind::Info});
+                } else if (key_ == "results" && isArray) {
+                    sawResults_ = true;
+                    stack_.push_back({Kind::Results});
+                } else {
+                    stack_.push_back({Kind::Skip});
+                }
+                return true;
+
+            case Kind::Record: {
+                if (keyField_ == NO_FIELD) {
+                    stack_.push_back({Kind::Skip});
+                    return true;
+                }
+                if (!apply<T>(Fields<T>::onContainer(keyField_, isArray), recordSeen_, keyField_)) {
+                    return false;
+                }
+                stack_.push_back({Kind::RecordField, keyField_, isArray});
+                return true;
+            }
+
+            case Kind::RecordField:
+                // List elements are URLs; unknown keys of nested objects may hold anything
+                if (top.isArray) {
+                    return mismatch<T>(top.field);
+                }
+                stack_.push_back({Kind::Skip});
+                return true;
+
+            case Kind::Info:
+                if (keyField_ != NO_FIELD) {
+                    return mismatch<PaginationInfo>(keyField_);
+                }
+                stack_.push_back({Kind::Skip});
+                return true;
+
+            case Kind::Skip:
+            default:
+                stack_.push_back({Kind::Skip});
+                return true;
+        }
+    }
+
+    bool close() {
+        const Kind kind = stack_.back().kind;
+        stack_.pop_back();
+        if (kind == Kind::Record) {
+            return endRecord<T>(*current_, recordSeen_);
+        }
+        if (kind == Kind::Info) {
+            return endRecord<PaginationInfo>(*info_, infoSeen_);
+        }
+        return true;
+    }
+
+    void beginRecord() {
+        current_ = &out_.emplace_back();
+        recordSeen_ = 0;
+        stack_.push_back({Kind::Record});
+    }
+
+    template<typename Model>
+    bool endRecord(Model& model, uint32_t seen) {
+        const uint32_t missing = Fields<Model>::REQUIRED & ~seen;
+        if (missing != 0) {
+            for (size_t i = 0; i < Fields<Model>::NAMES.size(); ++i) {
+                if (missing & (1u << i)) {
+                    return fail("Missing field '" + std::string(Fields<Model>::NAMES[i]) + "'");
+                }
+            }
+        }
+        Fields<Model>::finish(model);
+        return true;
+    }
+
+    Layout layout_;
+    std::vector<T>& out_;
+    PaginationInfo* info_;  // Only set, and only reached, for Layout::Page
+
+    std::vector<Frame> stack_;
+    std::string key_;
+    size_t keyField_ = NO_FIELD;
+    T* current_ = nullptr;
+    uint32_t recordSeen_ = 0;
+    uint32_t infoSeen_ = 0;
+    bool sawInfo_ = false;
+    bool sawResults_ = false;
+    std::string error_;
+};
+
+template<typename T>
+void run(std::string_view text, ModelSaxHandler<T>& handler) {
+    if (!json::sax_parse(text.data(), text.data() + text.size(), &handler)) {
+        throw ModelParseError(handler.error().empty() ? "Invalid JSON" : handler.error());
+    }
+}
+
+template<typename T>
+T parseSingle(std::string_view text) {
+    std::vector<T> out;
+    ModelSaxHandler<T> handler(Layout::Object, out, nullptr);
+    run(text, handler);
+    return std::move(out.front());
+}
+
+template<typename T>
+PaginationInfo parsePageWith(std::string_view text, std::vector<T>& out) {
+    PaginationInfo info;
+    ModelSaxHandler<T> handler(Layout::Page, out, &info);
+    run(text, handler);
+    if (!handler.sawInfo()) {
+        throw ModelParseError("Missing field 'info'");
+    }
+    if (!handler.sawResults()) {
+        throw ModelParseError("Missing field 'results'");
+    }
+    return info;
+}
+
+} // namespace
+
+Character NlohmannModelParser::parseCharacter(std::string_view json) {
+    return parseSingle<Character>(json);
+}
+
+Episode NlohmannModelParser::parseEpisode(std::string_view json) {
+    return parseSingle<Episode>(json);
+}
+
+Location NlohmannModelParser::parseLocation(std::string_view json) {
+    return parseSingle<Location>(json);
+}
+
+std::vector<Character> NlohmannModelParser::parseCharacterList(std::string_view json) {
+    std::vector<Character> characters;
+    ModelSaxHandler<Character> handler(Layout::ObjectOrArray, characters, nullptr);
+    run(json, handler);
+    return characters;
+}
+
+PaginationInfo NlohmannModelParser::parsePage(std::string_view json, std::vector<Episode>& out) {
+    return parsePageWith(json, out);
+}
+
+PaginationInfo NlohmannModelParser::parsePage(std::string_view json, std::vector<Character>& out) {
+    return parsePageWith(json, out);
+}
+
+PaginationInfo NlohmannModelParser::parsePage(std::string_view json, std::vector<Location>& out) {
+    return parsePageWith(json, out);
+}
+
+} // namespace rickmorty
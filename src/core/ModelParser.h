@@ -0,0 +1,125 @@
+#pragma once
+
+/**
+ * @file ModelParser.h
+ * @brief Streaming (SAX) JSON parsing straight into the API models.
+ *
+ * The from_json overloads in Models.h need a complete nlohmann::json DOM,
+ * so every response used to exist twice in memory: once as a tree of
+ * json values and once as the models copied out of it. These functions
+ * drive nlohmann's SAX parser instead and write each value into its
+ * Character, Episode, Location or PaginationInfo field as it is read, so
+ * no intermediate tree is built and strings are moved rather than copied.
+ *
+ * Validation matches from_json: every field from_json reads with at() is
+ * required, and a value of the wrong JSON type is rejected.
+ *
+ * The parser backend is chosen at build time with the RICKMORTY_JSON_BACKEND
+ * CMake cache variable: "nlohmann" (the default) or "simdjson".
+ */
+
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "Models.h"
+
+namespace rickmorty {
+
+/**
+ * @class ModelParseError
+ * @brief Thrown when a body is not valid JSON or does not have the model's shape.
+ */
+class ModelParseError : public std::runtime_error {
+public:
+    using std::runtime_error::runtime_error;
+};
+
+/**
+ * @struct NlohmannModelParser
+ * @brief Parses through nlohmann's SAX interface. Always built.
+ *
+ * Each parser backend exposes the same static functions, so tests and
+ * benchmarks can run against every backend that was compiled in. Code
+ * that does not care which backend it gets calls the free functions
+ * below, which forward to ModelParser.
+ */
+struct NlohmannModelParser {
+    static constexpr const char* NAME = "nlohmann";
+
+    /**
+     * @brief Parses a single resource object.
+     * @throws ModelParseError on malformed JSON, a missing field or a mistyped value.
+     */
+    static Character parseCharacter(std::string_view json);
+    static Episode parseEpisode(std::string_view json);
+    static Location parseLocation(std::string_view json);
+
+    /**
+     * @brief Parses a multi-id character response: an array of characters, or a
+     *        bare object when a single id was requested.
+     * @throws ModelParseError as above.
+     */
+    static std::vector<Character> parseCharacterList(std::string_view json);
+
+    /**
+     * @brief Parses one page of a paginated endpoint, appending its results to out.
+     * @return The page's "info" block.
+     * @throws ModelParseError as above, or if "info" or "results" is missing.
+     */
+    static PaginationInfo parsePage(std::string_view json, std::vector<Episode>& out);
+    static PaginationInfo parsePage(std::string_view json, std::vector<Character>& out);
+    static PaginationInfo parsePage(std::string_view json, std::vector<Location>& out);
+};
+
+#ifdef RICKMORTY_JSON_SIMDJSON
+/**
+ * @struct SimdjsonModelParser
+ * @brief Parses with simdjson's On-Demand API, walking each record's fields
+ *        once in document order. Built when RICKMORTY_JSON_BACKEND=simdjson.
+ *
+ * Same functions and validation as NlohmannModelParser. One difference:
+ * On-Demand only checks the bracket structure of values it skips, so
+ * malformed JSON inside a field the models do not read may be accepted.
+ */
+struct SimdjsonModelParser {
+    static constexpr const char* NAME = "simdjson";
+
+    static Character parseCharacter(std::string_view json);
+    static Episode parseEpisode(std::string_view json);
+    static Location parseLocation(std::string_view json);
+    static std::vector<Character> parseCharacterList(std::string_view json);
+    static PaginationInfo parsePage(std::string_view json, std::vector<Episode>& out);
+    static PaginationInfo parsePage(std::string_view json, std::vector<Character>& out);
+    static PaginationInfo parsePage(std::string_view json, std::vector<Location>& out);
+};
+
+/// The backend selected at build time
+using ModelParser = SimdjsonModelParser;
+#else
+/// The backend selected at build time
+using ModelParser = NlohmannModelParser;
+#endif
+
+inline Character parseCharacterJson(std::string_view json) {
+    return ModelParser::parseCharacter(json);
+}
+
+inline Episode parseEpisodeJson(std::string_view json) {
+    return ModelParser::parseEpisode(json);
+}
+
+inline Location parseLocationJson(std::string_view json) {
+    return ModelParser::parseLocation(json);
+}
+
+inline std::vector<Character> parseCharacterListJson(std::string_view json) {
+    return ModelParser::parseCharacterList(json);
+}
+
+template<typename T>
+PaginationInfo parsePageJson(std::string_view json, std::vector<T>& out) {
+    return ModelParser::parsePage(json, out);
+}
+
+} // namespace rickmorty
@@ -1,9 +1,16 @@
 #pragma once
 
+#include <charconv>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
 #include <string>
+#include <string_view>
+#include <type_traits>
 #include <vector>
 #include <optional>
 #include <nlohmann/json.hpp>
+#include "StringPool.h"
 
 namespace rickmorty {
 
@@ -37,39 +44,73 @@ inline std::string genderToString(Gender gender) {
     }
 }
 
-struct LocationReference {
-    std::string name;
+inline CharacterStatus statusFromString(std::string_view status) {
+    if (status == "Alive") return CharacterStatus::Alive;
+    if (status == "Dead") return CharacterStatus::Dead;
+    return CharacterStatus::Unknown;
+}
+
+inline Gender genderFromString(std::string_view gender) {
+    if (gender == "Female") return Gender::Female;
+    if (gender == "Male") return Gender::Male;
+    if (gender == "Genderless") return Gender::Genderless;
+    return Gender::Unknown;
+}
+
+// Resource URLs the API reports are always <RESOURCE_URL_BASE>/<resource>/<id>,
+// whichever base URL the client talks to, so the models keep only the ids
+inline constexpr std::string_view RESOURCE_URL_BASE = "https://rickandmortyapi.com/api";
+
+inline std::string resourceUrl(std::string_view resource, int id) {
+    const std::string number = std::to_string(id);
     std::string url;
-    int id = -1;
+    url.reserve(RESOURCE_URL_BASE.size() + resource.size() + number.size() + 2);
+    url.append(RESOURCE_URL_BASE).append(1, '/').append(resource).append(1, '/').append(number);
+    return url;
+}
+
+// Species, type and location names repeat across characters, so they are
+// interned; character names are unique and are not
+struct LocationReference {
+    InternedString name;
+    int id = -1;   // -1 when the API gives no location URL ("" or null)
+
+    std::string url() const { return id < 0 ? std::string() : resourceUrl("location", id); }
 };
 
 struct Character {
     int id = 0;
     std::string name;
     CharacterStatus status = CharacterStatus::Unknown;
-    std::string species;
-    std::string type;
+    InternedString species;
+    InternedString type;
     Gender gender = Gender::Unknown;
     LocationReference origin;
     LocationReference location;
     std::string imageUrl;
     std::vector<int> episodeIds;
-    std::string url;
-    std::string created;
+    int64_t createdMs = 0;   // See parseTimestamp
+
+    std::string url() const { return resourceUrl("character", id); }
 
     bool operator<(const Character& other) const {
         return name < other.name;
     }
 };
 
+/// Shared handle to a cached, immutable Character. Copying one costs a
+/// reference count, and the record lives as long as any handle to it.
+using CharacterPtr = std::shared_ptr<const Character>;
+
 struct Location {
     int id = 0;
     std::string name;
     std::string type;
     std::string dimension;
     std::vector<int> residentIds;
-    std::string url;
-    std::string created;
+    int64_t createdMs = 0;
+
+    std::string url() const { return resourceUrl("location", id); }
 };
 
 struct Episode {
@@ -78,10 +119,11 @@ struct Episode {
     std::string airDate;
     std::string episodeCode;
     std::vector<int> characterIds;
-    std::string url;
-    std::string created;
+    int64_t createdMs = 0;
     int season = 0;
     int episodeNumber = 0;
+
+    std::string url() const { return resourceUrl("episode", id); }
 };
 
 struct PaginationInfo {
@@ -91,26 +133,163 @@ struct PaginationInfo {
     std::optional<std::string> prev;
 };
 
-// Helper to extract ID from URL
-inline int extractIdFromUrl(const std::string& url) {
-    if (url.empty()) return -1;
-    auto pos = url.rfind('/');
-    if (pos != std::string::npos && pos + 1 < url.size()) {
+// Helper to extract ID from URL: the integer after the last '/', or -1.
+// Matches std::stoi on that suffix (leading whitespace and a sign are
+// accepted, trailing characters ignored, out-of-range values rejected)
+// without allocating or throwing.
+inline int extractIdFromUrl(std::string_view url) noexcept {
+    const auto pos = url.rfind('/');
+    if (pos == std::string_view::npos) return -1;
+
+    const char* first = url.data() + pos + 1;
+    const char* last = url.data() + url.size();
+    while (first != last && (*first == ' ' || (*first >= '\t' && *first <= '\r'))) {
+        ++first;
+    }
+    if (first != last && *first == '+') {
+        ++first;
+        if (first == last || *first < '0' || *first > '9') return -1;
+    }
+
+    int id = -1;
+    if (std::from_chars(first, last, id).ec != std::errc()) return -1;
+    return id;
+}
+
+// Bulk form of extractIdFromUrl: appends one id per URL to ids, reserving
+// room for all of them first. Accepts any sized range of strings,
+// including a nlohmann::json array (or a single string, which from_json
+// iterates as one element).
+template<typename Urls>
+void extractIdsFromUrls(const Urls& urls, std::vector<int>& ids) {
+    ids.reserve(ids.size() + urls.size());
+    for (const auto& url : urls) {
+        if constexpr (std::is_same_v<std::decay_t<decltype(url)>, nlohmann::json>) {
+            ids.push_back(extractIdFromUrl(url.template get_ref<const std::string&>()));
+        } else {
+            ids.push_back(extractIdFromUrl(url));
+        }
+    }
+}
+
+// Days from 1970-01-01 to a proleptic Gregorian date, and back
+// (H. Hinnant's days_from_civil / civil_from_days)
+constexpr int64_t daysFromCivil(int64_t year, int month, int day) noexcept {
+    year -= month <= 2;
+    const int64_t era = (year >= 0 ? year : year - 399) / 400;
+    const int64_t yearOfEra = year - era * 400;
+    const int64_t dayOfYear = (153 * (month > 2 ? month - 3 : month + 9) + 2) / 5 + day - 1;
+    const int64_t dayOfEra = yearOfEra * 365 + yearOfEra / 4 - yearOfEra / 100 + dayOfYear;
+    return era * 146097 + dayOfEra - 719468;
+}
+
+constexpr void civilFromDays(int64_t days, int64_t& year, int& month, int& day) noexcept {
+    days += 719468;
+    const int64_t era = (days >= 0 ? days : days - 146096) / 146097;
+    const int64_t dayOfEra = days - era * 146097;
+    const int64_t yearOfEra = (dayOfEra - dayOfEra / 1460 + dayOfEra / 36524 - dayOfEra / 146096) / 365;
+    const int64_t dayOfYear = dayOfEra - (365 * yearOfEra + yearOfEra / 4 - yearOfEra / 100);
+    const int64_t shiftedMonth = (5 * dayOfYear + 2) / 153;
+    day = static_cast<int>(dayOfYear - (153 * shiftedMonth + 2) / 5 + 1);
+    month = static_cast<int>(shiftedMonth < 10 ? shiftedMonth + 3 : shiftedMonth - 9);
+    year = yearOfEra + era * 400 + (month <= 2);
+}
+
+// Parses the API's UTC timestamps ("2017-11-04T18:48:46.250Z") to
+// milliseconds since the Unix epoch. The fraction and the trailing 'Z' are
+// optional; text that is not such a timestamp (including "") yields 0.
+inline int64_t parseTimestamp(std::string_view text) noexcept {
+    auto digits = [text](size_t pos, size_t count, int& value) {
+        if (pos + count > text.size()) return false;
+        value = 0;
+        for (size_t i = pos; i < pos + count; ++i) {
+            if (text[i] < '0' || text[i] > '9') return false;
+            value = value * 10 + (text[i] - '0');
+        }
+        return true;
+    };
+    auto separator = [text](size_t pos, char expected) {
+        return pos < text.size() && text[pos] == expected;
+    };
+
+    int year = 0, month = 0, day = 0, hour = 0, minute = 0, second = 0;
+    if (!digits(0, 4, year) || !separator(4, '-') || !digits(5, 2, month) || !separator(7, '-') ||
+        !digits(8, 2, day) || !separator(10, 'T') || !digits(11, 2, hour) || !separator(13, ':') ||
+        !digits(14, 2, minute) || !separator(16, ':') || !digits(17, 2, second)) {
+        return 0;
+    }
+    if (month < 1 || month > 12 || day < 1 || day > 31 || hour > 23 || minute > 59 || second > 60) {
+        return 0;
+    }
+
+    int millis = 0;
+    size_t pos = 19;
+    if (separator(pos, '.')) {
+        int scale = 100;
+        for (++pos; pos < text.size() && text[pos] >= '0' && text[pos] <= '9'; ++pos) {
+            millis += (text[pos] - '0') * scale;
+            scale /= 10;
+        }
+    }
+    if (separator(pos, 'Z')) {
+        ++pos;
+    }
+    if (pos != text.size()) {
+        return 0;
+    }
+
+    const int64_t seconds = daysFromCivil(year, month, day) * 86400 + hour * 3600 + minute * 60 + second;
+    return seconds * 1000 + millis;
+}
+
+// Inverse of parseTimestamp, in the API's own format
+inline std::string formatTimestamp(int64_t epochMs) {
+    int64_t days = epochMs / 86400000;
+    int64_t millisOfDay = epochMs % 86400000;
+    if (millisOfDay < 0) {
+        millisOfDay += 86400000;
+        --days;
+    }
+    int64_t year = 0;
+    int month = 0, day = 0;
+    civilFromDays(days, year, month, day);
+
+    const int seconds = static_cast<int>(millisOfDay / 1000);
+    char buffer[32];
+    std::snprintf(buffer, sizeof(buffer), "%04lld-%02d-%02dT%02d:%02d:%02d.%03dZ",
+                  static_cast<long long>(year), month, day, seconds / 3600, seconds / 60 % 60,
+                  seconds % 60, static_cast<int>(millisOfDay % 1000));
+    return buffer;
+}
+
+// Display form of a createdMs field: parseTimestamp stores 0 for a missing or
+// unparseable `created`, which shows as "" rather than the epoch
+inline std::string formatCreated(int64_t createdMs) {
+    return createdMs == 0 ? std::string() : formatTimestamp(createdMs);
+}
+
+// Helper to fill season and episodeNumber from the episode code (S01E01 format)
+inline void decodeEpisodeCode(Episode& e) {
+    if (e.episodeCode.length() >= 6 && e.episodeCode[0] == 'S') {
         try {
-            return std::stoi(url.substr(pos + 1));
+            e.season = std::stoi(e.episodeCode.substr(1, 2));
+            e.episodeNumber = std::stoi(e.episodeCode.substr(4, 2));
         } catch (...) {
-            return -1;
+            e.season = 0;
+            e.episodeNumber = 0;
         }
     }
-    return -1;
 }
 
 // JSON deserialization
+inline void from_json(const nlohmann::json& j, InternedString& s) {
+    s = j.get_ref<const std::string&>();
+}
+
 inline void from_json(const nlohmann::json& j, LocationReference& loc) {
     j.at("name").get_to(loc.name);
     if (j.contains("url") && !j.at("url").is_null()) {
-        loc.url = j.at("url").get<std::string>();
-        loc.id = extractIdFromUrl(loc.url);
+        loc.id = extractIdFromUrl(j.at("url").get_ref<const std::string&>());
     }
 }
 
@@ -120,26 +299,16 @@ inline void from_json(const nlohmann::json& j, Character& c) {
     j.at("species").get_to(c.species);
     j.at("type").get_to(c.type);
     j.at("image").get_to(c.imageUrl);
-    j.at("url").get_to(c.url);
-    j.at("created").get_to(c.created);
+    j.at("url").get_ref<const std::string&>();   // Required; url() rebuilds it from id
+    c.createdMs = parseTimestamp(j.at("created").get_ref<const std::string&>());
 
-    std::string status = j.at("status").get<std::string>();
-    if (status == "Alive") c.status = CharacterStatus::Alive;
-    else if (status == "Dead") c.status = CharacterStatus::Dead;
-    else c.status = CharacterStatus::Unknown;
-
-    std::string gender = j.at("gender").get<std::string>();
-    if (gender == "Female") c.gender = Gender::Female;
-    else if (gender == "Male") c.gender = Gender::Male;
-    else if (gender == "Genderless") c.gender = Gender::Genderless;
-    else c.gender = Gender::Unknown;
+    c.status = statusFromString(j.at("status").get<std::string>());
+    c.gender = genderFromString(j.at("gender").get<std::string>());
 
     c.origin = j.at("origin").get<LocationReference>();
     c.location = j.at("location").get<LocationReference>();
 
-    for (const auto& epUrl : j.at("episode")) {
-        c.episodeIds.push_back(extractIdFromUrl(epUrl.get<std::string>()));
-    }
+    extractIdsFromUrls(j.at("episode"), c.episodeIds);
 }
 
 inline void from_json(const nlohmann::json& j, Episode& e) {
@@ -147,23 +316,12 @@ inline void from_json(const nlohmann::json& j, Episode& e) {
     j.at("name").get_to(e.name);
     j.at("air_date").get_to(e.airDate);
     j.at("episode").get_to(e.episodeCode);
-    j.at("url").get_to(e.url);
-    j.at("created").get_to(e.created);
+    j.at("url").get_ref<const std::string&>();   // Required; url() rebuilds it from id
+    e.createdMs = parseTimestamp(j.at("created").get_ref<const std::string&>());
 
-    // Parse episode code (S01E01 format)
-    if (e.episodeCode.length() >= 6 && e.episodeCode[0] == 'S') {
-        try {
-            e.season = std::stoi(e.episodeCode.substr(1, 2));
-            e.episodeNumber = std::stoi(e.episodeCode.substr(4, 2));
-        } catch (...) {
-            e.season = 0;
-            e.episodeNumber = 0;
-        }
-    }
+    decodeEpisodeCode(e);
 
-    for (const auto& charUrl : j.at("characters")) {
-        e.characterIds.push_back(extractIdFromUrl(charUrl.get<std::string>()));
-    }
+    extractIdsFromUrls(j.at("characters"), e.characterIds);
 }
 
 inline void from_json(const nlohmann::json& j, Location& l) {
@@ -171,12 +329,10 @@ inline void from_json(const nlohmann::json& j, Location& l) {
     j.at("name").get_to(l.name);
     j.at("type").get_to(l.type);
     j.at("dimension").get_to(l.dimension);
-    j.at("url").get_to(l.url);
-    j.at("created").get_to(l.created);
+    j.at("url").get_ref<const std::string&>();   // Required; url() rebuilds it from id
+    l.createdMs = parseTimestamp(j.at("created").get_ref<const std::string&>());
 
-    for (const auto& resUrl : j.at("residents")) {
-        l.residentIds.push_back(extractIdFromUrl(resUrl.get<std::string>()));
-    }
+    extractIdsFromUrls(j.at("residents"), l.residentIds);
 }
 
 inline void from_json(const nlohmann::json& j, PaginationInfo& p) {
@@ -1,19 +1,32 @@
 #pragma once
 
+#include <cstddef>
 #include <vector>
 #include <string>
 #include "Models.h"
 
 namespace rickmorty {
 
+// Progress of DataStore::warmUp, reported after every fetched page
+struct WarmupProgress {
+    enum class Stage { Episodes, Characters, Locations, Done };
+
+    Stage stage = Stage::Episodes;
+    size_t loaded = 0;  // Items of the current stage fetched so far
+    size_t total = 0;   // Items in the current stage
+};
+
 class IDataObserver {
 public:
     virtual ~IDataObserver() = default;
 
     virtual void onEpisodesLoaded(const std::vector<Episode>& episodes) = 0;
-    virtual void onCharactersLoaded(int episodeId, const std::vector<Character>& characters) = 0;
+    virtual void onCharactersLoaded(int episodeId, const std::vector<CharacterPtr>& characters) = 0;
     virtual void onLoadingStateChanged(bool isLoading) = 0;
     virtual void onError(const std::string& message) = 0;
+
+    // Only observers that display warmup progress need to override this
+    virtual void onWarmupProgress(const WarmupProgress& /*progress*/) {}
 };
 
 class IDataSubject {
@@ -25,9 +38,10 @@ public:
 
 protected:
     virtual void notifyEpisodesLoaded(const std::vector<Episode>& episodes) = 0;
-    virtual void notifyCharactersLoaded(int episodeId, const std::vector<Character>& characters) = 0;
+    virtual void notifyCharactersLoaded(int episodeId, const std::vector<CharacterPtr>& characters) = 0;
     virtual void notifyLoadingStateChanged(bool isLoading) = 0;
     virtual void notifyError(const std::string& message) = 0;
+    virtual void notifyWarmupProgress(const WarmupProgress& progress) = 0;
 };
 
 } // namespace rickmorty
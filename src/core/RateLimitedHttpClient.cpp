@@ -0,0 +1,169 @@
+#include "RateLimitedHttpClient.h"
+#include <algorithm>
+#include <thread>
+#include <glog/logging.h>
+
+namespace rickmorty {
+
+namespace {
+
+bool isRetryable(const HttpException& e) {
+    return e.type() == HttpException::Type::Timeout
+        || e.httpCode() == 429
+        || e.httpCode() >= 500;
+}
+
+} // namespace
+
+RateLimitedHttpClient::RateLimitedHttpClient(std::unique_ptr<IHttpClient> inner)
+    : RateLimitedHttpClient(std::move(inner), Policy())
+{
+}
+
+RateLimitedHttpClient::RateLimitedHttpClient(std::unique_ptr<IHttpClient> inner, Policy policy)
+    : inner_(std::move(inner))
+    , policy_(policy)
+    , tokens_(policy.burst)
+    , lastRefill_(Clock::now())
+    , pausedUntil_(Clock::time_point::min())
+    , rng_(std::random_device{}())
+{
+    if (!inner_) {
+        throw HttpException(HttpException::Type::NetworkError, "Wrapped HTTP client cannot be null");
+    }
+    if (policy_.requestsPerSecond <= 0 || policy_.burst < 1) {
+        throw HttpException(HttpException::Type::NetworkError,
+            "Rate limit needs a positive rate and a burst of at least one request");
+    }
+}
+
+RateLimitedHttpClient::~RateLimitedHttpClient() = default;
+
+std::string RateLimitedHttpClient::get(const std::string& url) {
+    return withRetries(url, [&] { return inner_->get(url); });
+}
+
+void RateLimitedHttpClient::getInto(const std::string& url, std::string& body) {
+    withRetries(url, [&] { inner_->getInto(url, body); });
+}
+
+HttpResponse RateLimitedHttpClient::getConditional(const std::string& url, const HttpValidators& validators) {
+    return withRetries(url, [&] { return inner_->getConditional(url, validators); });
+}
+
+void RateLimitedHttpClient::getConditionalInto(const std::string& url, const HttpValidators& validators,
+                                               HttpResponse& response) {
+    withRetries(url, [&] { inner_->getConditionalInto(url, validators, response); });
+}
+
+void RateLimitedHttpClient::setTimeout(long timeoutMs) {
+    inner_->setTimeout(timeoutMs);
+}
+
+void RateLimitedHttpClient::setUserAgent(const std::string& userAgent) {
+    inner_->setUserAgent(userAgent);
+}
+
+bool RateLimitedHttpClient::supportsConcurrentRequests() const {
+    return inner_->supportsConcurrentRequests();
+}
+
+RateLimitedHttpClient::Stats RateLimitedHttpClient::stats() const {
+    Stats stats;
+    stats.requests = requests_.load();
+    stats.retries = retries_.load();
+    stats.rateLimited = rateLimited_.load();
+    stats.throttledMs = throttledMs_.load();
+    return stats;
+}
+
+template <typename Request>
+auto RateLimitedHttpClient::withRetries(const std::string& url, Request request) -> decltype(request()) {
+    for (int attempt = 0;; ++attempt) {
+        acquireToken();
+        requests_++;
+        if (attempt > 0) {
+            retries_++;
+        }
+
+        try {
+            return request();
+        } catch (const HttpException& e) {
+            if (e.httpCode() == 429) {
+                rateLimited_++;
+            }
+            if (!isRetryable(e) || attempt >= policy_.maxRetries) {
+                throw;
+            }
+
+            const std::chrono::milliseconds delay = retryDelay(e, attempt);
+            if (delay > policy_.maxBackoff) {
+                LOG(WARNING) << "Retry-After of " << delay.count() << " ms exceeds the backoff limit, giving up: " << url;
+                throw;
+            }
+            LOG(WARNING) << "Retrying " << url << " in " << delay.count() << " ms after: " << e.what()
+                         << " (attempt " << attempt + 1 << " of " << policy_.maxRetries << ")";
+
+            if (e.httpCode() == 429) {
+                // The server is over its limit for everyone: hold all callers, not just this one
+                pauseUntil(Clock::now() + delay);
+            } else {
+                wait(delay);
+            }
+        }
+    }
+}
+
+void RateLimitedHttpClient::acquireToken() {
+    std::chrono::milliseconds delay{0};
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        const auto now = Clock::now();
+        const double elapsed = std::chrono::duration<double>(now - lastRefill_).count();
+        tokens_ = std::min(policy_.burst, tokens_ + elapsed * policy_.requestsPerSecond);
+        lastRefill_ = now;
+
+        // Reserve a token even when the bucket is empty; the deficit becomes this
+        // caller's wait, so concurrent callers queue up in arrival order
+        tokens_ -= 1.0;
+        if (tokens_ < 0) {
+            delay = std::chrono::milliseconds(
+                static_cast<long long>(-tokens_ / policy_.requestsPerSecond * 1000.0 + 0.5));
+        }
+        if (pausedUntil_ > now) {
+            delay = std::max(delay, std::chrono::duration_cast<std::chrono::milliseconds>(pausedUntil_ - now));
+        }
+    }
+    wait(delay);
+}
+
+std::chrono::milliseconds RateLimitedHttpClient::retryDelay(const HttpException& e, int attempt) {
+    if (e.httpCode() == 429 && e.retryAfterMs() > 0) {
+        return std::chrono::milliseconds(e.retryAfterMs());
+    }
+
+    // Full jitter: spreads retries of simultaneous failures over the whole window
+    const long long ceiling = std::min<long long>(
+        policy_.maxBackoff.count(), policy_.baseBackoff.count() << std::min(attempt, 20));
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::uniform_int_distribution<long long> jitter(0, std::max(0LL, ceiling));
+    return std::chrono::milliseconds(jitter(rng_));
+}
+
+void RateLimitedHttpClient::pauseUntil(Clock::time_point until) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        pausedUntil_ = std::max(pausedUntil_, until);
+    }
+    // The retry itself waits in acquireToken(), together with every other caller
+}
+
+void RateLimitedHttpClient::wait(std::chrono::milliseconds delay) {
+    if (delay.count() <= 0) {
+        return;
+    }
+    throttledMs_ += static_cast<uint64_t>(delay.count());
+    std::this_thread::sleep_for(delay);
+}
+
+} // namespace rickmorty
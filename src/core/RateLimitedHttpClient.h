@@ -0,0 +1,150 @@
+#pragma once
+
+/**
+ * @file RateLimitedHttpClient.h
+ * @brief IHttpClient decorator with a token-bucket rate limit and retry backoff.
+ */
+
+#include "IHttpClient.h"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <string>
+
+namespace rickmorty {
+
+/**
+ * @class RateLimitedHttpClient
+ * @brief Keeps request rate under a budget and retries transient failures.
+ *
+ * Wraps another IHttpClient. Every request first takes a token from a token
+ * bucket that refills at requestsPerSecond up to burst tokens, so short bursts
+ * (scrolling the episode list) go out at once while sustained load settles at
+ * the configured rate.
+ *
+ * Failed requests are retried up to maxRetries times:
+ * - HTTP 429: waits for the server's Retry-After delay (or the backoff below
+ *   when none was sent). The wait also pauses the bucket, so other callers
+ *   hold back instead of adding to the error storm.
+ * - HTTP 5xx and timeouts: exponential backoff with full jitter, a random
+ *   delay in [0, min(maxBackoff, baseBackoff * 2^attempt)].
+ * Other errors (404, network failures, other 4xx) are rethrown immediately.
+ *
+ * @note Thread-safe as long as the wrapped client is. getAsync() uses the
+ *       blocking default from IHttpClient so that it is throttled too.
+ *
+ * Example usage:
+ * @code
+ * RateLimitedHttpClient::Policy policy;
+ * policy.requestsPerSecond = 2.0;
+ * auto http = std::make_unique<RateLimitedHttpClient>(std::make_unique<CurlHttpClient>(), policy);
+ * @endcode
+ */
+class RateLimitedHttpClient : public IHttpClient {
+public:
+    /**
+     * @struct Policy
+     * @brief Rate limit and retry settings.
+     */
+    struct Policy {
+        double requestsPerSecond = 5.0;                   ///< Sustained request rate (token refill rate)
+        double burst = 10.0;                              ///< Bucket capacity: requests allowed back to back
+        int maxRetries = 3;                               ///< Retries after the first attempt
+        std::chrono::milliseconds baseBackoff{250};       ///< Backoff ceiling for the first retry
+        std::chrono::milliseconds maxBackoff{8000};       ///< Upper bound for any backoff or Retry-After wait
+    };
+
+    /**
+     * @struct Stats
+     * @brief Counters describing throttling and retries.
+     */
+    struct Stats {
+        uint64_t requests = 0;     ///< Attempts sent to the wrapped client, retries included
+        uint64_t retries = 0;      ///< Attempts that were retries
+        uint64_t rateLimited = 0;  ///< HTTP 429 answers received
+        uint64_t throttledMs = 0;  ///< Total time callers waited for tokens or backoff
+    };
+
+    /**
+     * @brief Wraps an HTTP client with the default Policy.
+     * @param inner The client that performs the actual requests (must not be null).
+     * @throws HttpException if inner is null.
+     */
+    explicit RateLimitedHttpClient(std::unique_ptr<IHttpClient> inner);
+
+    /**
+     * @brief Wraps an HTTP client with rate limiting.
+     * @param inner The client that performs the actual requests (must not be null).
+     * @param policy Rate and retry settings.
+     * @throws HttpException if inner is null or the policy rate/burst is not positive.
+     */
+    RateLimitedHttpClient(std::unique_ptr<IHttpClient> inner, Policy policy);
+    ~RateLimitedHttpClient() override;
+
+    RateLimitedHttpClient(const RateLimitedHttpClient&) = delete;
+    RateLimitedHttpClient& operator=(const RateLimitedHttpClient&) = delete;
+
+    /**
+     * @brief Performs a throttled GET, retrying transient failures.
+     * @throws HttpException from the last attempt when retries are exhausted
+     *         or the error is not retryable.
+     */
+    std::string get(const std::string& url) override;
+
+    using IHttpClient::get;
+
+    /**
+     * @brief Performs a throttled in-place GET, retrying transient failures.
+     */
+    void getInto(const std::string& url, std::string& body) override;
+
+    /**
+     * @brief Performs a throttled conditional GET, retrying transient failures.
+     */
+    HttpResponse getConditional(const std::string& url, const HttpValidators& validators) override;
+
+    /**
+     * @brief Performs a throttled in-place conditional GET, retrying transient failures.
+     */
+    void getConditionalInto(const std::string& url, const HttpValidators& validators,
+                            HttpResponse& response) override;
+
+    void setTimeout(long timeoutMs) override;
+    void setUserAgent(const std::string& userAgent) override;
+    bool supportsConcurrentRequests() const override;
+
+    /**
+     * @brief Returns a snapshot of the throttling counters.
+     */
+    Stats stats() const;
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    template <typename Request>
+    auto withRetries(const std::string& url, Request request) -> decltype(request());
+
+    void acquireToken();
+    std::chrono::milliseconds retryDelay(const HttpException& e, int attempt);
+    void pauseUntil(Clock::time_point until);
+    void wait(std::chrono::milliseconds delay);
+
+    std::unique_ptr<IHttpClient> inner_;
+    const Policy policy_;
+
+    std::mutex mutex_;
+    double tokens_;
+    Clock::time_point lastRefill_;
+    Clock::time_point pausedUntil_;
+    std::mt19937 rng_;
+
+    std::atomic<uint64_t> requests_{0};
+    std::atomic<uint64_t> retries_{0};
+    std::atomic<uint64_t> rateLimited_{0};
+    std::atomic<uint64_t> throttledMs_{0};
+};
+
+} // namespace rickmorty
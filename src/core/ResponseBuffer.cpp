@@ -0,0 +1,64 @@
+#include "ResponseBuffer.h"
+#include <utility>
+#include <vector>
+
+namespace rickmorty {
+
+namespace {
+
+// Per-thread free list; storage never crosses threads while pooled, so no locking
+std::vector<std::string>& threadPool() {
+    thread_local std::vector<std::string> pool = [] {
+        std::vector<std::string> buffers;
+        buffers.reserve(ResponseBuffer::POOL_SIZE);
+        return buffers;
+    }();
+    return pool;
+}
+
+// True if the string owns heap storage worth keeping (beyond the small-string buffer)
+bool hasHeapStorage(const std::string& s) {
+    return s.capacity() > std::string().capacity();
+}
+
+void recycle(std::string& data) {
+    if (!hasHeapStorage(data) || data.capacity() > ResponseBuffer::MAX_POOLED_CAPACITY) {
+        return;
+    }
+    auto& pool = threadPool();
+    if (pool.size() < ResponseBuffer::POOL_SIZE) {
+        data.clear();
+        pool.push_back(std::move(data));
+    }
+}
+
+} // namespace
+
+ResponseBuffer::ResponseBuffer() {
+    auto& pool = threadPool();
+    if (!pool.empty()) {
+        data_ = std::move(pool.back());
+        pool.pop_back();
+    }
+}
+
+ResponseBuffer::~ResponseBuffer() {
+    recycle(data_);
+}
+
+ResponseBuffer::ResponseBuffer(ResponseBuffer&& other) noexcept
+    : data_(std::move(other.data_))
+{
+    other.data_.clear();
+}
+
+ResponseBuffer& ResponseBuffer::operator=(ResponseBuffer&& other) noexcept {
+    if (this != &other) {
+        recycle(data_);
+        data_ = std::move(other.data_);
+        other.data_.clear();
+    }
+    return *this;
+}
+
+} // namespace rickmorty
@@ -0,0 +1,76 @@
+#pragma once
+
+/**
+ * @file ResponseBuffer.h
+ * @brief Reusable response body storage backed by a per-thread pool.
+ */
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+namespace rickmorty {
+
+/**
+ * @class ResponseBuffer
+ * @brief Response body buffer whose storage is recycled between requests.
+ *
+ * Constructing a ResponseBuffer takes a string from the current thread's
+ * pool (keeping the capacity it grew to for earlier responses), and
+ * destroying it hands the storage back. Once a thread has seen responses of
+ * the usual size, fetching into a ResponseBuffer does not allocate for the
+ * body at all.
+ *
+ * The body is consumed through view() without copying, e.g. by passing it
+ * straight to the JSON parser.
+ *
+ * Example usage:
+ * @code
+ * ResponseBuffer buffer;
+ * httpClient.get(url, buffer);
+ * auto json = nlohmann::json::parse(buffer.view());
+ * @endcode
+ */
+class ResponseBuffer {
+public:
+    /// Buffers kept per thread; more live buffers than this are simply freed
+    static constexpr size_t POOL_SIZE = 4;
+
+    /// Buffers that grew beyond this are freed instead of pooled
+    static constexpr size_t MAX_POOLED_CAPACITY = 8 * 1024 * 1024;
+
+    /**
+     * @brief Takes an empty buffer from the current thread's pool.
+     */
+    ResponseBuffer();
+
+    /**
+     * @brief Returns the storage to the pool of the destroying thread.
+     */
+    ~ResponseBuffer();
+
+    ResponseBuffer(ResponseBuffer&& other) noexcept;
+    ResponseBuffer& operator=(ResponseBuffer&& other) noexcept;
+
+    ResponseBuffer(const ResponseBuffer&) = delete;
+    ResponseBuffer& operator=(const ResponseBuffer&) = delete;
+
+    /**
+     * @brief Returns the underlying string for writers such as HTTP clients.
+     */
+    std::string& str() noexcept { return data_; }
+
+    /**
+     * @brief Returns the body without copying it.
+     * @note The view is invalidated when the buffer is written to or destroyed.
+     */
+    std::string_view view() const noexcept { return data_; }
+
+    size_t size() const noexcept { return data_.size(); }
+    bool empty() const noexcept { return data_.empty(); }
+
+private:
+    std::string data_;
+};
+
+} // namespace rickmorty
@@ -0,0 +1,35 @@
+#include "ReverseIndex.h"
+#include <algorithm>
+
+namespace rickmorty {
+
+void ReverseIndex::add(int key, int id) {
+    std::vector<int>& ids = links_[key];
+    auto it = std::lower_bound(ids.begin(), ids.end(), id);
+    if (it == ids.end() || *it != id) {
+        ids.insert(it, id);
+    }
+}
+
+void ReverseIndex::remove(int key, int id) {
+    auto found = links_.find(key);
+    if (found == links_.end()) {
+        return;
+    }
+    std::vector<int>& ids = found->second;
+    auto it = std::lower_bound(ids.begin(), ids.end(), id);
+    if (it != ids.end() && *it == id) {
+        ids.erase(it);
+        if (ids.empty()) {
+            links_.erase(found);
+        }
+    }
+}
+
+const std::vector<int>& ReverseIndex::get(int key) const {
+    static const std::vector<int> none;
+    auto it = links_.find(key);
+    return it != links_.end() ? it->second : none;
+}
+
+} // namespace rickmorty
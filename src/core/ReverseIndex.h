@@ -0,0 +1,44 @@
+#pragma once
+
+/**
+ * @file ReverseIndex.h
+ * @brief Id-to-ids multimap for answering "who refers to this?" queries.
+ */
+
+#include <cstddef>
+#include <unordered_map>
+#include <vector>
+
+namespace rickmorty {
+
+/**
+ * @class ReverseIndex
+ * @brief Maps a key id to the sorted, duplicate-free ids linked to it.
+ *
+ * DataStore keeps one per relation it needs to walk backwards, e.g.
+ * character id -> episodes whose cast lists it. Links are added and removed
+ * one at a time as records arrive or change, so the index never has to be
+ * rebuilt from a full scan.
+ *
+ * Not thread-safe to modify; DataStore only changes copies that no reader
+ * can see yet (see DataSnapshot).
+ */
+class ReverseIndex {
+public:
+    /// Links id to key; no-op if already linked
+    void add(int key, int id);
+    /// Unlinks id from key; no-op if not linked
+    void remove(int key, int id);
+
+    /// Ids linked to key in ascending order; empty if none
+    const std::vector<int>& get(int key) const;
+
+    /// Number of keys with at least one link
+    size_t keyCount() const { return links_.size(); }
+    void clear() { links_.clear(); }
+
+private:
+    std::unordered_map<int, std::vector<int>> links_;
+};
+
+} // namespace rickmorty
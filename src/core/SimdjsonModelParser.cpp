@@ -0,0 +1,431 @@
+#include "ModelParser.h"
+#include <array>
+#include <cstdint>
+#include <simdjson.h>
+
+namespace rickmorty {
+
+namespace {
+
+namespace ondemand = simdjson::ondemand;
+using ondemand::json_type;
+
+constexpr size_t NO_FIELD = static_cast<size_t>(-1);
+
+template<size_t N>
+size_t findField(const std::array<std::string_view, N>& fields, std::string_view key) {
+    for (size_t i = 0; i < N; ++i) {
+        if (fields[i] == key) {
+            return i;
+        }
+    }
+    return NO_FIELD;
+}
+
+[[noreturn]] void fail(const std::string& message) {
+    throw ModelParseError(message);
+}
+
+[[noreturn]] void mismatch(std::string_view field) {
+    fail("Unexpected type for field '" + std::string(field) + "'");
+}
+
+// simdjson reports malformed input as it reaches it, so any step can fail
+void check(simdjson::error_code error) {
+    if (error) {
+        fail(std::string("Invalid JSON: ") + simdjson::error_message(error));
+    }
+}
+
+template<typename Value>
+json_type typeOf(Value& value) {
+    json_type type = json_type::null;
+    check(value.type().get(type));
+    return type;
+}
+
+//=============================================================================
+// Value readers. Each checks the JSON type from_json would accept before
+// consuming the value.
+//=============================================================================
+
+// The view points into the parser's buffers and is valid until the next parse
+std::string_view readStringView(ondemand::value& value, std::string_view field) {
+    if (typeOf(value) != json_type::string) {
+        mismatch(field);
+    }
+    std::string_view text;
+    check(value.get_string().get(text));
+    return text;
+}
+
+std::string readString(ondemand::value& value, std::string_view field) {
+    return std::string(readStringView(value, field));
+}
+
+// get<int> accepts any number (floats are truncated) and booleans
+int readInt(ondemand::value& value, std::string_view field) {
+    switch (typeOf(value)) {
+        case json_type::number: {
+            ondemand::number number;
+            check(value.get_number().get(number));
+            switch (number.get_number_type()) {
+                case ondemand::number_type::signed_integer:
+                    return static_cast<int>(number.get_int64());
+                case ondemand::number_type::unsigned_integer:
+                    return static_cast<int>(number.get_uint64());
+                default:
+                    return static_cast<int>(static_cast<int64_t>(number.get_double()));
+            }
+        }
+        case json_type::boolean: {
+            bool flag = false;
+            check(value.get_bool().get(flag));
+            return flag ? 1 : 0;
+        }
+        default:
+            mismatch(field);
+    }
+}
+
+void readOptionalString(ondemand::value& value, std::string_view field, std::optional<std::string>& target) {
+    if (typeOf(value) != json_type::null) {
+        target = readString(value, field);
+    }
+}
+
+// A list of resource URLs stored as ids; a bare string counts as a
+// one-element list, as it does when from_json iterates it
+void readUrlIds(ondemand::value& value, std::string_view field, std::vector<int>& target) {
+    switch (typeOf(value)) {
+        case json_type::string:
+            target.push_back(extractIdFromUrl(readStringView(value, field)));
+            return;
+        case json_type::array: {
+            ondemand::array list;
+            check(value.get_array().get(list));
+            size_t count = 0;
+            check(list.count_elements().get(count));
+            target.reserve(target.size() + count);
+            for (auto element : list) {
+                ondemand::value url;
+                check(element.get(url));
+                target.push_back(extractIdFromUrl(readStringView(url, field)));
+            }
+            return;
+        }
+        default:
+            mismatch(field);
+    }
+}
+
+// {"name": ..., "url": ...} objects: name is required, url may be null
+void readReference(ondemand::value& value, std::string_view field, LocationReference& ref) {
+    if (typeOf(value) != json_type::object) {
+        mismatch(field);
+    }
+    ondemand::object object;
+    check(value.get_object().get(object));
+
+    bool hasName = false;
+    for (auto member : object) {
+        std::string_view key;
+        check(member.unescaped_key().get(key));
+        ondemand::value inner;
+        check(member.value().get(inner));
+        if (key == "name") {
+            ref.name = readStringView(inner, field);
+            hasName = true;
+        } else if (key == "url") {
+            if (typeOf(inner) != json_type::null) {
+                ref.id = extractIdFromUrl(readStringView(inner, field));
+            }
+        }
+    }
+    if (!hasName) {
+        fail("Missing field 'name' in '" + std::string(field) + "'");
+    }
+}
+
+//=============================================================================
+// Per-model field tables. Field i is tracked as bit i; REQUIRED lists the
+// fields from_json reads with at().
+//=============================================================================
+
+template<typename T>
+struct Fields;
+
+template<>
+struct Fields<Character> {
+    enum Field { ID, NAME, STATUS, SPECIES, TYPE, GENDER, ORIGIN, LOCATION, IMAGE, EPISODE, URL, CREATED };
+    static constexpr std::array<std::string_view, 12> NAMES = {
+        "id", "name", "status", "species", "type", "gender",
+        "origin", "location", "image", "episode", "url", "created"};
+    static constexpr uint32_t REQUIRED = (1u << 12) - 1;
+
+    static void read(Character& c, size_t field, ondemand::value& value) {
+        const std::string_view name = NAMES[field];
+        switch (field) {
+            case ID: c.id = readInt(value, name); break;
+            case NAME: c.name = readString(value, name); break;
+            case STATUS: c.status = statusFromString(readString(value, name)); break;
+            case SPECIES: c.species = readStringView(value, name); break;
+            case TYPE: c.type = readStringView(value, name); break;
+            case GENDER: c.gender = genderFromString(readString(value, name)); break;
+            case ORIGIN: readReference(value, name, c.origin); break;
+            case LOCATION: readReference(value, name, c.location); break;
+            case IMAGE: c.imageUrl = readString(value, name); break;
+            case EPISODE: readUrlIds(value, name, c.episodeIds); break;
+            case URL: readStringView(value, name); break;   // url() rebuilds it from id
+            case CREATED: c.createdMs = parseTimestamp(readStringView(value, name)); break;
+        }
+    }
+
+    static void finish(Character&) {}
+};
+
+template<>
+struct Fields<Episode> {
+    enum Field { ID, NAME, AIR_DATE, EPISODE, CHARACTERS, URL, CREATED };
+    static constexpr std::array<std::string_view, 7> NAMES = {
+        "id", "name", "air_date", "episode", "characters", "url", "created"};
+    static constexpr uint32_t REQUIRED = (1u << 7) - 1;
+
+    static void read(Episode& e, size_t field, ondemand::value& value) {
+        const std::string_view name = NAMES[field];
+        switch (field) {
+            case ID: e.id = readInt(value, name); break;
+            case NAME: e.name = readString(value, name); break;
+            case AIR_DATE: e.airDate = readString(value, name); break;
+            case EPISODE: e.episodeCode = readString(value, name); break;
+            case CHARACTERS: readUrlIds(value, name, e.characterIds); break;
+            case URL: readStringView(value, name); break;   // url() rebuilds it from id
+            case CREATED: e.createdMs = parseTimestamp(readStringView(value, name)); break;
+        }
+    }
+
+    static void finish(Episode& e) {
+        decodeEpisodeCode(e);
+    }
+};
+
+template<>
+struct Fields<Location> {
+    enum Field { ID, NAME, TYPE, DIMENSION, RESIDENTS, URL, CREATED };
+    static constexpr std::array<std::string_view, 7> NAMES = {
+        "id", "name", "type", "dimension", "residents", "url", "created"};
+    static constexpr uint32_t REQUIRED = (1u << 7) - 1;
+
+    static void read(Location& l, size_t field, ondemand::value& value) {
+        const std::string_view name = NAMES[field];
+        switch (field) {
+            case ID: l.id = readInt(value, name); break;
+            case NAME: l.name = readString(value, name); break;
+            case TYPE: l.type = readString(value, name); break;
+            case DIMENSION: l.dimension = readString(value, name); break;
+            case RESIDENTS: readUrlIds(value, name, l.residentIds); break;
+            case URL: readStringView(value, name); break;   // url() rebuilds it from id
+            case CREATED: l.createdMs = parseTimestamp(readStringView(value, name)); break;
+        }
+    }
+
+    static void finish(Location&) {}
+};
+
+template<>
+struct Fields<PaginationInfo> {
+    enum Field { COUNT, PAGES, NEXT, PREV };
+    static constexpr std::array<std::string_view, 4> NAMES = {"count", "pages", "next", "prev"};
+    static constexpr uint32_t REQUIRED = (1u << COUNT) | (1u << PAGES);
+
+    static void read(PaginationInfo& p, size_t field, ondemand::value& value) {
+        const std::string_view name = NAMES[field];
+        switch (field) {
+            case COUNT: p.count = readInt(value, name); break;
+            case PAGES: p.pages = readInt(value, name); break;
+            case NEXT: readOptionalString(value, name, p.next); break;
+            case PREV: readOptionalString(value, name, p.prev); break;
+        }
+    }
+
+    static void finish(PaginationInfo&) {}
+};
+
+//=============================================================================
+// Documents
+//=============================================================================
+
+// Walks the object's fields once, in document order; unknown keys are skipped
+template<typename T>
+void readRecord(ondemand::object& object, T& record) {
+    uint32_t seen = 0;
+    for (auto member : object) {
+        std::string_view key;
+        check(member.unescaped_key().get(key));
+        const size_t field = findField(Fields<T>::NAMES, key);
+        if (field != NO_FIELD) {
+            ondemand::value value;
+            check(member.value().get(value));
+            Fields<T>::read(record, field, value);
+            seen |= 1u << field;
+        }
+    }
+
+    const uint32_t missing = Fields<T>::REQUIRED & ~seen;
+    for (size_t i = 0; i < Fields<T>::NAMES.size(); ++i) {
+        if (missing & (1u << i)) {
+            fail("Missing field '" + std::string(Fields<T>::NAMES[i]) + "'");
+        }
+    }
+    Fields<T>::finish(record);
+}
+
+template<typename T>
+void readRecords(ondemand::array& list, std::vector<T>& out) {
+    for (auto element : list) {
+        ondemand::value value;
+        check(element.get(value));
+        if (typeOf(value) != json_type::object) {
+            fail("Expected an object in the result list");
+        }
+        ondemand::object object;
+        check(value.get_object().get(object));
+        readRecord(object, out.emplace_back());
+    }
+}
+
+/**
+ * The parser keeps its buffers between documents, so each thread reuses
+ * one. simdjson also reads up to SIMDJSON_PADDING bytes past the end of
+ * its input; response bodies carry no such slack, so they are copied into
+ * a padded buffer that is likewise reused.
+ */
+struct ParserState {
+    ondemand::parser parser;
+    std::string input;
+    ondemand::document document;
+};
+
+ondemand::document& load(std::string_view text) {
+    thread_local ParserState state;
+    state.input.reserve(text.size() + simdjson::SIMDJSON_PADDING);
+    state.input.assign(text.data(), text.size());
+    check(state.parser.iterate(state.input.data(), state.input.size(), state.input.capacity())
+              .get(state.document));
+    return state.document;
+}
+
+ondemand::object rootObject(ondemand::document& document) {
+    if (typeOf(document) != json_type::object) {
+        fail("Expected a JSON object");
+    }
+    ondemand::object object;
+    check(document.get_object().get(object));
+    return object;
+}
+
+void expectEnd(ondemand::document& document) {
+    if (!document.at_end()) {
+        fail("Unexpected content after the JSON value");
+    }
+}
+
+template<typename T>
+T parseSingle(std::string_view text) {
+    ondemand::document& document = load(text);
+    ondemand::object object = rootObject(document);
+    T record;
+    readRecord(object, record);
+    expectEnd(document);
+    return record;
+}
+
+template<typename T>
+PaginationInfo parsePageWith(std::string_view text, std::vector<T>& out) {
+    ondemand::document& document = load(text);
+    ondemand::object root = rootObject(document);
+
+    PaginationInfo info;
+    bool sawInfo = false;
+    bool sawResults = false;
+    for (auto member : root) {
+        std::string_view key;
+        check(member.unescaped_key().get(key));
+        ondemand::value value;
+        check(member.value().get(value));
+
+        // Anything other than an "info" object or a "results" array is ignored
+        if (key == "info" && typeOf(value) == json_type::object) {
+            ondemand::object object;
+            check(value.get_object().get(object));
+            info = PaginationInfo{};
+            readRecord(object, info);
+            sawInfo = true;
+        } else if (key == "results" && typeOf(value) == json_type::array) {
+            ondemand::array list;
+            check(value.get_array().get(list));
+            readRecords(list, out);
+            sawResults = true;
+        }
+    }
+    expectEnd(document);
+
+    if (!sawInfo) {
+        fail("Missing field 'info'");
+    }
+    if (!sawResults) {
+        fail("Missing field 'results'");
+    }
+    return info;
+}
+
+} // namespace
+
+Character SimdjsonModelParser::parseCharacter(std::string_view json) {
+    return parseSingle<Character>(json);
+}
+
+Episode SimdjsonModelParser::parseEpisode(std::string_view json) {
+    return parseSingle<Episode>(json);
+}
+
+Location SimdjsonModelParser::parseLocation(std::string_view json) {
+    return parseSingle<Location>(json);
+}
+
+std::vector<Character> SimdjsonModelParser::parseCharacterList(std::string_view json) {
+    ondemand::document& document = load(json);
+    std::vector<Character> characters;
+    switch (typeOf(document)) {
+        case json_type::array: {
+            ondemand::array list;
+            check(document.get_array().get(list));
+            readRecords(list, characters);
+            break;
+        }
+        case json_type::object: {
+            ondemand::object object;
+            check(document.get_object().get(object));
+            readRecord(object, characters.emplace_back());
+            break;
+        }
+        default:
+            fail("Expected a JSON object or array");
+    }
+    expectEnd(document);
+    return characters;
+}
+
+PaginationInfo SimdjsonModelParser::parsePage(std::string_view json, std::vector<Episode>& out) {
+    return parsePageWith(json, out);
+}
+
+PaginationInfo SimdjsonModelParser::parsePage(std::string_view json, std::vector<Character>& out) {
+    return parsePageWith(json, out);
+}
+
+PaginationInfo SimdjsonModelParser::parsePage(std::string_view json, std::vector<Location>& out) {
+    return parsePageWith(json, out);
+}
+
+} // namespace rickmorty
@@ -0,0 +1,68 @@
+#include "StringPool.h"
+#include <mutex>
+
+namespace rickmorty {
+
+namespace {
+
+// Function-local so handles built during static initialization are safe
+const std::string* emptyString() {
+    static const std::string* empty = new std::string();
+    return empty;
+}
+
+} // namespace
+
+StringPool& StringPool::instance() {
+    static StringPool* pool = new StringPool();  // Never destroyed: handles may outlive statics
+    return *pool;
+}
+
+const std::string* StringPool::intern(std::string_view value) {
+    if (value.empty()) {
+        return emptyString();
+    }
+    {
+        std::shared_lock<std::shared_mutex> lock(mutex_);
+        auto it = index_.find(value);
+        if (it != index_.end()) {
+            return it->second;
+        }
+    }
+
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    auto it = index_.find(value);
+    if (it != index_.end()) {
+        return it->second;
+    }
+    const std::string& pooled = strings_.emplace_back(value);
+    index_.emplace(std::string_view(pooled), &pooled);
+    bytes_ += entryBytes(pooled);
+    return &pooled;
+}
+
+StringPool::Stats StringPool::stats() const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    Stats stats;
+    stats.strings = strings_.size();
+    stats.bytes = bytes_ + index_.bucket_count() * sizeof(void*);
+    return stats;
+}
+
+size_t StringPool::heapBytes(size_t length) {
+    static const size_t inlineCapacity = std::string().capacity();
+    return length > inlineCapacity ? length + 1 : 0;
+}
+
+size_t StringPool::entryBytes(const std::string& pooled) {
+    // Hash node: next pointer, key, value and cached hash
+    constexpr size_t NODE_BYTES = sizeof(void*) + sizeof(std::string_view) + sizeof(void*) + sizeof(size_t);
+    return sizeof(std::string) + heapBytes(pooled.size()) + NODE_BYTES;
+}
+
+InternedString::InternedString() : value_(emptyString()) {}
+
+InternedString::InternedString(std::string_view value)
+    : value_(StringPool::instance().intern(value)) {}
+
+} // namespace rickmorty
@@ -0,0 +1,108 @@
+#pragma once
+
+/**
+ * @file StringPool.h
+ * @brief Interning for the low-cardinality string fields of the models.
+ *
+ * Hundreds of characters share a handful of species, types and locations.
+ * Stored as InternedString, each distinct value exists once in the
+ * process-wide StringPool, and each field holds only a pointer to it.
+ */
+
+#include <cstddef>
+#include <deque>
+#include <ostream>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace rickmorty {
+
+/**
+ * @class StringPool
+ * @brief Thread-safe, append-only set of immutable strings.
+ *
+ * Pooled strings are never freed, so pointers into the pool stay valid for
+ * the life of the process. Only intern values drawn from a small set.
+ */
+class StringPool {
+public:
+    struct Stats {
+        size_t strings = 0;
+        size_t bytes = 0;   // Estimated footprint: strings plus index
+    };
+
+    static StringPool& instance();
+
+    /**
+     * @brief Returns the pooled copy of value, adding it on first use.
+     * Lookups take a shared lock and do not allocate.
+     */
+    const std::string* intern(std::string_view value);
+
+    Stats stats() const;
+
+    /// Heap bytes a std::string holding `length` characters allocates
+    static size_t heapBytes(size_t length);
+
+    /// Estimated bytes one pooled string costs: the string and its index entry
+    static size_t entryBytes(const std::string& pooled);
+
+private:
+    StringPool() = default;
+
+    mutable std::shared_mutex mutex_;
+    std::deque<std::string> strings_;  // deque: growth never moves elements
+    std::unordered_map<std::string_view, const std::string*> index_;
+    size_t bytes_ = 0;
+};
+
+/**
+ * @class InternedString
+ * @brief Handle to a StringPool entry: one pointer, free to copy.
+ *
+ * Converts implicitly to const std::string& so it reads like the
+ * std::string it replaces, and assigning any string interns it.
+ */
+class InternedString {
+public:
+    InternedString();
+    InternedString(std::string_view value);
+    InternedString(const std::string& value) : InternedString(std::string_view(value)) {}
+    InternedString(const char* value) : InternedString(std::string_view(value)) {}
+
+    const std::string& str() const { return *value_; }
+    std::string_view view() const { return *value_; }
+    const char* c_str() const { return value_->c_str(); }
+    bool empty() const { return value_->empty(); }
+    size_t size() const { return value_->size(); }
+
+    operator const std::string&() const { return *value_; }
+
+    /// The pooled string; equal values share one address
+    const std::string* pooled() const { return value_; }
+
+    friend bool operator==(const InternedString& a, const InternedString& b) { return a.value_ == b.value_; }
+    friend bool operator!=(const InternedString& a, const InternedString& b) { return a.value_ != b.value_; }
+    friend bool operator==(const InternedString& a, std::string_view b) { return a.view() == b; }
+    friend bool operator!=(const InternedString& a, std::string_view b) { return a.view() != b; }
+    friend bool operator==(const InternedString& a, const std::string& b) { return *a.value_ == b; }
+    friend bool operator!=(const InternedString& a, const std::string& b) { return *a.value_ != b; }
+    friend bool operator==(const InternedString& a, const char* b) { return a.view() == b; }
+    friend bool operator!=(const InternedString& a, const char* b) { return a.view() != b; }
+    friend bool operator==(std::string_view a, const InternedString& b) { return b == a; }
+    friend bool operator!=(std::string_view a, const InternedString& b) { return b != a; }
+    friend bool operator==(const std::string& a, const InternedString& b) { return b == a; }
+    friend bool operator!=(const std::string& a, const InternedString& b) { return b != a; }
+    friend bool operator==(const char* a, const InternedString& b) { return b == a; }
+    friend bool operator!=(const char* a, const InternedString& b) { return b != a; }
+    friend bool operator<(const InternedString& a, const InternedString& b) { return *a.value_ < *b.value_; }
+
+    friend std::ostream& operator<<(std::ostream& os, const InternedString& s) { return os << *s.value_; }
+
+private:
+    const std::string* value_;
+};
+
+} // namespace rickmorty
@@ -5,10 +5,15 @@
 #include <QDir>
 #include <QDirIterator>
 #include <QFontDatabase>
+#include <QStandardPaths>
 #include <memory>
 #include <glog/logging.h>
 
 #include "core/ApiClient.h"
+#include "core/CachingHttpClient.h"
+#include "core/CoalescingHttpClient.h"
+#include "core/CurlHttpClient.h"
+#include "core/RateLimitedHttpClient.h"
 #include "core/DataStore.h"
 #include "ui/QmlBridge.h"
 
@@ -84,13 +89,50 @@ int main(int argc, char *argv[])
     // Set the style
     QQuickStyle::setStyle("Basic");
 
-    // Create the backend components
-    auto apiClient = std::make_unique<rickmorty::ApiClient>();
+    // Create the backend components; responses are cached on disk and
+    // revalidated with conditional GETs on later runs, identical requests
+    // issued at the same time (e.g. rapid clicks) share one transfer, and
+    // everything that reaches the network is kept under the API rate limit
+    const QString httpCacheDir =
+        QStandardPaths::writableLocation(QStandardPaths::CacheLocation) + "/http";
+    auto cachingClient = std::make_unique<rickmorty::CachingHttpClient>(
+        std::make_unique<rickmorty::RateLimitedHttpClient>(
+            std::make_unique<rickmorty::CurlHttpClient>()),
+        httpCacheDir.toStdString());
+    rickmorty::CachingHttpClient* httpCache = cachingClient.get();
+    auto httpClient = std::make_unique<rickmorty::CoalescingHttpClient>(std::move(cachingClient));
+    auto apiClient = std::make_unique<rickmorty::ApiClient>(std::move(httpClient));
     auto dataStore = std::make_unique<rickmorty::DataStore>(std::move(apiClient));
 
     // Create the QML bridge
     QmlBridge bridge(dataStore.get());
 
+    // Kiosks with a memory limit pass --character-cache-mb=<N> to cap the
+    // character cache; the characters shown least recently are evicted. The
+    // HTTP cache's in-memory bodies get the same cap and are otherwise read
+    // back from disk.
+    const QString cacheBudgetOption = QStringLiteral("--character-cache-mb=");
+    for (const QString& argument : app.arguments()) {
+        if (!argument.startsWith(cacheBudgetOption)) {
+            continue;
+        }
+        bool ok = false;
+        const qulonglong megabytes = argument.mid(cacheBudgetOption.size()).toULongLong(&ok);
+        if (ok) {
+            dataStore->setCharacterCacheBudget(static_cast<size_t>(megabytes) * 1024 * 1024);
+            httpCache->setMemoryBudget(static_cast<size_t>(megabytes) * 1024 * 1024);
+            LOG(INFO) << "Character cache limited to " << megabytes << " MB";
+        } else {
+            LOG(WARNING) << "Ignoring malformed option " << argument.toStdString();
+        }
+    }
+
+    // Kiosk deployments pass --warmup to load the whole dataset in the
+    // background, so every episode selection is served from memory
+    if (app.arguments().contains(QStringLiteral("--warmup"))) {
+        dataStore->startWarmup();
+    }
+
     // Set up QML engine
     QQmlApplicationEngine engine;
 
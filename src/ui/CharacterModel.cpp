@@ -13,7 +13,7 @@ QVariant CharacterModel::data(const QModelIndex& index, int role) const {
         return QVariant();
     }
 
-    const auto& character = characters_.at(index.row());
+    const auto& character = *characters_.at(index.row());
 
     switch (role) {
         case IdRole:
@@ -41,9 +41,9 @@ QVariant CharacterModel::data(const QModelIndex& index, int role) const {
         case EpisodeCountRole:
             return static_cast<int>(character.episodeIds.size());
         case UrlRole:
-            return QString::fromStdString(character.url);
+            return QString::fromStdString(character.url());
         case CreatedRole:
-            return QString::fromStdString(character.created);
+            return QString::fromStdString(rickmorty::formatCreated(character.createdMs));
         default:
             return QVariant();
     }
@@ -68,9 +68,10 @@ QHash<int, QByteArray> CharacterModel::roleNames() const {
     };
 }
 
-void CharacterModel::setCharacters(const std::vector<rickmorty::Character>& characters) {
+void CharacterModel::setCharacters(const std::vector<rickmorty::CharacterPtr>& characters) {
     beginResetModel();
     characters_.clear();
+    characters_.reserve(static_cast<qsizetype>(characters.size()));
     for (const auto& ch : characters) {
         characters_.append(ch);
     }
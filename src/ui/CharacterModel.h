@@ -33,12 +33,12 @@ public:
     QHash<int, QByteArray> roleNames() const override;
 
 public slots:
-    void setCharacters(const std::vector<rickmorty::Character>& characters);
+    void setCharacters(const std::vector<rickmorty::CharacterPtr>& characters);
     void clear();
 
 signals:
     void countChanged();
 
 private:
-    QList<rickmorty::Character> characters_;
+    QList<rickmorty::CharacterPtr> characters_;
 };
@@ -31,9 +31,9 @@ QVariant EpisodeModel::data(const QModelIndex& index, int role) const {
         case EpisodeNumberRole:
             return episode.episodeNumber;
         case UrlRole:
-            return QString::fromStdString(episode.url);
+            return QString::fromStdString(episode.url());
         case CreatedRole:
-            return QString::fromStdString(episode.created);
+            return QString::fromStdString(rickmorty::formatCreated(episode.createdMs));
         default:
             return QVariant();
     }
@@ -28,6 +28,10 @@ void QmlBridge::loadCharactersForEpisode(int episodeId) {
     LOG(INFO) << "[TRACE] QmlBridge::loadCharactersForEpisode called for episode " << episodeId
               << " (previous selectedEpisodeId_: " << selectedEpisodeId_ << ")";
     selectedEpisodeId_ = episodeId;
+    // The previous selection's fetch stops at its next request unless this
+    // selection needs the same episode and joins it
+    selectedEpisodeLoad_.cancel();
+    selectedEpisodeLoad_ = rickmorty::CancellationToken();
 
     auto episode = dataStore_->getEpisode(episodeId);
     if (episode) {
@@ -39,9 +43,9 @@ void QmlBridge::loadCharactersForEpisode(int episodeId) {
     }
 
     LOG(INFO) << "[TRACE] Queueing thread pool task for episode " << episodeId;
-    QThreadPool::globalInstance()->start([this, episodeId]() {
+    QThreadPool::globalInstance()->start([this, episodeId, token = selectedEpisodeLoad_]() {
         LOG(INFO) << "[TRACE] Thread pool task STARTING for episode " << episodeId;
-        dataStore_->loadCharactersForEpisode(episodeId);
+        dataStore_->loadCharactersForEpisode(episodeId, token);
         LOG(INFO) << "[TRACE] Thread pool task FINISHED for episode " << episodeId;
     });
 }
@@ -56,10 +60,11 @@ void QmlBridge::onEpisodesLoaded(const std::vector<rickmorty::Episode>& episodes
     }, Qt::QueuedConnection);
 }
 
-void QmlBridge::onCharactersLoaded(int episodeId, const std::vector<rickmorty::Character>& characters) {
+void QmlBridge::onCharactersLoaded(int episodeId, const std::vector<rickmorty::CharacterPtr>& characters) {
     LOG(INFO) << "[TRACE] onCharactersLoaded CALLED on thread, episodeId=" << episodeId
               << ", characters.size()=" << characters.size()
               << ", selectedEpisodeId_=" << selectedEpisodeId_;
+    // Copies handles only; the records are shared with the DataStore
     QMetaObject::invokeMethod(this, [this, episodeId, characters]() {
         LOG(INFO) << "[TRACE] onCharactersLoaded UI CALLBACK, episodeId=" << episodeId
                   << ", selectedEpisodeId_=" << selectedEpisodeId_;
@@ -97,6 +102,24 @@ void QmlBridge::onError(const std::string& message) {
     }, Qt::QueuedConnection);
 }
 
+void QmlBridge::onWarmupProgress(const rickmorty::WarmupProgress& progress) {
+    using Stage = rickmorty::WarmupProgress::Stage;
+    // Each of the three stages covers a third of the bar
+    int percent = 100;
+    if (progress.stage != Stage::Done) {
+        const double fraction = progress.total > 0
+            ? static_cast<double>(progress.loaded) / static_cast<double>(progress.total) : 0.0;
+        percent = static_cast<int>((static_cast<int>(progress.stage) + fraction) * 100.0 / 3.0);
+    }
+    QMetaObject::invokeMethod(this, [this, percent]() {
+        if (warmupPercent_ != percent) {
+            warmupPercent_ = percent;
+            emit warmupProgressChanged();
+            emit cachedCharacterCountChanged();
+        }
+    }, Qt::QueuedConnection);
+}
+
 int QmlBridge::cachedCharacterCount() const {
     return static_cast<int>(dataStore_->getCachedCharacterCount());
 }
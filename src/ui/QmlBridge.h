@@ -18,6 +18,7 @@ class QmlBridge : public QObject, public rickmorty::IDataObserver {
     Q_PROPERTY(CharacterModel* characterModel READ characterModel CONSTANT)
     Q_PROPERTY(int cachedCharacterCount READ cachedCharacterCount NOTIFY cachedCharacterCountChanged)
     Q_PROPERTY(QVariantMap randomCharacter READ randomCharacter NOTIFY randomCharacterChanged)
+    Q_PROPERTY(int warmupPercent READ warmupPercent NOTIFY warmupProgressChanged)
 
 public:
     explicit QmlBridge(rickmorty::DataStore* dataStore, QObject* parent = nullptr);
@@ -31,6 +32,7 @@ public:
     CharacterModel* characterModel() { return &characterModel_; }
     int cachedCharacterCount() const;
     QVariantMap randomCharacter() const { return randomCharacter_; }
+    int warmupPercent() const { return warmupPercent_; }
 
     Q_INVOKABLE void loadEpisodes();
     Q_INVOKABLE void loadCharactersForEpisode(int episodeId);
@@ -38,9 +40,10 @@ public:
 
     // IDataObserver implementation
     void onEpisodesLoaded(const std::vector<rickmorty::Episode>& episodes) override;
-    void onCharactersLoaded(int episodeId, const std::vector<rickmorty::Character>& characters) override;
+    void onCharactersLoaded(int episodeId, const std::vector<rickmorty::CharacterPtr>& characters) override;
     void onLoadingStateChanged(bool isLoading) override;
     void onError(const std::string& message) override;
+    void onWarmupProgress(const rickmorty::WarmupProgress& progress) override;
 
 signals:
     void episodesReady();
@@ -50,6 +53,7 @@ signals:
     void selectedEpisodeChanged();
     void cachedCharacterCountChanged();
     void randomCharacterChanged();
+    void warmupProgressChanged();
 
 private:
     void updateRandomCharacter();
@@ -62,5 +66,7 @@ private:
     QString errorMessage_;
     QString selectedEpisodeName_;
     int selectedEpisodeId_ = -1;
+    rickmorty::CancellationToken selectedEpisodeLoad_;   // Cancelled when another episode is selected
     QVariantMap randomCharacter_;
+    int warmupPercent_ = 0;
 };
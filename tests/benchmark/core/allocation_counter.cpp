@@ -0,0 +1,64 @@
+#include "allocation_counter.h"
+#include <cstdlib>
+#include <new>
+
+namespace {
+
+thread_local bool trackAllocations = false;
+thread_local rickmorty::testing::AllocationCounts counts;
+
+} // namespace
+
+// Replacement operators pair malloc/free themselves; GCC cannot see that when inlining
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+
+void* operator new(std::size_t size) {
+    if (trackAllocations) {
+        ++counts.allocations;
+        counts.bytes += size;
+    }
+    if (void* p = std::malloc(size ? size : 1)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size) {
+    return ::operator new(size);
+}
+
+void operator delete(void* p) noexcept {
+    std::free(p);
+}
+
+void operator delete[](void* p) noexcept {
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept {
+    std::free(p);
+}
+
+void operator delete[](void* p, std::size_t) noexcept {
+    std::free(p);
+}
+
+namespace rickmorty {
+namespace testing {
+
+void resetAllocationCounts() {
+    counts = AllocationCounts{};
+}
+
+void countAllocations(bool enabled) {
+    trackAllocations = enabled;
+}
+
+AllocationCounts allocationCounts() {
+    return counts;
+}
+
+} // namespace testing
+} // namespace rickmorty
@@ -0,0 +1,30 @@
+#pragma once
+
+#include <cstddef>
+
+namespace rickmorty {
+namespace testing {
+
+/**
+ * @brief operator new calls made by the current thread while counting is on.
+ *
+ * allocation_counter.cpp replaces the global operator new/delete for the
+ * whole benchmark binary; counting costs one thread-local check per
+ * allocation when it is off.
+ */
+struct AllocationCounts {
+    size_t allocations = 0;
+    size_t bytes = 0;
+};
+
+/// Zeroes this thread's counts
+void resetAllocationCounts();
+
+/// Starts or stops counting this thread's allocations
+void countAllocations(bool enabled);
+
+/// This thread's counts since the last reset
+AllocationCounts allocationCounts();
+
+} // namespace testing
+} // namespace rickmorty
@@ -0,0 +1,222 @@
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "core/CharacterTable.h"
+#include "core/Models.h"
+
+namespace rickmorty {
+namespace {
+
+// The former DataStore::characterCache_
+using CharacterMap = std::unordered_map<int, Character>;
+
+// `count` characters with API-like spreads of status and species, and
+// names from a few thousand "First Last N" combinations
+std::vector<Character> syntheticCharacters(int count) {
+    static const char* const firstNames[] = {"Rick", "Morty", "Summer", "Beth", "Jerry", "Birdperson",
+                                             "Squanchy", "Mr. Poopybutthole", "Abradolf", "Unity"};
+    static const char* const lastNames[] = {"Sanchez", "Smith", "Lincler", "Goldenfold", "Meeseeks",
+                                            "Tammy", "Gazorpazorp", "Krombopulos", "Cronenberg"};
+    static const char* const species[] = {"Human", "Alien", "Humanoid", "Robot", "Animal",
+                                          "Mythological Creature", "Cronenberg", "Disease"};
+    static const CharacterStatus statuses[] = {CharacterStatus::Alive, CharacterStatus::Dead,
+                                               CharacterStatus::Unknown};
+
+    std::mt19937 gen(826);
+    std::vector<Character> characters(static_cast<size_t>(count));
+    for (int i = 0; i < count; ++i) {
+        Character& c = characters[static_cast<size_t>(i)];
+        c.id = i + 1;
+        c.name = std::string(firstNames[gen() % 10]) + " " + lastNames[gen() % 9] + " " + std::to_string(gen() % 1000);
+        c.status = statuses[gen() % 3];
+        c.species = species[gen() % 8];
+        c.gender = static_cast<Gender>(gen() % 4);
+        c.origin.name = "Earth (C-137)";
+        c.origin.id = 1;
+        c.location.name = "Citadel of Ricks";
+        c.location.id = 3;
+        c.imageUrl = "https://rickandmortyapi.com/api/character/avatar/" + std::to_string(c.id) + ".jpeg";
+        c.episodeIds = {1, 2, 3};
+    }
+    return characters;
+}
+
+struct MapStore {
+    CharacterMap characters;
+
+    explicit MapStore(int count) {
+        for (auto& c : syntheticCharacters(count)) {
+            characters[c.id] = std::move(c);
+        }
+    }
+};
+
+struct TableStore {
+    CharacterTable characters;
+
+    explicit TableStore(int count) {
+        for (auto& c : syntheticCharacters(count)) {
+            characters.upsert(std::move(c));
+        }
+    }
+};
+
+/**
+ * Counts living characters: a full scan that reads one field per record.
+ * Args: {characters}.
+ */
+template<typename Store>
+void BM_CountByStatus(benchmark::State& state);
+
+template<>
+void BM_CountByStatus<MapStore>(benchmark::State& state) {
+    const MapStore store(static_cast<int>(state.range(0)));
+    for (auto _ : state) {
+        size_t alive = 0;
+        for (const auto& [id, c] : store.characters) {
+            alive += c.status == CharacterStatus::Alive;
+        }
+        benchmark::DoNotOptimize(alive);
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+
+template<>
+void BM_CountByStatus<TableStore>(benchmark::State& state) {
+    const TableStore store(static_cast<int>(state.range(0)));
+    for (auto _ : state) {
+        size_t alive = 0;
+        for (CharacterTable::Row row = 0; row < store.characters.size(); ++row) {
+            alive += store.characters.status(row) == CharacterStatus::Alive;
+        }
+        benchmark::DoNotOptimize(alive);
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+
+/**
+ * Ids of every dead character, and of every Alien. The map compares
+ * interned species by address, so both sides skip string comparisons.
+ */
+template<typename Store>
+void BM_FilterByStatus(benchmark::State& state);
+
+template<>
+void BM_FilterByStatus<MapStore>(benchmark::State& state) {
+    const MapStore store(static_cast<int>(state.range(0)));
+    for (auto _ : state) {
+        std::vector<int> ids;
+        for (const auto& [id, c] : store.characters) {
+            if (c.status == CharacterStatus::Dead) {
+                ids.push_back(id);
+            }
+        }
+        benchmark::DoNotOptimize(ids.data());
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+
+template<>
+void BM_FilterByStatus<TableStore>(benchmark::State& state) {
+    const TableStore store(static_cast<int>(state.range(0)));
+    for (auto _ : state) {
+        auto rows = store.characters.rowsWithStatus(CharacterStatus::Dead);
+        benchmark::DoNotOptimize(rows.data());
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+
+template<typename Store>
+void BM_FilterBySpecies(benchmark::State& state);
+
+template<>
+void BM_FilterBySpecies<MapStore>(benchmark::State& state) {
+    const MapStore store(static_cast<int>(state.range(0)));
+    const InternedString alien("Alien");
+    for (auto _ : state) {
+        std::vector<int> ids;
+        for (const auto& [id, c] : store.characters) {
+            if (c.species == alien) {
+                ids.push_back(id);
+            }
+        }
+        benchmark::DoNotOptimize(ids.data());
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+
+template<>
+void BM_FilterBySpecies<TableStore>(benchmark::State& state) {
+    const TableStore store(static_cast<int>(state.range(0)));
+    for (auto _ : state) {
+        auto rows = store.characters.rowsWithSpecies("Alien");
+        benchmark::DoNotOptimize(rows.data());
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+
+/**
+ * Every character ordered by name, as handles: pointers into the map's
+ * nodes, or row numbers sorted on the table's name column.
+ */
+template<typename Store>
+void BM_SortByName(benchmark::State& state);
+
+template<>
+void BM_SortByName<MapStore>(benchmark::State& state) {
+    const MapStore store(static_cast<int>(state.range(0)));
+    for (auto _ : state) {
+        std::vector<const Character*> sorted;
+        sorted.reserve(store.characters.size());
+        for (const auto& [id, c] : store.characters) {
+            sorted.push_back(&c);
+        }
+        std::sort(sorted.begin(), sorted.end(), [](const Character* a, const Character* b) { return *a < *b; });
+        benchmark::DoNotOptimize(sorted.data());
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+
+template<>
+void BM_SortByName<TableStore>(benchmark::State& state) {
+    const TableStore store(static_cast<int>(state.range(0)));
+    for (auto _ : state) {
+        auto rows = store.characters.rowsSortedByName();
+        benchmark::DoNotOptimize(rows.data());
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+
+/**
+ * The table's first sort after a rename, which rebuilds its name order.
+ * BM_SortByName<TableStore> is the steady state of a cache read more often
+ * than it changes.
+ */
+void BM_SortByNameAfterRename(benchmark::State& state) {
+    TableStore store(static_cast<int>(state.range(0)));
+    Character renamed = store.characters.record(0);
+    int generation = 0;
+    for (auto _ : state) {
+        renamed.name = "Renamed " + std::to_string(++generation);
+        store.characters.upsert(renamed);
+        auto rows = store.characters.rowsSortedByName();
+        benchmark::DoNotOptimize(rows.data());
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+BENCHMARK(BM_SortByNameAfterRename)->ArgName("characters")->Arg(10000)->Arg(100000);
+
+#define CHARACTER_STORE_BENCHMARK(name)                                                    \
+    BENCHMARK_TEMPLATE(name, MapStore)->ArgName("characters")->Arg(10000)->Arg(100000);   \
+    BENCHMARK_TEMPLATE(name, TableStore)->ArgName("characters")->Arg(10000)->Arg(100000)
+
+CHARACTER_STORE_BENCHMARK(BM_CountByStatus);
+CHARACTER_STORE_BENCHMARK(BM_FilterByStatus);
+CHARACTER_STORE_BENCHMARK(BM_FilterBySpecies);
+CHARACTER_STORE_BENCHMARK(BM_SortByName);
+
+} // namespace
+} // namespace rickmorty
@@ -0,0 +1,300 @@
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include "allocation_counter.h"
+#include "core/DataStore.h"
+#include "fakes/FakeHttpClient.h"
+#include "fakes/SyntheticApiData.h"
+
+namespace rickmorty {
+namespace {
+
+using testing::FakeHttpClient;
+
+// A DataStore with `episodeCount` synthetic episodes loaded
+std::unique_ptr<DataStore> storeWithEpisodes(int episodeCount) {
+    auto fake = std::make_unique<FakeHttpClient>();
+    fake->routePatternWithHandler("/api/episode", [episodeCount](const std::string& url) {
+        return testing::syntheticEpisodePageJson(testing::pageFromUrl(url), episodeCount);
+    });
+    auto store = std::make_unique<DataStore>(std::make_unique<ApiClient>(std::move(fake)));
+    store->loadAllEpisodes();
+    return store;
+}
+
+// A warmed-up DataStore shared by the threads of one benchmark run, with an
+// optional writer that keeps warming it up again so that new versions are
+// published while the readers run
+class SharedStore {
+public:
+    explicit SharedStore(bool withWriter) {
+        auto fake = std::make_unique<FakeHttpClient>();
+        fake->routePatternWithHandler("/api/episode", [](const std::string& url) {
+                return testing::syntheticEpisodePageJson(testing::pageFromUrl(url), 51);
+            })
+            .routePatternWithHandler("/api/character\\?|/api/character$", [](const std::string& url) {
+                return testing::syntheticCharacterPageJson(testing::pageFromUrl(url), 826);
+            })
+            .routePatternWithHandler("/api/location", [](const std::string& url) {
+                return testing::syntheticLocationPageJson(testing::pageFromUrl(url), 126);
+            });
+        store_ = std::make_unique<DataStore>(std::make_unique<ApiClient>(std::move(fake)));
+        store_->warmUp();
+        firstVersion_ = store_->snapshot()->version();
+        if (withWriter) {
+            writer_ = std::thread([this]() {
+                while (!stop_) {
+                    store_->warmUp();
+                }
+            });
+        }
+    }
+
+    ~SharedStore() {
+        stop_ = true;
+        if (writer_.joinable()) {
+            writer_.join();
+        }
+    }
+
+    DataStore& store() { return *store_; }
+    uint64_t versionsPublished() const { return store_->snapshot()->version() - firstVersion_; }
+
+private:
+    std::unique_ptr<DataStore> store_;
+    uint64_t firstVersion_ = 0;
+    std::atomic<bool> stop_{false};
+    std::thread writer_;
+};
+
+std::unique_ptr<SharedStore> sharedStore;
+std::mutex readMutex;   // Only for the locked baseline
+
+template <bool Locked>
+void concurrentReads(benchmark::State& state) {
+    if (state.thread_index() == 0) {
+        sharedStore = std::make_unique<SharedStore>(state.range(0) != 0);
+    }
+    int id = state.thread_index() * 97;
+    for (auto _ : state) {
+        id = id % 826 + 1;
+        std::unique_lock<std::mutex> lock(readMutex, std::defer_lock);
+        if (Locked) {
+            lock.lock();
+        }
+        auto character = sharedStore->store().getCharacter(id);
+        auto episode = sharedStore->store().getEpisode(id % 51 + 1);
+        benchmark::DoNotOptimize(character);
+        benchmark::DoNotOptimize(episode);
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * 2);
+    if (state.thread_index() == 0) {
+        state.counters["versions"] = static_cast<double>(sharedStore->versionsPublished());
+        sharedStore.reset();
+    }
+}
+
+/**
+ * getCharacter plus getEpisode from several threads at once, optionally
+ * while a writer republishes the whole dataset in a loop. Readers load the
+ * current snapshot and never wait for each other or for the writer, so
+ * items/s should grow with the thread count up to the number of cores.
+ * The Locked variant funnels the same reads through one mutex, as every
+ * getter did before snapshots, for comparison. "versions" counts the
+ * snapshots the writer published during the run. Args: {writer}.
+ */
+void BM_ConcurrentReads(benchmark::State& state) {
+    concurrentReads<false>(state);
+}
+BENCHMARK(BM_ConcurrentReads)->ArgName("writer")->Arg(0)->Arg(1)->Threads(1)->Threads(2)->Threads(4)->Threads(8)->UseRealTime();
+
+void BM_ConcurrentReadsLocked(benchmark::State& state) {
+    concurrentReads<true>(state);
+}
+BENCHMARK(BM_ConcurrentReadsLocked)->ArgName("writer")->Arg(0)->Arg(1)->Threads(1)->Threads(2)->Threads(4)->Threads(8)->UseRealTime();
+
+/**
+ * The write path under a full character cache. The store is warmed up with
+ * `characters` synthetic characters and enough episodes to cast them all,
+ * then held to 90% of their bytes. Walking the episodes, each selection
+ * whose cast was evicted fetches it, publishes it and evicts about as
+ * much, and both writes rebuild the table's name order: the rows that
+ * changed are merged into the previous order rather than the table being
+ * re-sorted. "versions" and "evictions" are per selection.
+ * Args: {characters}.
+ */
+void BM_SelectionEvictingCachedCharacters(benchmark::State& state) {
+    const int characterCount = static_cast<int>(state.range(0));
+    const int episodeCount = characterCount / 7;   // Casts advance by 7 ids per episode
+    auto fake = std::make_unique<FakeHttpClient>();
+    fake->routePatternWithHandler("/api/episode", [episodeCount, characterCount](const std::string& url) {
+            return testing::syntheticEpisodePageJson(testing::pageFromUrl(url), episodeCount, 20, 20,
+                                                     characterCount);
+        })
+        .routePatternWithHandler("/api/character\\?|/api/character$", [characterCount](const std::string& url) {
+            return testing::syntheticCharacterPageJson(testing::pageFromUrl(url), characterCount);
+        })
+        .routePatternWithHandler("/api/character/", [](const std::string& url) {
+            return testing::syntheticCharacterListJson(testing::idsFromUrl(url));
+        })
+        .routePatternWithHandler("/api/location", [](const std::string& url) {
+            return testing::syntheticLocationPageJson(testing::pageFromUrl(url), 126);
+        });
+    DataStore store(std::make_unique<ApiClient>(std::move(fake)));
+    store.warmUp();
+    store.setCharacterCacheBudget(store.getCharacterCacheStats().residentBytes / 10 * 9);
+    const uint64_t firstVersion = store.snapshot()->version();
+    const size_t firstEvictions = store.getCharacterCacheStats().evictions;
+
+    int episodeId = 0;
+    for (auto _ : state) {
+        episodeId = episodeId % episodeCount + 1;
+        store.loadCharactersForEpisode(episodeId);
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+    state.counters["versions"] = benchmark::Counter(static_cast<double>(store.snapshot()->version() - firstVersion),
+                                                    benchmark::Counter::kAvgIterations);
+    state.counters["evictions"] = benchmark::Counter(
+        static_cast<double>(store.getCharacterCacheStats().evictions - firstEvictions),
+        benchmark::Counter::kAvgIterations);
+}
+BENCHMARK(BM_SelectionEvictingCachedCharacters)->ArgName("characters")->Arg(826)->Arg(10000);
+
+// What selecting an episode does with its cast: DataStore builds the list,
+// QmlBridge captures it for the UI thread and CharacterModel keeps its own.
+// `toList` turns the handles DataStore returns into the list type passed on.
+template<typename ToList>
+void runEpisodeSelection(benchmark::State& state, ToList toList) {
+    SharedStore shared(false);
+    int episodeId = 0;
+    size_t castSize = 0;
+
+    testing::resetAllocationCounts();
+    for (auto _ : state) {
+        episodeId = episodeId % 51 + 1;
+        testing::countAllocations(true);
+        auto selected = toList(shared.store().getCharactersForEpisode(episodeId));
+        auto captured = selected;
+        auto model = captured;
+        testing::countAllocations(false);
+        castSize += model.size();
+        benchmark::DoNotOptimize(model.data());
+    }
+
+    const double iterations = static_cast<double>(state.iterations());
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+    state.counters["cast"] = static_cast<double>(castSize) / iterations;
+    state.counters["allocs"] = static_cast<double>(testing::allocationCounts().allocations) / iterations;
+    state.counters["alloc_bytes"] = static_cast<double>(testing::allocationCounts().bytes) / iterations;
+}
+
+/**
+ * Selecting each episode of a warmed-up store in turn, passing the cast on
+ * as shared handles: every step after the lookup copies pointers, so the
+ * allocations are one vector per step whatever the characters hold.
+ */
+void BM_EpisodeSelection(benchmark::State& state) {
+    runEpisodeSelection(state, [](std::vector<CharacterPtr> cast) { return cast; });
+}
+BENCHMARK(BM_EpisodeSelection);
+
+/**
+ * The same steps with each step holding its own Character copies, as they
+ * did before handles: every name, URL, type string and episode list is
+ * copied three times per selection.
+ */
+void BM_EpisodeSelectionDeepCopy(benchmark::State& state) {
+    runEpisodeSelection(state, [](const std::vector<CharacterPtr>& cast) {
+        std::vector<Character> copies;
+        copies.reserve(cast.size());
+        for (const auto& character : cast) {
+            copies.push_back(*character);
+        }
+        return copies;
+    });
+}
+BENCHMARK(BM_EpisodeSelectionDeepCopy);
+
+/**
+ * getEpisode for ids spread over the whole season list. Lookups go through
+ * DataStore's id index, so the cost per call stays flat as the episode
+ * count grows. Args: {episodes}.
+ */
+void BM_GetEpisode(benchmark::State& state) {
+    const int episodeCount = static_cast<int>(state.range(0));
+    const auto store = storeWithEpisodes(episodeCount);
+    int id = 0;
+    for (auto _ : state) {
+        id = id % episodeCount + 1;
+        auto episode = store->getEpisode(id);
+        benchmark::DoNotOptimize(episode);
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+}
+BENCHMARK(BM_GetEpisode)->ArgName("episodes")->Arg(51)->Arg(500)->Arg(5000);
+
+/**
+ * The std::find_if over the episode list that the index replaced, on the
+ * same data, for comparison.
+ */
+void BM_FindEpisodeLinear(benchmark::State& state) {
+    const int episodeCount = static_cast<int>(state.range(0));
+    const std::vector<Episode> episodes = storeWithEpisodes(episodeCount)->getEpisodes();
+    int id = 0;
+    for (auto _ : state) {
+        id = id % episodeCount + 1;
+        auto it = std::find_if(episodes.begin(), episodes.end(), [id](const Episode& e) { return e.id == id; });
+        std::optional<Episode> episode;
+        if (it != episodes.end()) {
+            episode = *it;
+        }
+        benchmark::DoNotOptimize(episode);
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+}
+BENCHMARK(BM_FindEpisodeLinear)->ArgName("episodes")->Arg(51)->Arg(500)->Arg(5000);
+
+/**
+ * Which episodes does a character appear in, with only the episodes
+ * loaded: the reverse index, against scanning every Episode::characterIds.
+ * Synthetic casts spread over 826 characters, so the number of matching
+ * episodes (the "found" counter) grows with the episode count; the index
+ * pays only for those.
+ */
+void BM_EpisodesForCharacter(benchmark::State& state) {
+    const auto store = storeWithEpisodes(static_cast<int>(state.range(0)));
+    int id = 0;
+    size_t found = 0;
+    for (auto _ : state) {
+        id = id % 826 + 1;
+        auto episodes = store->getEpisodesForCharacter(id);
+        found += episodes.size();
+        benchmark::DoNotOptimize(episodes.data());
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+    state.counters["found"] = static_cast<double>(found) / static_cast<double>(state.iterations());
+}
+BENCHMARK(BM_EpisodesForCharacter)->ArgName("episodes")->Arg(51)->Arg(500)->Arg(5000);
+
+void BM_EpisodesForCharacterScan(benchmark::State& state) {
+    const std::vector<Episode> episodes = storeWithEpisodes(static_cast<int>(state.range(0)))->getEpisodes();
+    int id = 0;
+    for (auto _ : state) {
+        id = id % 826 + 1;
+        std::vector<Episode> found;
+        for (const auto& episode : episodes) {
+            if (std::find(episode.characterIds.begin(), episode.characterIds.end(), id) != episode.characterIds.end()) {
+                found.push_back(episode);
+            }
+        }
+        benchmark::DoNotOptimize(found.data());
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+}
+BENCHMARK(BM_EpisodesForCharacterScan)->ArgName("episodes")->Arg(51)->Arg(500)->Arg(5000);
+
+} // namespace
+} // namespace rickmorty
@@ -0,0 +1,111 @@
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "core/CurlHttpClient.h"
+
+namespace rickmorty {
+namespace {
+
+/**
+ * HTTP/1.1 vs HTTP/2 for a burst of parallel getAsync() requests.
+ *
+ * Needs a local TLS stand-in server that offers both protocols via ALPN:
+ *   RICKMORTY_BENCH_TLS_URL    URL to request, e.g. https://localhost:8443/characters/character_batch.json
+ *   RICKMORTY_BENCH_CA_BUNDLE  PEM file that signs the server certificate (optional)
+ * The benchmark is skipped when RICKMORTY_BENCH_TLS_URL is not set.
+ *
+ * Each request in a burst gets its own query string, so the server and any
+ * cache in between see distinct resources rather than one URL repeated.
+ *
+ * Args: {HTTP version (1 or 2), parallel requests}. Besides wall time per
+ * burst it reports how many connections were opened and the spread between
+ * the first and last completion: with HTTP/1.1 a burst is spread over many
+ * connections, with HTTP/2 all streams share one, so the counters show
+ * whether one slow response holds the others back.
+ */
+void BM_ParallelBurst(benchmark::State& state) {
+    const char* url = std::getenv("RICKMORTY_BENCH_TLS_URL");
+    if (!url || !*url) {
+        state.SkipWithError("RICKMORTY_BENCH_TLS_URL is not set; point it at a local TLS server "
+                            "offering h2 and http/1.1 to run this benchmark");
+        return;
+    }
+    const std::string base(url);
+    const char separator = base.find('?') == std::string::npos ? '?' : '&';
+
+    const bool http2 = state.range(0) == 2;
+    const int parallel = static_cast<int>(state.range(1));
+
+    CurlHttpClient client;
+    if (const char* caBundle = std::getenv("RICKMORTY_BENCH_CA_BUNDLE")) {
+        client.setCaBundlePath(caBundle);
+    }
+    if (client.setHttp2Enabled(http2) != http2) {
+        state.SkipWithError("libcurl has no HTTP/2 support");
+        return;
+    }
+
+    // Warm up once so the TLS handshake is not part of the measurement
+    client.get(base);
+
+    std::vector<std::string> urls;
+    for (int i = 0; i < parallel; ++i) {
+        urls.push_back(base + separator + "request=" + std::to_string(i));
+    }
+
+    using Clock = std::chrono::steady_clock;
+    double spreadMs = 0;
+    const auto before = client.connectionStats();
+
+    for (auto _ : state) {
+        std::mutex mutex;
+        std::vector<Clock::time_point> finished;
+        std::vector<std::future<void>> done;
+        done.reserve(parallel);
+
+        for (int i = 0; i < parallel; ++i) {
+            auto promise = std::make_shared<std::promise<void>>();
+            done.push_back(promise->get_future());
+            client.getAsync(urls[i], [&, promise](std::string body, std::exception_ptr error) {
+                benchmark::DoNotOptimize(body.data());
+                {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    finished.push_back(Clock::now());
+                }
+                if (error) {
+                    promise->set_exception(error);
+                } else {
+                    promise->set_value();
+                }
+            });
+        }
+        for (auto& f : done) {
+            f.get();
+        }
+
+        auto [first, last] = std::minmax_element(finished.begin(), finished.end());
+        spreadMs += std::chrono::duration<double, std::milli>(*last - *first).count();
+    }
+
+    const auto after = client.connectionStats();
+    state.counters["new_connections"] = benchmark::Counter(
+        static_cast<double>(after.newConnections - before.newConnections),
+        benchmark::Counter::kAvgIterations);
+    state.counters["completion_spread_ms"] = benchmark::Counter(
+        spreadMs, benchmark::Counter::kAvgIterations);
+    state.counters["http2_responses"] = benchmark::Counter(
+        static_cast<double>(after.http2Responses - before.http2Responses),
+        benchmark::Counter::kAvgIterations);
+}
+BENCHMARK(BM_ParallelBurst)
+    ->ArgNames({"http", "parallel"})
+    ->ArgsProduct({{1, 2}, {6, 24}})
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+
+} // namespace
+} // namespace rickmorty
@@ -0,0 +1,108 @@
+#include <benchmark/benchmark.h>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <nlohmann/json.hpp>
+#include "allocation_counter.h"
+#include "core/ModelParser.h"
+#include "fakes/SyntheticApiData.h"
+
+namespace rickmorty {
+namespace {
+
+using json = nlohmann::json;
+
+// characters/character_batch.json with its records repeated `copies` times
+std::string scaledCharacterBatch(int copies) {
+    std::ifstream file(std::string(RICKMORTY_FIXTURE_DIR) + "/characters/character_batch.json");
+    std::stringstream contents;
+    contents << file.rdbuf();
+    const json batch = json::parse(contents.str());
+
+    json scaled = json::array();
+    for (int i = 0; i < copies; ++i) {
+        for (const auto& character : batch) {
+            scaled.push_back(character);
+        }
+    }
+    return scaled.dump();
+}
+
+template<typename Parse>
+void runParseBenchmark(benchmark::State& state, Parse parse) {
+    const std::string text = scaledCharacterBatch(static_cast<int>(state.range(0)));
+    size_t characters = 0;
+
+    testing::resetAllocationCounts();
+    for (auto _ : state) {
+        testing::countAllocations(true);
+        auto result = parse(text);
+        testing::countAllocations(false);
+        characters = result.size();
+        benchmark::DoNotOptimize(result.data());
+    }
+
+    const double iterations = static_cast<double>(state.iterations());
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(text.size()));
+    state.counters["GB"] = benchmark::Counter(iterations * static_cast<double>(text.size()) / 1e9,
+                                              benchmark::Counter::kIsRate);
+    state.counters["characters"] = static_cast<double>(characters);
+    state.counters["allocs"] = static_cast<double>(testing::allocationCounts().allocations) / iterations;
+    state.counters["alloc_bytes"] = static_cast<double>(testing::allocationCounts().bytes) / iterations;
+}
+
+/**
+ * The former ApiClient path: build a nlohmann::json DOM, then convert it
+ * through the from_json overloads in Models.h.
+ *
+ * Args: {copies of character_batch.json's records}. Counters report
+ * operator new calls and bytes requested per parse.
+ */
+void BM_ParseCharactersDom(benchmark::State& state) {
+    runParseBenchmark(state, [](const std::string& text) {
+        return json::parse(text).get<std::vector<Character>>();
+    });
+}
+BENCHMARK(BM_ParseCharactersDom)->ArgName("copies")->Arg(1)->Arg(64)->Arg(512);
+
+/**
+ * A ModelParser backend parsing the same arrays straight into the models.
+ * simdjson is only benchmarked when core was built with
+ * RICKMORTY_JSON_BACKEND=simdjson.
+ */
+template<typename Parser>
+void BM_ParseCharacters(benchmark::State& state) {
+    runParseBenchmark(state, [](const std::string& text) {
+        return Parser::parseCharacterList(text);
+    });
+}
+BENCHMARK_TEMPLATE(BM_ParseCharacters, NlohmannModelParser)->ArgName("copies")->Arg(1)->Arg(64)->Arg(512);
+#ifdef RICKMORTY_JSON_SIMDJSON
+BENCHMARK_TEMPLATE(BM_ParseCharacters, SimdjsonModelParser)->ArgName("copies")->Arg(1)->Arg(64)->Arg(512);
+#endif
+
+/**
+ * One 20-record page of /api/character, the shape every paginated fetch
+ * parses. Small documents show each backend's fixed per-call cost.
+ */
+template<typename Parser>
+void BM_ParseCharacterPage(benchmark::State& state) {
+    const std::string text = testing::syntheticCharacterPageJson(1, 826);
+    for (auto _ : state) {
+        std::vector<Character> characters;
+        PaginationInfo info = Parser::parsePage(text, characters);
+        benchmark::DoNotOptimize(info.count);
+        benchmark::DoNotOptimize(characters.data());
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(text.size()));
+    state.counters["GB"] = benchmark::Counter(
+        static_cast<double>(state.iterations()) * static_cast<double>(text.size()) / 1e9,
+        benchmark::Counter::kIsRate);
+}
+BENCHMARK_TEMPLATE(BM_ParseCharacterPage, NlohmannModelParser);
+#ifdef RICKMORTY_JSON_SIMDJSON
+BENCHMARK_TEMPLATE(BM_ParseCharacterPage, SimdjsonModelParser);
+#endif
+
+} // namespace
+} // namespace rickmorty
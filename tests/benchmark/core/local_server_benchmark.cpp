@@ -0,0 +1,136 @@
+#include <benchmark/benchmark.h>
+
+// LocalApiServer uses POSIX sockets
+#ifndef _WIN32
+
+#include <chrono>
+#include <vector>
+#include "core/ApiClient.h"
+#include "core/CurlHttpClient.h"
+#include "server/LocalApiServer.h"
+
+namespace rickmorty {
+namespace {
+
+using testing::LocalApiServer;
+
+/**
+ * fetchAllEpisodes through the real CurlHttpClient against the local
+ * stand-in server, i.e. the same measurement as BM_FetchAllPaginated but
+ * with sockets, keep-alive and HTTP parsing in the loop.
+ *
+ * Args: {page count, max concurrent requests, server latency in ms}.
+ * Counters report connections opened and bytes served per iteration.
+ */
+void BM_LocalServerFetchAllEpisodes(benchmark::State& state) {
+    const int pages = static_cast<int>(state.range(0));
+
+    LocalApiServer server;
+    server.addSyntheticEpisodes(pages * 20);
+    LocalApiServer::Behavior behavior;
+    behavior.latency = std::chrono::milliseconds(state.range(2));
+    server.setBehavior(behavior);
+
+    ApiClient client(std::make_unique<CurlHttpClient>());
+    client.setBaseUrl(server.baseUrl());
+    client.setMaxConcurrentRequests(static_cast<size_t>(state.range(1)));
+
+    for (auto _ : state) {
+        auto episodes = client.fetchAllEpisodes();
+        benchmark::DoNotOptimize(episodes.data());
+    }
+
+    const auto stats = server.stats();
+    state.counters["connections"] = benchmark::Counter(
+        static_cast<double>(stats.connections), benchmark::Counter::kAvgIterations);
+    state.counters["bytes_served"] = benchmark::Counter(
+        static_cast<double>(stats.bytesSent), benchmark::Counter::kAvgIterations);
+}
+BENCHMARK(BM_LocalServerFetchAllEpisodes)
+    ->ArgNames({"pages", "concurrency", "latency_ms"})
+    ->ArgsProduct({{3, 42}, {1, 6}, {0, 25}})
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+
+/**
+ * fetchCharacters for every character of a season-sized warmup, swept over
+ * the multi-get chunk size. The server adds a fixed latency and a bandwidth
+ * cap, so small chunks pay in round trips and large ones in transfer time
+ * that cannot overlap.
+ *
+ * Args: {ids per request}; 800 ids, 6 concurrent requests, 20 ms, 4 MB/s.
+ */
+void BM_LocalServerFetchCharactersChunked(benchmark::State& state) {
+    constexpr int CHARACTER_COUNT = 800;
+
+    LocalApiServer server;
+    server.addSyntheticCharacters(CHARACTER_COUNT);
+    LocalApiServer::Behavior behavior;
+    behavior.latency = std::chrono::milliseconds(20);
+    behavior.bandwidthBytesPerSecond = 4 * 1024 * 1024;
+    server.setBehavior(behavior);
+
+    ApiClient client(std::make_unique<CurlHttpClient>());
+    client.setBaseUrl(server.baseUrl());
+    client.setCharacterChunkSize(static_cast<size_t>(state.range(0)));
+
+    std::vector<int> ids;
+    for (int id = 1; id <= CHARACTER_COUNT; ++id) {
+        ids.push_back(id);
+    }
+
+    const uint64_t requestsBefore = server.stats().requests;
+    for (auto _ : state) {
+        auto characters = client.fetchCharacters(ids);
+        benchmark::DoNotOptimize(characters.data());
+    }
+
+    state.counters["requests"] = benchmark::Counter(
+        static_cast<double>(server.stats().requests - requestsBefore), benchmark::Counter::kAvgIterations);
+}
+BENCHMARK(BM_LocalServerFetchCharactersChunked)
+    ->ArgName("chunk")
+    ->Arg(20)
+    ->Arg(50)
+    ->Arg(100)
+    ->Arg(200)
+    ->Arg(800)
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime()
+    ->Iterations(3);
+
+/**
+ * Single-request throughput for a character batch over one keep-alive
+ * connection, with an optional per-connection bandwidth cap (bytes/s, 0 = none).
+ */
+void BM_LocalServerCharacterBatch(benchmark::State& state) {
+    LocalApiServer server;
+    server.addSyntheticCharacters(100);
+    LocalApiServer::Behavior behavior;
+    behavior.bandwidthBytesPerSecond = static_cast<size_t>(state.range(0));
+    server.setBehavior(behavior);
+
+    std::string url = server.baseUrl() + "/character/";
+    for (int id = 1; id <= 100; ++id) {
+        url += (id > 1 ? "," : "") + std::to_string(id);
+    }
+
+    CurlHttpClient http;
+    ResponseBuffer buffer;
+    for (auto _ : state) {
+        http.get(url, buffer);
+        benchmark::DoNotOptimize(buffer.view().data());
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(buffer.size()));
+}
+BENCHMARK(BM_LocalServerCharacterBatch)
+    ->ArgName("bandwidth")
+    ->Arg(0)
+    ->Arg(10 * 1024 * 1024)
+    ->Unit(benchmark::kMicrosecond)
+    ->UseRealTime();
+
+} // namespace
+} // namespace rickmorty
+
+#endif // _WIN32
@@ -0,0 +1,51 @@
+#include <benchmark/benchmark.h>
+#include <chrono>
+#include "core/ApiClient.h"
+#include "fakes/FakeHttpClient.h"
+#include "fakes/SyntheticApiData.h"
+
+namespace rickmorty {
+namespace {
+
+using testing::FakeHttpClient;
+
+constexpr int ITEMS_PER_PAGE = 20;
+constexpr std::chrono::milliseconds SIMULATED_RTT{25};
+
+/**
+ * Cold-start fetchAllEpisodes against a fake with a fixed per-request latency.
+ *
+ * Args: {page count, max concurrent requests}. With a concurrency of 1 the
+ * client walks info.next serially (pages x RTT); with fan-out enabled the
+ * remaining pages overlap after the first response (~2 x RTT).
+ */
+void BM_FetchAllPaginated(benchmark::State& state) {
+    const int pages = static_cast<int>(state.range(0));
+    const int totalCount = pages * ITEMS_PER_PAGE;
+
+    auto fake = std::make_unique<FakeHttpClient>();
+    fake->simulateLatency(SIMULATED_RTT)
+        .routePatternWithHandler("/api/episode", [totalCount](const std::string& url) {
+            return testing::syntheticEpisodePageJson(testing::pageFromUrl(url), totalCount);
+        });
+
+    ApiClient client(std::move(fake));
+    client.setMaxConcurrentRequests(static_cast<size_t>(state.range(1)));
+
+    for (auto _ : state) {
+        auto episodes = client.fetchAllEpisodes();
+        benchmark::DoNotOptimize(episodes.data());
+    }
+
+    state.counters["pages"] = pages;
+    state.counters["rtt_ms"] = static_cast<double>(SIMULATED_RTT.count());
+}
+BENCHMARK(BM_FetchAllPaginated)
+    ->ArgNames({"pages", "concurrency"})
+    ->ArgsProduct({{3, 10, 42}, {1, 6}})
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime()
+    ->Iterations(3);
+
+} // namespace
+} // namespace rickmorty
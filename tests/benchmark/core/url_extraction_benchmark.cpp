@@ -0,0 +1,90 @@
+#include <benchmark/benchmark.h>
+#include <string>
+#include <vector>
+#include "allocation_counter.h"
+#include "core/Models.h"
+
+namespace rickmorty {
+namespace {
+
+// The character list of one large episode
+std::vector<std::string> characterUrls() {
+    std::vector<std::string> urls;
+    for (int id = 1; id <= 50; ++id) {
+        urls.push_back("https://rickandmortyapi.com/api/character/" + std::to_string(id * 16));
+    }
+    return urls;
+}
+
+// extractIdFromUrl as it was before it moved to from_chars
+int extractIdWithStoi(const std::string& url) {
+    if (url.empty()) return -1;
+    auto pos = url.rfind('/');
+    if (pos != std::string::npos && pos + 1 < url.size()) {
+        try {
+            return std::stoi(url.substr(pos + 1));
+        } catch (...) {
+            return -1;
+        }
+    }
+    return -1;
+}
+
+template<typename Extract>
+void runExtractionBenchmark(benchmark::State& state, Extract extract) {
+    const std::vector<std::string> urls = characterUrls();
+    std::vector<int> ids;
+
+    testing::resetAllocationCounts();
+    for (auto _ : state) {
+        ids.clear();
+        ids.shrink_to_fit();
+        testing::countAllocations(true);
+        extract(urls, ids);
+        testing::countAllocations(false);
+        benchmark::DoNotOptimize(ids.data());
+    }
+
+    const double iterations = static_cast<double>(state.iterations());
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(urls.size()));
+    state.counters["allocs"] = static_cast<double>(testing::allocationCounts().allocations) / iterations;
+}
+
+/**
+ * Ids for a 50-character episode, one URL at a time through the former
+ * substr + std::stoi extractor. Counters report operator new calls per
+ * episode, including the growth of the id vector.
+ */
+void BM_ExtractIdsStoi(benchmark::State& state) {
+    runExtractionBenchmark(state, [](const std::vector<std::string>& urls, std::vector<int>& ids) {
+        for (const auto& url : urls) {
+            ids.push_back(extractIdWithStoi(url));
+        }
+    });
+}
+BENCHMARK(BM_ExtractIdsStoi);
+
+/**
+ * The same loop through the from_chars extractIdFromUrl.
+ */
+void BM_ExtractIdsFromChars(benchmark::State& state) {
+    runExtractionBenchmark(state, [](const std::vector<std::string>& urls, std::vector<int>& ids) {
+        for (const auto& url : urls) {
+            ids.push_back(extractIdFromUrl(url));
+        }
+    });
+}
+BENCHMARK(BM_ExtractIdsFromChars);
+
+/**
+ * extractIdsFromUrls: reserves the id vector once, then extracts.
+ */
+void BM_ExtractIdsBulk(benchmark::State& state) {
+    runExtractionBenchmark(state, [](const std::vector<std::string>& urls, std::vector<int>& ids) {
+        extractIdsFromUrls(urls, ids);
+    });
+}
+BENCHMARK(BM_ExtractIdsBulk);
+
+} // namespace
+} // namespace rickmorty
@@ -1,6 +1,7 @@
 #include "FakeHttpClient.h"
 #include <algorithm>
 #include <stdexcept>
+#include <thread>
 
 namespace rickmorty {
 namespace testing {
@@ -10,6 +11,16 @@ namespace testing {
 //=============================================================================
 
 std::string FakeHttpClient::get(const std::string& url) {
+    // Simulated latency is applied outside the lock so parallel callers overlap
+    std::chrono::milliseconds latency;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        latency = latency_;
+    }
+    if (latency.count() > 0) {
+        std::this_thread::sleep_for(latency);
+    }
+
     std::lock_guard<std::mutex> lock(mutex_);
 
     // Record the request
@@ -61,6 +72,10 @@ void FakeHttpClient::setUserAgent(const std::string& userAgent) {
     userAgent_ = userAgent;
 }
 
+bool FakeHttpClient::supportsConcurrentRequests() const {
+    return true;
+}
+
 //=============================================================================
 // Fluent configuration API
 //=============================================================================
@@ -137,6 +152,12 @@ FakeHttpClient& FakeHttpClient::simulateErrorForUrl(
     return *this;
 }
 
+FakeHttpClient& FakeHttpClient::simulateLatency(std::chrono::milliseconds latency) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    latency_ = latency;
+    return *this;
+}
+
 FakeHttpClient& FakeHttpClient::clearGlobalError() {
     std::lock_guard<std::mutex> lock(mutex_);
     globalError_.reset();
@@ -20,6 +20,7 @@
 #include <memory>
 #include <fstream>
 #include <sstream>
+#include <chrono>
 
 namespace rickmorty {
 namespace testing {
@@ -96,6 +97,12 @@ public:
      */
     void setUserAgent(const std::string& userAgent) override;
 
+    /**
+     * @brief The fake is thread-safe, so concurrent requests are allowed.
+     * @return Always true.
+     */
+    bool supportsConcurrentRequests() const override;
+
     //=========================================================================
     // Fluent configuration API
     //=========================================================================
@@ -185,6 +192,18 @@ public:
         const std::string& message,
         int httpCode = 0);
 
+    /**
+     * @brief Delays every request by a fixed amount to model network round trips.
+     *
+     * The delay is applied before the route lookup and without holding the
+     * internal lock, so concurrent requests overlap their latency the way
+     * real requests would.
+     *
+     * @param latency Per-request delay (zero disables the delay).
+     * @return Reference to this for method chaining.
+     */
+    FakeHttpClient& simulateLatency(std::chrono::milliseconds latency);
+
     /**
      * @brief Clears the global error simulation.
      * @return Reference to this for method chaining.
@@ -339,6 +358,7 @@ private:
     std::optional<std::string> defaultResponse_;
     std::optional<long> timeout_;
     std::optional<std::string> userAgent_;
+    std::chrono::milliseconds latency_{0};
 };
 
 } // namespace testing
@@ -0,0 +1,181 @@
+#include "SyntheticApiData.h"
+#include <algorithm>
+#include <nlohmann/json.hpp>
+
+namespace rickmorty {
+namespace testing {
+
+namespace {
+
+using json = nlohmann::json;
+
+std::string resourceUrl(const char* resource, int id) {
+    return std::string(SYNTHETIC_API_BASE) + "/" + resource + "/" + std::to_string(id);
+}
+
+std::string twoDigits(int value) {
+    return (value < 10 ? "0" : "") + std::to_string(value);
+}
+
+json episodeObject(int id, const std::vector<int>& characterIds) {
+    // Ten episodes per season, mirroring the real S01E01 episode codes
+    const int season = (id - 1) / 10 + 1;
+    const int episodeNumber = (id - 1) % 10 + 1;
+
+    json characters = json::array();
+    for (int charId : characterIds) {
+        characters.push_back(resourceUrl("character", charId));
+    }
+
+    return json{
+        {"id", id},
+        {"name", "Episode " + std::to_string(id)},
+        {"air_date", "December 2, 2013"},
+        {"episode", "S" + twoDigits(season) + "E" + twoDigits(episodeNumber)},
+        {"characters", characters},
+        {"url", resourceUrl("episode", id)},
+        {"created", "2017-11-10T12:56:33.798Z"}
+    };
+}
+
+json characterObject(int id) {
+    static const char* const statuses[] = {"Alive", "Dead", "unknown"};
+    static const char* const species[] = {"Human", "Alien", "Humanoid", "Robot", "Animal"};
+    static const char* const genders[] = {"Male", "Female", "Genderless", "unknown"};
+
+    const int originId = id % 20 + 1;
+    const int locationId = id % 7 + 1;
+
+    json episodes = json::array();
+    for (int ep = 1; ep <= id % 5 + 1; ++ep) {
+        episodes.push_back(resourceUrl("episode", ep));
+    }
+
+    return json{
+        {"id", id},
+        {"name", "Character " + std::to_string(id)},
+        {"status", statuses[id % 3]},
+        {"species", species[id % 5]},
+        {"type", ""},
+        {"gender", genders[id % 4]},
+        {"origin", {
+            {"name", "Location " + std::to_string(originId)},
+            {"url", resourceUrl("location", originId)}
+        }},
+        {"location", {
+            {"name", "Location " + std::to_string(locationId)},
+            {"url", resourceUrl("location", locationId)}
+        }},
+        {"image", std::string(SYNTHETIC_API_BASE) + "/character/avatar/" + std::to_string(id) + ".jpeg"},
+        {"episode", episodes},
+        {"url", resourceUrl("character", id)},
+        {"created", "2017-11-04T18:48:46.250Z"}
+    };
+}
+
+json locationObject(int id) {
+    static const char* const types[] = {"Planet", "Space station", "Microverse", "Dimension"};
+
+    json residents = json::array();
+    for (int r = 0; r < id % 6 + 1; ++r) {
+        residents.push_back(resourceUrl("character", (id * 11 + r) % 826 + 1));
+    }
+
+    return json{
+        {"id", id},
+        {"name", "Location " + std::to_string(id)},
+        {"type", types[id % 4]},
+        {"dimension", "Dimension C-" + std::to_string(100 + id)},
+        {"residents", residents},
+        {"url", resourceUrl("location", id)},
+        {"created", "2017-11-10T12:42:04.162Z"}
+    };
+}
+
+// Wraps items (ids firstId..lastId built by makeItem) in the API's info/results envelope
+template<typename MakeItem>
+std::string pageJson(const char* resource, int page, int totalCount, int perPage, MakeItem makeItem) {
+    const int pages = (totalCount + perPage - 1) / perPage;
+    const int firstId = (page - 1) * perPage + 1;
+    const int lastId = std::min(page * perPage, totalCount);
+
+    const std::string endpoint = std::string(SYNTHETIC_API_BASE) + "/" + resource + "?page=";
+    json info{
+        {"count", totalCount},
+        {"pages", pages},
+        {"next", page < pages ? json(endpoint + std::to_string(page + 1)) : json(nullptr)},
+        {"prev", page > 1 ? json(endpoint + std::to_string(page - 1)) : json(nullptr)}
+    };
+
+    json results = json::array();
+    for (int id = firstId; id <= lastId; ++id) {
+        results.push_back(makeItem(id));
+    }
+
+    return json{{"info", info}, {"results", results}}.dump();
+}
+
+} // namespace
+
+std::string syntheticEpisodeJson(int id, const std::vector<int>& characterIds) {
+    return episodeObject(id, characterIds).dump();
+}
+
+std::string syntheticCharacterJson(int id) {
+    return characterObject(id).dump();
+}
+
+std::string syntheticCharacterListJson(const std::vector<int>& ids) {
+    if (ids.size() == 1) {
+        return characterObject(ids.front()).dump();
+    }
+    json characters = json::array();
+    for (int id : ids) {
+        characters.push_back(characterObject(id));
+    }
+    return characters.dump();
+}
+
+std::string syntheticEpisodePageJson(int page, int totalCount, int perPage,
+                                     int charactersPerEpisode, int characterCount) {
+    return pageJson("episode", page, totalCount, perPage, [charactersPerEpisode, characterCount](int id) {
+        std::vector<int> characterIds;
+        for (int c = 0; c < charactersPerEpisode; ++c) {
+            characterIds.push_back((id * 7 + c) % characterCount + 1);
+        }
+        return episodeObject(id, characterIds);
+    });
+}
+
+std::string syntheticCharacterPageJson(int page, int totalCount, int perPage) {
+    return pageJson("character", page, totalCount, perPage, characterObject);
+}
+
+std::string syntheticLocationPageJson(int page, int totalCount, int perPage) {
+    return pageJson("location", page, totalCount, perPage, locationObject);
+}
+
+int pageFromUrl(const std::string& url) {
+    const auto pos = url.find("page=");
+    if (pos == std::string::npos) {
+        return 1;
+    }
+    return std::stoi(url.substr(pos + 5));
+}
+
+std::vector<int> idsFromUrl(const std::string& url) {
+    std::vector<int> ids;
+    size_t pos = url.rfind('/') + 1;
+    while (pos < url.size()) {
+        size_t end = url.find(',', pos);
+        if (end == std::string::npos) {
+            end = url.size();
+        }
+        ids.push_back(std::stoi(url.substr(pos, end - pos)));
+        pos = end + 1;
+    }
+    return ids;
+}
+
+} // namespace testing
+} // namespace rickmorty
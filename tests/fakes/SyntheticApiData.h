@@ -0,0 +1,83 @@
+#pragma once
+
+/**
+ * @file SyntheticApiData.h
+ * @brief Generators for API-shaped JSON used by tests and benchmarks.
+ *
+ * The fixture files under tests/fixtures/json cover a handful of real records.
+ * Tests and benchmarks that need many records (pagination, large character
+ * batches) use these generators instead, which produce payloads with the same
+ * shape as the real Rick and Morty API.
+ */
+
+#include <string>
+#include <vector>
+
+namespace rickmorty {
+namespace testing {
+
+/// Base URL used for ids embedded in generated payloads.
+inline constexpr const char* SYNTHETIC_API_BASE = "https://rickandmortyapi.com/api";
+
+/**
+ * @brief Builds a single episode object.
+ * @param id Episode id; season and episode number are derived from it.
+ * @param characterIds Ids referenced in the "characters" array.
+ */
+std::string syntheticEpisodeJson(int id, const std::vector<int>& characterIds);
+
+/**
+ * @brief Builds a single character object.
+ * @param id Character id; other fields are derived from it deterministically.
+ */
+std::string syntheticCharacterJson(int id);
+
+/**
+ * @brief Builds a multi-get character response the way the API shapes it:
+ *        an array of objects, or a bare object when exactly one id is given.
+ * @param ids Character ids, emitted in the given order.
+ */
+std::string syntheticCharacterListJson(const std::vector<int>& ids);
+
+/**
+ * @brief Builds one page of the paginated /episode endpoint.
+ *
+ * Episode ids are assigned consecutively: page N holds ids
+ * (N - 1) * perPage + 1 through N * perPage, capped at totalCount.
+ *
+ * @param page 1-based page number.
+ * @param totalCount Total number of episodes across all pages.
+ * @param perPage Number of episodes per page (the real API uses 20).
+ * @param charactersPerEpisode Number of character references per episode.
+ * @param characterCount Referenced character ids wrap around after this
+ *        many; the real API has 826 characters.
+ */
+std::string syntheticEpisodePageJson(int page, int totalCount, int perPage = 20,
+                                     int charactersPerEpisode = 10, int characterCount = 826);
+
+/**
+ * @brief Builds one page of the paginated /character endpoint, with ids
+ *        assigned like syntheticEpisodePageJson().
+ */
+std::string syntheticCharacterPageJson(int page, int totalCount, int perPage = 20);
+
+/**
+ * @brief Builds one page of the paginated /location endpoint, with ids
+ *        assigned like syntheticEpisodePageJson().
+ */
+std::string syntheticLocationPageJson(int page, int totalCount, int perPage = 20);
+
+/**
+ * @brief Extracts the page number from a "?page=N" URL.
+ * @return The page number, or 1 if the URL has no page parameter.
+ */
+int pageFromUrl(const std::string& url);
+
+/**
+ * @brief Extracts the ids from a multi-get URL such as ".../character/1,2,3".
+ * @return The ids after the last '/', in URL order.
+ */
+std::vector<int> idsFromUrl(const std::string& url);
+
+} // namespace testing
+} // namespace rickmorty
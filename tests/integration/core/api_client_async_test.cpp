@@ -0,0 +1,153 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include <chrono>
+#include "core/ApiClient.h"
+#include "core/CoalescingHttpClient.h"
+#include "core/CurlHttpClient.h"
+#include "fakes/FakeHttpClient.h"
+#include "fakes/SyntheticApiData.h"
+
+namespace rickmorty {
+namespace {
+
+using testing::FakeHttpClient;
+using testing::syntheticCharacterJson;
+using testing::syntheticEpisodeJson;
+
+class ApiClientAsyncTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        fake_ = std::make_unique<FakeHttpClient>();
+        fakePtr_ = fake_.get();
+    }
+
+    std::unique_ptr<FakeHttpClient> fake_;
+    FakeHttpClient* fakePtr_ = nullptr;
+};
+
+TEST_F(ApiClientAsyncTest, FetchEpisodeAsyncParsesEpisode) {
+    fake_->route("https://rickandmortyapi.com/api/episode/7", syntheticEpisodeJson(7, {1, 2}));
+    ApiClient client(std::move(fake_));
+
+    auto episode = client.fetchEpisodeAsync(7).get();
+
+    ASSERT_TRUE(episode.has_value());
+    EXPECT_EQ(episode->id, 7);
+    EXPECT_THAT(episode->characterIds, ::testing::ElementsAre(1, 2));
+}
+
+TEST_F(ApiClientAsyncTest, FetchEpisodeAsyncReturnsNulloptOnNotFound) {
+    ApiClient client(std::move(fake_));
+
+    auto episode = client.fetchEpisodeAsync(9999).get();
+
+    EXPECT_FALSE(episode.has_value());
+}
+
+TEST_F(ApiClientAsyncTest, FetchCharactersAsyncUsesMultiGetUrl) {
+    fake_->route("https://rickandmortyapi.com/api/character/1,2",
+                 "[" + syntheticCharacterJson(1) + "," + syntheticCharacterJson(2) + "]");
+    ApiClient client(std::move(fake_));
+
+    auto characters = client.fetchCharactersAsync({1, 2}).get();
+
+    ASSERT_EQ(characters.size(), 2u);
+    EXPECT_EQ(characters[0].id, 1);
+    EXPECT_EQ(characters[1].id, 2);
+}
+
+TEST_F(ApiClientAsyncTest, FetchCharactersAsyncWithNoIdsMakesNoRequest) {
+    ApiClient client(std::move(fake_));
+
+    auto characters = client.fetchCharactersAsync({}).get();
+
+    EXPECT_TRUE(characters.empty());
+    EXPECT_EQ(fakePtr_->totalRequestCount(), 0u);
+}
+
+TEST_F(ApiClientAsyncTest, FetchCharactersAsyncSurfacesTransportErrors) {
+    fake_->simulateError(HttpException::Type::Timeout, "timed out");
+    ApiClient client(std::move(fake_));
+
+    auto future = client.fetchCharactersAsync({1});
+
+    try {
+        future.get();
+        FAIL() << "Expected ApiException";
+    } catch (const ApiException& e) {
+        EXPECT_EQ(e.type(), ApiException::Type::NetworkError);
+    }
+}
+
+TEST_F(ApiClientAsyncTest, FetchLocationAsyncSurfacesParseErrors) {
+    fake_->route("https://rickandmortyapi.com/api/location/3", "{not json");
+    ApiClient client(std::move(fake_));
+
+    auto future = client.fetchLocationAsync(3);
+
+    try {
+        future.get();
+        FAIL() << "Expected ApiException";
+    } catch (const ApiException& e) {
+        EXPECT_EQ(e.type(), ApiException::Type::ParseError);
+    }
+}
+
+TEST_F(ApiClientAsyncTest, DecoratedClientCompletesBeforeReturning) {
+    fake_->route("https://rickandmortyapi.com/api/episode/1", syntheticEpisodeJson(1, {1, 2}))
+        .routePatternWithHandler("/api/character/", [](const std::string& url) {
+            return testing::syntheticCharacterListJson(testing::idsFromUrl(url));
+        });
+    ApiClient client(std::make_unique<CoalescingHttpClient>(std::move(fake_)));
+    client.setCharacterChunkSize(2);
+
+    // The decorators' getAsync() blocks, so every chunk has been fetched
+    auto future = client.fetchCharactersAsync({1, 2, 3, 4, 5});
+
+    EXPECT_EQ(fakePtr_->totalRequestCount(), 3u);
+    ASSERT_EQ(future.wait_for(std::chrono::seconds(0)), std::future_status::deferred);   // Only the merge
+    EXPECT_EQ(future.get().size(), 5u);
+    auto episode = client.fetchEpisodeAsync(1);
+    EXPECT_EQ(episode.wait_for(std::chrono::seconds(0)), std::future_status::ready);
+    EXPECT_TRUE(episode.get().has_value());
+}
+
+TEST_F(ApiClientAsyncTest, BatchReturnsOneFuturePerUrlInOrder) {
+    fake_->route("a", "first").route("b", "second");
+
+    auto futures = fake_->getBatchAsync({"a", "b"});
+
+    ASSERT_EQ(futures.size(), 2u);
+    EXPECT_EQ(futures[0].get(), "first");
+    EXPECT_EQ(futures[1].get(), "second");
+}
+
+// Nothing listens on port 1, so these exercise the curl_multi loop offline
+TEST(CurlHttpClientAsyncTest, ConnectionFailuresCompleteWithNetworkError) {
+    CurlHttpClient client;
+    client.setTimeout(5000);
+
+    auto futures = client.getBatchAsync({"http://127.0.0.1:1/a", "http://127.0.0.1:1/b"});
+
+    for (auto& future : futures) {
+        ASSERT_EQ(future.wait_for(std::chrono::seconds(10)), std::future_status::ready);
+        try {
+            future.get();
+            FAIL() << "Expected HttpException";
+        } catch (const HttpException& e) {
+            EXPECT_EQ(e.type(), HttpException::Type::NetworkError);
+        }
+    }
+}
+
+TEST(CurlHttpClientAsyncTest, MovedFromClientFailsImmediately) {
+    CurlHttpClient client;
+    CurlHttpClient other(std::move(client));
+
+    auto future = client.getAsync("http://127.0.0.1:1/");
+
+    EXPECT_THROW(future.get(), HttpException);
+}
+
+}  // namespace
+}  // namespace rickmorty
@@ -0,0 +1,195 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include <algorithm>
+#include <chrono>
+#include "core/ApiClient.h"
+#include "fakes/FakeHttpClient.h"
+#include "fakes/SyntheticApiData.h"
+
+namespace rickmorty {
+namespace {
+
+using testing::FakeHttpClient;
+using testing::idsFromUrl;
+using testing::syntheticCharacterListJson;
+
+class ApiClientChunkingTest : public ::testing::Test {
+protected:
+    static constexpr const char* CHARACTER_URL_PATTERN = "/api/character/";
+
+    void SetUp() override {
+        fake_ = std::make_unique<FakeHttpClient>();
+        fakePtr_ = fake_.get();
+    }
+
+    // Answers multi-gets with the requested ids, in URL order
+    void serveCharacters() {
+        fake_->routePatternWithHandler(CHARACTER_URL_PATTERN, [](const std::string& url) {
+            return syntheticCharacterListJson(idsFromUrl(url));
+        });
+    }
+
+    static std::vector<int> ids(const std::vector<Character>& characters) {
+        std::vector<int> result;
+        for (const auto& c : characters) {
+            result.push_back(c.id);
+        }
+        return result;
+    }
+
+    static std::vector<int> range(int first, int last) {
+        std::vector<int> result;
+        for (int i = first; i <= last; ++i) {
+            result.push_back(i);
+        }
+        return result;
+    }
+
+    std::unique_ptr<FakeHttpClient> fake_;
+    FakeHttpClient* fakePtr_ = nullptr;
+};
+
+TEST_F(ApiClientChunkingTest, ShortListUsesOneRequest) {
+    serveCharacters();
+    ApiClient client(std::move(fake_));
+
+    auto characters = client.fetchCharacters({1, 2, 3});
+
+    EXPECT_EQ(ids(characters), std::vector<int>({1, 2, 3}));
+    EXPECT_THAT(fakePtr_->requestedUrls(), ::testing::ElementsAre(
+        "https://rickandmortyapi.com/api/character/1,2,3"));
+}
+
+TEST_F(ApiClientChunkingTest, LongListIsSplitAndMergedInRequestOrder) {
+    serveCharacters();
+    ApiClient client(std::move(fake_));
+    client.setCharacterChunkSize(40);
+
+    std::vector<int> requested = range(1, 130);
+    std::reverse(requested.begin(), requested.end());
+    auto characters = client.fetchCharacters(requested);
+
+    EXPECT_EQ(ids(characters), requested);
+    EXPECT_EQ(fakePtr_->totalRequestCount(), 4u);
+    for (const auto& url : fakePtr_->requestedUrls()) {
+        EXPECT_LE(idsFromUrl(url).size(), 40u);
+    }
+}
+
+TEST_F(ApiClientChunkingTest, ChunksStayWithinUrlLengthLimit) {
+    serveCharacters();
+    ApiClient client(std::move(fake_));
+    client.setCharacterChunkSize(10000);
+
+    // Seven-digit ids: 1000 of them would make an 8 KB URL
+    auto characters = client.fetchCharacters(range(1000000, 1000999));
+
+    EXPECT_EQ(characters.size(), 1000u);
+    EXPECT_GT(fakePtr_->totalRequestCount(), 1u);
+    for (const auto& url : fakePtr_->requestedUrls()) {
+        EXPECT_LE(url.size(), 2048u);
+    }
+}
+
+TEST_F(ApiClientChunkingTest, ChunksAreFetchedConcurrently) {
+    using namespace std::chrono;
+    serveCharacters();
+    fake_->simulateLatency(milliseconds(40));
+    ApiClient client(std::move(fake_));
+    client.setCharacterChunkSize(10);
+    client.setMaxConcurrentRequests(8);
+
+    const auto start = steady_clock::now();
+    auto characters = client.fetchCharacters(range(1, 80));
+    const auto elapsed = duration_cast<milliseconds>(steady_clock::now() - start);
+
+    EXPECT_EQ(characters.size(), 80u);
+    // Serial would take ~320ms; one parallel wave takes ~40ms
+    EXPECT_LT(elapsed.count(), 250);
+}
+
+TEST_F(ApiClientChunkingTest, UnknownIdInSingleIdChunkIsOmitted) {
+    fake_->route("https://rickandmortyapi.com/api/character/1,2",
+                 syntheticCharacterListJson({1, 2}))
+        .simulateErrorForUrl("https://rickandmortyapi.com/api/character/999",
+                             HttpException::Type::NotFound, "not found", 404);
+    ApiClient client(std::move(fake_));
+    client.setCharacterChunkSize(2);
+
+    auto characters = client.fetchCharacters({1, 2, 999});
+
+    EXPECT_EQ(ids(characters), std::vector<int>({1, 2}));
+}
+
+TEST_F(ApiClientChunkingTest, NotFoundOnMultiIdChunkSurfacesAsNotFound) {
+    serveCharacters();
+    fake_->simulateErrorForUrl("https://rickandmortyapi.com/api/character/3,4",
+                               HttpException::Type::NotFound, "not found", 404);
+    ApiClient client(std::move(fake_));
+    client.setCharacterChunkSize(2);
+
+    try {
+        client.fetchCharacters({1, 2, 3, 4, 5, 6});
+        FAIL() << "Expected ApiException";
+    } catch (const ApiException& e) {
+        EXPECT_EQ(e.type(), ApiException::Type::NotFound);
+    }
+    try {
+        client.fetchCharactersAsync({1, 2, 3, 4, 5, 6}).get();
+        FAIL() << "Expected ApiException";
+    } catch (const ApiException& e) {
+        EXPECT_EQ(e.type(), ApiException::Type::NotFound);
+    }
+}
+
+TEST_F(ApiClientChunkingTest, FailedChunkSurfacesAsNetworkError) {
+    serveCharacters();
+    fake_->simulateErrorForUrl("https://rickandmortyapi.com/api/character/3,4",
+                               HttpException::Type::Timeout, "timed out");
+    ApiClient client(std::move(fake_));
+    client.setCharacterChunkSize(2);
+
+    try {
+        client.fetchCharacters({1, 2, 3, 4, 5, 6});
+        FAIL() << "Expected ApiException";
+    } catch (const ApiException& e) {
+        EXPECT_EQ(e.type(), ApiException::Type::NetworkError);
+    }
+}
+
+TEST_F(ApiClientChunkingTest, ThrowingBeforeRequestSkipsTheRemainingChunks) {
+    serveCharacters();
+    ApiClient client(std::move(fake_));
+    client.setCharacterChunkSize(2);
+    client.setMaxConcurrentRequests(1);
+
+    int requests = 0;
+    auto stopAfterTwo = [&requests]() {
+        if (++requests > 2) {
+            throw std::runtime_error("no longer needed");
+        }
+    };
+
+    EXPECT_THROW(client.fetchCharacters(range(1, 10), stopAfterTwo), std::runtime_error);
+    EXPECT_EQ(fakePtr_->totalRequestCount(), 2u);
+}
+
+TEST_F(ApiClientChunkingTest, AsyncFetchMergesChunks) {
+    serveCharacters();
+    ApiClient client(std::move(fake_));
+    client.setCharacterChunkSize(25);
+
+    auto characters = client.fetchCharactersAsync(range(1, 60)).get();
+
+    EXPECT_EQ(ids(characters), range(1, 60));
+    EXPECT_EQ(fakePtr_->totalRequestCount(), 3u);
+}
+
+TEST_F(ApiClientChunkingTest, ChunkSizeIsClampedToOne) {
+    ApiClient client(std::move(fake_));
+    client.setCharacterChunkSize(0);
+    EXPECT_EQ(client.characterChunkSize(), 1u);
+}
+
+}  // namespace
+}  // namespace rickmorty
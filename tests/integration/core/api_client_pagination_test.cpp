@@ -0,0 +1,174 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include <chrono>
+#include "core/ApiClient.h"
+#include "fakes/FakeHttpClient.h"
+#include "fakes/SyntheticApiData.h"
+
+namespace rickmorty {
+namespace {
+
+using testing::FakeHttpClient;
+using testing::pageFromUrl;
+using testing::syntheticEpisodePageJson;
+
+/**
+ * @brief IHttpClient wrapper that hides the fake's thread-safety, forcing
+ *        ApiClient down its serial pagination path.
+ */
+class SerialOnlyHttpClient : public IHttpClient {
+public:
+    explicit SerialOnlyHttpClient(FakeHttpClient* inner) : inner_(inner) {}
+    std::string get(const std::string& url) override { return inner_->get(url); }
+
+private:
+    FakeHttpClient* inner_;
+};
+
+class ApiClientPaginationTest : public ::testing::Test {
+protected:
+    static constexpr const char* EPISODE_URL_PATTERN = "/api/episode";
+
+    void SetUp() override {
+        fake_ = std::make_unique<FakeHttpClient>();
+        fakePtr_ = fake_.get();
+    }
+
+    // Serves totalCount synthetic episodes split into 20-item pages
+    void serveEpisodes(int totalCount) {
+        fake_->routePatternWithHandler(EPISODE_URL_PATTERN,
+            [totalCount](const std::string& url) {
+                return syntheticEpisodePageJson(pageFromUrl(url), totalCount);
+            });
+    }
+
+    static std::vector<int> ids(const std::vector<Episode>& episodes) {
+        std::vector<int> result;
+        for (const auto& e : episodes) {
+            result.push_back(e.id);
+        }
+        return result;
+    }
+
+    static std::vector<int> range(int first, int last) {
+        std::vector<int> result;
+        for (int i = first; i <= last; ++i) {
+            result.push_back(i);
+        }
+        return result;
+    }
+
+    std::unique_ptr<FakeHttpClient> fake_;
+    FakeHttpClient* fakePtr_ = nullptr;
+};
+
+TEST_F(ApiClientPaginationTest, SinglePageMakesOneRequest) {
+    serveEpisodes(15);
+    ApiClient client(std::move(fake_));
+
+    auto episodes = client.fetchAllEpisodes();
+
+    EXPECT_EQ(episodes.size(), 15u);
+    EXPECT_EQ(fakePtr_->totalRequestCount(), 1u);
+}
+
+TEST_F(ApiClientPaginationTest, ParallelFetchPreservesPageOrder) {
+    serveEpisodes(95);
+    ApiClient client(std::move(fake_));
+    client.setMaxConcurrentRequests(3);
+
+    auto episodes = client.fetchAllEpisodes();
+
+    EXPECT_EQ(ids(episodes), range(1, 95));
+    EXPECT_EQ(fakePtr_->totalRequestCount(), 5u);
+}
+
+TEST_F(ApiClientPaginationTest, RequestsEveryPageExactlyOnce) {
+    serveEpisodes(51);
+    ApiClient client(std::move(fake_));
+
+    client.fetchAllEpisodes();
+
+    EXPECT_EQ(fakePtr_->requestCount("https://rickandmortyapi.com/api/episode"), 1u);
+    EXPECT_EQ(fakePtr_->requestCount("https://rickandmortyapi.com/api/episode?page=2"), 1u);
+    EXPECT_EQ(fakePtr_->requestCount("https://rickandmortyapi.com/api/episode?page=3"), 1u);
+    EXPECT_EQ(fakePtr_->totalRequestCount(), 3u);
+}
+
+TEST_F(ApiClientPaginationTest, SerialClientFollowsNextLinks) {
+    serveEpisodes(51);
+    ApiClient client(std::make_unique<SerialOnlyHttpClient>(fakePtr_));
+
+    auto episodes = client.fetchAllEpisodes();
+
+    EXPECT_EQ(ids(episodes), range(1, 51));
+    EXPECT_THAT(fakePtr_->requestedUrls(), ::testing::ElementsAre(
+        "https://rickandmortyapi.com/api/episode",
+        "https://rickandmortyapi.com/api/episode?page=2",
+        "https://rickandmortyapi.com/api/episode?page=3"));
+}
+
+TEST_F(ApiClientPaginationTest, ConcurrencyOfOneFetchesSerially) {
+    serveEpisodes(60);
+    ApiClient client(std::move(fake_));
+    client.setMaxConcurrentRequests(1);
+
+    auto episodes = client.fetchAllEpisodes();
+
+    EXPECT_EQ(ids(episodes), range(1, 60));
+}
+
+TEST_F(ApiClientPaginationTest, ParallelFetchOverlapsLatency) {
+    using namespace std::chrono;
+    serveEpisodes(200);  // 10 pages
+    fake_->simulateLatency(milliseconds(40));
+    ApiClient client(std::move(fake_));
+    client.setMaxConcurrentRequests(9);
+
+    const auto start = steady_clock::now();
+    auto episodes = client.fetchAllEpisodes();
+    const auto elapsed = duration_cast<milliseconds>(steady_clock::now() - start);
+
+    EXPECT_EQ(episodes.size(), 200u);
+    // Serial would take ~400ms; first page plus one parallel wave takes ~80ms
+    EXPECT_LT(elapsed.count(), 300);
+}
+
+TEST_F(ApiClientPaginationTest, FailedPageSurfacesAsNetworkError) {
+    serveEpisodes(80);
+    fake_->simulateErrorForUrl("https://rickandmortyapi.com/api/episode?page=3",
+                               HttpException::Type::Timeout, "timed out");
+    ApiClient client(std::move(fake_));
+
+    try {
+        client.fetchAllEpisodes();
+        FAIL() << "Expected ApiException";
+    } catch (const ApiException& e) {
+        EXPECT_EQ(e.type(), ApiException::Type::NetworkError);
+    }
+}
+
+TEST_F(ApiClientPaginationTest, MalformedPageSurfacesAsParseError) {
+    fake_->route("https://rickandmortyapi.com/api/episode",
+                 syntheticEpisodePageJson(1, 45))
+        .route("https://rickandmortyapi.com/api/episode?page=2",
+               syntheticEpisodePageJson(2, 45))
+        .route("https://rickandmortyapi.com/api/episode?page=3", "{not json");
+    ApiClient client(std::move(fake_));
+
+    try {
+        client.fetchAllEpisodes();
+        FAIL() << "Expected ApiException";
+    } catch (const ApiException& e) {
+        EXPECT_EQ(e.type(), ApiException::Type::ParseError);
+    }
+}
+
+TEST_F(ApiClientPaginationTest, MaxConcurrentRequestsIsClampedToOne) {
+    ApiClient client(std::move(fake_));
+    client.setMaxConcurrentRequests(0);
+    EXPECT_EQ(client.maxConcurrentRequests(), 1u);
+}
+
+}  // namespace
+}  // namespace rickmorty
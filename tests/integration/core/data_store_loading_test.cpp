@@ -0,0 +1,341 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include <atomic>
+#include <functional>
+#include <future>
+#include <thread>
+#include "core/DataStore.h"
+#include "fakes/FakeHttpClient.h"
+#include "fakes/SyntheticApiData.h"
+#include "mocks/MockDataObserver.h"
+
+namespace rickmorty {
+namespace {
+
+using ::testing::_;
+using testing::FakeHttpClient;
+using testing::NiceMockDataObserver;
+
+constexpr int EPISODE_COUNT = 3;
+constexpr size_t REQUESTS_PER_EPISODE = 5;   // 10 characters, 2 per request
+
+class DataStoreLoadingTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        auto fake = std::make_unique<FakeHttpClient>();
+        fakePtr_ = fake.get();
+        fake->routePatternWithHandler("/api/episode", [](const std::string& url) {
+                return testing::syntheticEpisodePageJson(testing::pageFromUrl(url), EPISODE_COUNT);
+            })
+            .routePatternWithHandler("/api/character/", [this](const std::string& url) {
+                if (onCharacterRequest_) {
+                    onCharacterRequest_();
+                }
+                return testing::syntheticCharacterListJson(testing::idsFromUrl(url));
+            });
+
+        // Serial chunks, so every load makes its requests one after another
+        auto client = std::make_unique<ApiClient>(std::move(fake));
+        client->setCharacterChunkSize(2);
+        client->setMaxConcurrentRequests(1);
+        store_ = std::make_unique<DataStore>(std::move(client));
+        // Prefetches would add requests of their own; DataStorePrefetchTest turns them on
+        store_->setPrefetchBudget(0);
+        store_->loadAllEpisodes();
+        store_->addObserver(&observer_);
+    }
+
+    void TearDown() override {
+        store_->removeObserver(&observer_);
+    }
+
+    size_t characterRequests() const {
+        size_t count = 0;
+        for (const auto& url : fakePtr_->requestedUrls()) {
+            if (url.find("/character/") != std::string::npos) ++count;
+        }
+        return count;
+    }
+
+    FakeHttpClient* fakePtr_ = nullptr;
+    std::function<void()> onCharacterRequest_;   // Runs on the loading thread
+    std::unique_ptr<DataStore> store_;
+    NiceMockDataObserver observer_;
+};
+
+TEST_F(DataStoreLoadingTest, CompletedLoadIsCounted) {
+    EXPECT_CALL(observer_, onCharactersLoaded(1, testing::HasCharacterCount(10)));
+
+    store_->loadCharactersForEpisode(1);
+
+    EXPECT_EQ(characterRequests(), REQUESTS_PER_EPISODE);
+    const EpisodeLoadStats stats = store_->getEpisodeLoadStats();
+    EXPECT_EQ(stats.started, 1u);
+    EXPECT_EQ(stats.completed, 1u);
+    EXPECT_EQ(stats.cancelled, 0u);
+}
+
+TEST_F(DataStoreLoadingTest, AlreadyCancelledTokenSkipsTheLoad) {
+    CancellationToken token;
+    token.cancel();
+    EXPECT_CALL(observer_, onLoadingStateChanged(_)).Times(0);
+    EXPECT_CALL(observer_, onCharactersLoaded(_, _)).Times(0);
+
+    store_->loadCharactersForEpisode(1, token);
+
+    EXPECT_EQ(characterRequests(), 0u);
+    EXPECT_FALSE(store_->areCharactersLoadedForEpisode(1));
+    EXPECT_EQ(store_->getEpisodeLoadStats().cancelled, 1u);
+    EXPECT_EQ(store_->getEpisodeLoadStats().started, 0u);
+}
+
+TEST_F(DataStoreLoadingTest, CancellingStopsBeforeTheNextRequest) {
+    CancellationToken token;
+    onCharacterRequest_ = [token]() { token.cancel(); };
+    {
+        ::testing::InSequence sequence;
+        EXPECT_CALL(observer_, onLoadingStateChanged(true));
+        EXPECT_CALL(observer_, onLoadingStateChanged(false));
+    }
+    EXPECT_CALL(observer_, onCharactersLoaded(_, _)).Times(0);
+    EXPECT_CALL(observer_, onError(_)).Times(0);
+
+    store_->loadCharactersForEpisode(1, token);
+
+    EXPECT_EQ(characterRequests(), 1u);
+    EXPECT_FALSE(store_->areCharactersLoadedForEpisode(1));
+    const EpisodeLoadStats stats = store_->getEpisodeLoadStats();
+    EXPECT_EQ(stats.cancelled, 1u);
+    EXPECT_EQ(stats.completed, 0u);
+}
+
+TEST_F(DataStoreLoadingTest, NewCallAfterCancellationStartsAfresh) {
+    CancellationToken first;
+    onCharacterRequest_ = [first]() { first.cancel(); };
+    store_->loadCharactersForEpisode(1, first);
+    onCharacterRequest_ = nullptr;
+
+    store_->loadCharactersForEpisode(1, CancellationToken());
+
+    EXPECT_TRUE(store_->areCharactersLoadedForEpisode(1));
+    const EpisodeLoadStats stats = store_->getEpisodeLoadStats();
+    EXPECT_EQ(stats.started, 2u);
+    EXPECT_EQ(stats.cancelled, 1u);
+    EXPECT_EQ(stats.completed, 1u);
+}
+
+// Holds the first character request until released, so that a second call
+// is made while the first load is in flight
+class DataStoreJoinTest : public DataStoreLoadingTest {
+protected:
+    void SetUp() override {
+        DataStoreLoadingTest::SetUp();
+        auto released = released_.get_future().share();
+        onCharacterRequest_ = [this, released]() {
+            if (!enteredOnce_.exchange(true)) {
+                entered_.set_value();
+                released.wait();
+            }
+        };
+    }
+
+    void startFirstLoad(const CancellationToken& token) {
+        firstLoad_ = std::thread([this, token]() { store_->loadCharactersForEpisode(1, token); });
+        entered_.get_future().wait();
+    }
+
+    void finishFirstLoad() {
+        released_.set_value();
+        firstLoad_.join();
+    }
+
+    std::promise<void> entered_;
+    std::promise<void> released_;
+    std::atomic<bool> enteredOnce_{false};
+    std::thread firstLoad_;
+};
+
+TEST_F(DataStoreJoinTest, DuplicateLoadJoinsTheOneInFlight) {
+    EXPECT_CALL(observer_, onCharactersLoaded(1, testing::HasCharacterCount(10))).Times(1);
+
+    startFirstLoad(CancellationToken());
+    store_->loadCharactersForEpisode(1, CancellationToken());   // Returns at once
+    finishFirstLoad();
+
+    EXPECT_EQ(characterRequests(), REQUESTS_PER_EPISODE);
+    const EpisodeLoadStats stats = store_->getEpisodeLoadStats();
+    EXPECT_EQ(stats.started, 1u);
+    EXPECT_EQ(stats.joined, 1u);
+    EXPECT_EQ(stats.completed, 1u);
+}
+
+TEST_F(DataStoreJoinTest, LoadContinuesWhileAnyCallerStillWantsIt) {
+    CancellationToken first;
+    startFirstLoad(first);
+    store_->loadCharactersForEpisode(1, CancellationToken());
+    first.cancel();
+    finishFirstLoad();
+
+    EXPECT_TRUE(store_->areCharactersLoadedForEpisode(1));
+    const EpisodeLoadStats stats = store_->getEpisodeLoadStats();
+    EXPECT_EQ(stats.completed, 1u);
+    EXPECT_EQ(stats.cancelled, 0u);
+}
+
+TEST_F(DataStoreJoinTest, LoadStopsOnceEveryCallerHasCancelled) {
+    CancellationToken first;
+    CancellationToken second;
+    startFirstLoad(first);
+    store_->loadCharactersForEpisode(1, second);
+    first.cancel();
+    second.cancel();
+    finishFirstLoad();
+
+    EXPECT_EQ(characterRequests(), 1u);
+    EXPECT_FALSE(store_->areCharactersLoadedForEpisode(1));
+    const EpisodeLoadStats stats = store_->getEpisodeLoadStats();
+    EXPECT_EQ(stats.joined, 1u);
+    EXPECT_EQ(stats.cancelled, 1u);
+}
+
+TEST_F(DataStoreLoadingTest, CacheCountsCastLookups) {
+    store_->loadCharactersForEpisode(1);
+    store_->loadCharactersForEpisode(1);
+    store_->loadCharactersForEpisode(2);   // Shares three characters with episode 1
+
+    const CharacterCacheStats stats = store_->getCharacterCacheStats();
+    EXPECT_EQ(stats.misses, 17u);
+    EXPECT_EQ(stats.hits, 13u);
+    EXPECT_EQ(stats.evictions, 0u);
+    EXPECT_EQ(stats.budgetBytes, 0u);
+    EXPECT_GT(stats.residentBytes, 17 * sizeof(Character));
+}
+
+TEST_F(DataStoreLoadingTest, BudgetEvictsAndUnloadsBrokenCasts) {
+    store_->loadCharactersForEpisode(1);
+    const size_t oneCast = store_->getCharacterCacheStats().residentBytes;
+    store_->setCharacterCacheBudget(oneCast + oneCast / 20);   // Ids vary in length; half a character of slack
+
+    store_->loadCharactersForEpisode(2);
+
+    // Episode 2's cast is pinned while it loads, so episode 1 pays for it
+    const CharacterCacheStats stats = store_->getCharacterCacheStats();
+    EXPECT_GT(stats.evictions, 0u);
+    EXPECT_LE(stats.residentBytes, stats.budgetBytes);
+    EXPECT_TRUE(store_->areCharactersLoadedForEpisode(2));
+    EXPECT_FALSE(store_->areCharactersLoadedForEpisode(1));
+    EXPECT_EQ(store_->getCharactersForEpisode(2).size(), 10u);
+
+    // Selecting it again fetches only what was evicted
+    const size_t requestsBefore = characterRequests();
+    EXPECT_CALL(observer_, onCharactersLoaded(1, testing::HasCharacterCount(10)));
+    store_->loadCharactersForEpisode(1);
+    EXPECT_TRUE(store_->areCharactersLoadedForEpisode(1));
+    EXPECT_LT(characterRequests() - requestsBefore, REQUESTS_PER_EPISODE);
+}
+
+TEST_F(DataStoreLoadingTest, ShrinkingTheBudgetEvictsAtOnce) {
+    store_->loadCharactersForEpisode(1);
+
+    store_->setCharacterCacheBudget(1);
+
+    EXPECT_EQ(store_->getCachedCharacterCount(), 0u);
+    EXPECT_FALSE(store_->areCharactersLoadedForEpisode(1));
+    const CharacterCacheStats stats = store_->getCharacterCacheStats();
+    EXPECT_EQ(stats.evictions, 10u);
+    EXPECT_EQ(stats.residentBytes, 0u);
+}
+
+class DataStorePrefetchTest : public DataStoreLoadingTest {
+protected:
+    void SetUp() override {
+        DataStoreLoadingTest::SetUp();
+        store_->setPrefetchBudget(DataStore::DEFAULT_PREFETCH_BUDGET);
+    }
+};
+
+TEST_F(DataStorePrefetchTest, SelectionPrefetchesBothNeighboursQuietly) {
+    EXPECT_CALL(observer_, onLoadingStateChanged(true)).Times(1);
+    EXPECT_CALL(observer_, onLoadingStateChanged(false)).Times(1);
+    EXPECT_CALL(observer_, onCharactersLoaded(2, _)).Times(1);
+    EXPECT_CALL(observer_, onCharactersLoaded(1, _)).Times(0);
+    EXPECT_CALL(observer_, onCharactersLoaded(3, _)).Times(0);
+
+    store_->loadCharactersForEpisode(2);
+    store_->waitForPrefetches();
+
+    EXPECT_TRUE(store_->areCharactersLoadedForEpisode(1));
+    EXPECT_TRUE(store_->areCharactersLoadedForEpisode(3));
+    const PrefetchStats stats = store_->getPrefetchStats();
+    EXPECT_EQ(stats.started, 2u);
+    EXPECT_EQ(stats.completed, 2u);
+    EXPECT_EQ(stats.misses, 1u);
+    EXPECT_EQ(stats.hits, 0u);
+}
+
+TEST_F(DataStorePrefetchTest, NextSelectionIsAnsweredWithoutLoading) {
+    store_->loadCharactersForEpisode(1);
+    store_->waitForPrefetches();
+    ASSERT_TRUE(store_->areCharactersLoadedForEpisode(2));
+    ::testing::Mock::VerifyAndClearExpectations(&observer_);
+
+    EXPECT_CALL(observer_, onLoadingStateChanged(_)).Times(0);
+    EXPECT_CALL(observer_, onCharactersLoaded(2, testing::HasCharacterCount(10))).Times(1);
+    store_->loadCharactersForEpisode(2);
+    store_->waitForPrefetches();
+
+    const PrefetchStats stats = store_->getPrefetchStats();
+    EXPECT_EQ(stats.hits, 1u);
+    EXPECT_EQ(stats.misses, 1u);
+    EXPECT_DOUBLE_EQ(stats.hitRate(), 0.5);
+    EXPECT_TRUE(store_->areCharactersLoadedForEpisode(3));   // Prefetched in turn
+}
+
+TEST_F(DataStorePrefetchTest, NeighboursBeyondTheBudgetAreSkipped) {
+    store_->setPrefetchBudget(1);
+
+    store_->loadCharactersForEpisode(2);
+    store_->waitForPrefetches();
+
+    // The next episode goes first
+    EXPECT_TRUE(store_->areCharactersLoadedForEpisode(3));
+    EXPECT_FALSE(store_->areCharactersLoadedForEpisode(1));
+    const PrefetchStats stats = store_->getPrefetchStats();
+    EXPECT_EQ(stats.started, 1u);
+    EXPECT_EQ(stats.skipped, 1u);
+}
+
+TEST_F(DataStorePrefetchTest, SelectionJoinsARunningPrefetch) {
+    // Episode 1 takes the first five requests; hold the prefetch's first one
+    std::promise<void> entered;
+    std::promise<void> released;
+    auto releasedFuture = released.get_future().share();
+    std::atomic<size_t> requests{0};
+    onCharacterRequest_ = [&, releasedFuture]() {
+        if (++requests == REQUESTS_PER_EPISODE + 1) {
+            entered.set_value();
+            releasedFuture.wait();
+        }
+    };
+
+    store_->loadCharactersForEpisode(1);
+    entered.get_future().wait();
+    ::testing::Mock::VerifyAndClearExpectations(&observer_);
+
+    EXPECT_CALL(observer_, onLoadingStateChanged(_)).Times(0);
+    EXPECT_CALL(observer_, onCharactersLoaded(2, testing::HasCharacterCount(10))).Times(1);
+    store_->loadCharactersForEpisode(2);   // Returns at once
+    released.set_value();
+    store_->waitForPrefetches();
+
+    // The joined prefetch goes on to fetch the selection's other neighbour
+    EXPECT_TRUE(store_->areCharactersLoadedForEpisode(3));
+    const PrefetchStats stats = store_->getPrefetchStats();
+    EXPECT_EQ(stats.hits, 1u);
+    EXPECT_EQ(stats.started, 2u);
+    EXPECT_EQ(stats.completed, 2u);
+    EXPECT_EQ(store_->getEpisodeLoadStats().joined, 1u);
+}
+
+}  // namespace
+}  // namespace rickmorty
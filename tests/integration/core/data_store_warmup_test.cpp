@@ -0,0 +1,407 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include <algorithm>
+#include <chrono>
+#include <set>
+#include <thread>
+#include "core/DataStore.h"
+#include "fakes/FakeHttpClient.h"
+#include "fakes/SyntheticApiData.h"
+#include "mocks/MockDataObserver.h"
+
+namespace rickmorty {
+namespace {
+
+using ::testing::_;
+using testing::FakeHttpClient;
+using testing::NiceMockDataObserver;
+using testing::pageFromUrl;
+
+constexpr int EPISODE_COUNT = 51;
+constexpr int CHARACTER_COUNT = 826;  // Synthetic episodes reference ids up to 826
+constexpr int LOCATION_COUNT = 126;
+
+class DataStoreWarmupTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        fake_ = std::make_unique<FakeHttpClient>();
+        fakePtr_ = fake_.get();
+        fake_->routePatternWithHandler("/api/episode", [](const std::string& url) {
+                return testing::syntheticEpisodePageJson(pageFromUrl(url), EPISODE_COUNT);
+            })
+            .routePatternWithHandler("/api/character\\?|/api/character$", [](const std::string& url) {
+                return testing::syntheticCharacterPageJson(pageFromUrl(url), CHARACTER_COUNT);
+            })
+            .routePatternWithHandler("/api/location", [](const std::string& url) {
+                return testing::syntheticLocationPageJson(pageFromUrl(url), LOCATION_COUNT);
+            });
+    }
+
+    std::unique_ptr<DataStore> makeStore() {
+        return std::make_unique<DataStore>(std::make_unique<ApiClient>(std::move(fake_)));
+    }
+
+    std::unique_ptr<FakeHttpClient> fake_;
+    FakeHttpClient* fakePtr_ = nullptr;
+};
+
+TEST_F(DataStoreWarmupTest, ApiClientFetchesAllCharactersAndLocations) {
+    ApiClient client(std::move(fake_));
+
+    auto characters = client.fetchAllCharacters();
+    auto locations = client.fetchAllLocations();
+
+    ASSERT_EQ(characters.size(), static_cast<size_t>(CHARACTER_COUNT));
+    EXPECT_EQ(characters.back().id, CHARACTER_COUNT);
+    ASSERT_EQ(locations.size(), static_cast<size_t>(LOCATION_COUNT));
+    EXPECT_FALSE(locations.front().residentIds.empty());
+    // 42 character pages + 7 location pages
+    EXPECT_EQ(fakePtr_->totalRequestCount(), 49u);
+}
+
+TEST_F(DataStoreWarmupTest, PageProgressCountsUpToTotal) {
+    ApiClient client(std::move(fake_));
+    std::vector<size_t> progress;
+    size_t reportedTotal = 0;
+
+    client.fetchAllCharacters([&](size_t fetched, size_t total) {
+        progress.push_back(fetched);
+        reportedTotal = total;
+    });
+
+    ASSERT_EQ(progress.size(), 42u);
+    EXPECT_TRUE(std::is_sorted(progress.begin(), progress.end()));
+    EXPECT_EQ(progress.back(), static_cast<size_t>(CHARACTER_COUNT));
+    EXPECT_EQ(reportedTotal, static_cast<size_t>(CHARACTER_COUNT));
+}
+
+TEST_F(DataStoreWarmupTest, WarmedUpStoreServesEpisodesFromMemory) {
+    auto store = makeStore();
+    NiceMockDataObserver observer;
+    store->addObserver(&observer);
+
+    EXPECT_CALL(observer, onEpisodesLoaded(testing::HasEpisodeCount(EPISODE_COUNT)));
+    store->warmUp();
+
+    EXPECT_TRUE(store->isWarmedUp());
+    EXPECT_EQ(store->getCachedCharacterCount(), static_cast<size_t>(CHARACTER_COUNT));
+    EXPECT_EQ(store->getCachedLocationCount(), static_cast<size_t>(LOCATION_COUNT));
+    EXPECT_TRUE(store->getLocation(3).has_value());
+
+    ::testing::Mock::VerifyAndClearExpectations(&observer);
+
+    const size_t requestsAfterWarmup = fakePtr_->totalRequestCount();
+    EXPECT_CALL(observer, onEpisodesLoaded(testing::HasEpisodeCount(EPISODE_COUNT)));
+    EXPECT_CALL(observer, onCharactersLoaded(7, testing::HasCharacterCount(10)));
+    EXPECT_CALL(observer, onLoadingStateChanged(_)).Times(0);
+    for (int episodeId = 1; episodeId <= EPISODE_COUNT; ++episodeId) {
+        EXPECT_TRUE(store->areCharactersLoadedForEpisode(episodeId));
+    }
+    store->loadCharactersForEpisode(7);
+    store->loadAllEpisodes();
+
+    EXPECT_EQ(fakePtr_->totalRequestCount(), requestsAfterWarmup);
+    store->removeObserver(&observer);
+}
+
+TEST_F(DataStoreWarmupTest, LooksUpEveryEpisodeById) {
+    auto store = makeStore();
+    store->warmUp();
+
+    for (int id = 1; id <= EPISODE_COUNT; ++id) {
+        auto episode = store->getEpisode(id);
+        ASSERT_TRUE(episode.has_value()) << id;
+        EXPECT_EQ(episode->id, id);
+        EXPECT_EQ(store->getCharactersForEpisode(id).size(), episode->characterIds.size());
+    }
+    EXPECT_FALSE(store->getEpisode(0).has_value());
+    EXPECT_FALSE(store->getEpisode(EPISODE_COUNT + 1).has_value());
+    EXPECT_TRUE(store->getCharactersForEpisode(EPISODE_COUNT + 1).empty());
+}
+
+TEST_F(DataStoreWarmupTest, ReadsShareTheCachedRecords) {
+    auto store = makeStore();
+    store->warmUp();
+
+    const auto cast = store->getCharactersForEpisode(1);
+    ASSERT_FALSE(cast.empty());
+    EXPECT_EQ(cast.front(), store->getCharacter(cast.front()->id));
+    EXPECT_EQ(store->getCharactersForEpisode(1), cast);
+    EXPECT_EQ(store->getCharacter(CHARACTER_COUNT + 1), nullptr);
+
+    // Replacing a character leaves handles to the old record intact
+    const CharacterPtr held = store->getCharacter(1);
+    store->warmUp();
+    EXPECT_NE(store->getCharacter(1), held);
+    EXPECT_EQ(held->id, 1);
+    EXPECT_EQ(held->name, store->getCharacter(1)->name);
+}
+
+// Brute-force answers to the reverse queries, from everything the store holds
+class ReverseQueryOracle {
+public:
+    explicit ReverseQueryOracle(const DataStore& store)
+        : episodes_(store.getEpisodes()), characters_(store.getAllCachedCharacters()), store_(store) {}
+
+    std::vector<int> episodeIdsFor(int characterId) const {
+        std::set<int> ids;
+        for (const auto& e : episodes_) {
+            if (std::count(e.characterIds.begin(), e.characterIds.end(), characterId)) ids.insert(e.id);
+        }
+        for (const auto& c : characters_) {
+            if (c->id == characterId) ids.insert(c->episodeIds.begin(), c->episodeIds.end());
+        }
+        return {ids.begin(), ids.end()};
+    }
+
+    std::set<int> residentIdsOf(int locationId) const {
+        std::set<int> ids;
+        if (auto location = store_.getLocation(locationId)) {
+            for (int id : location->residentIds) {
+                if (store_.getCharacter(id)) ids.insert(id);
+            }
+        }
+        for (const auto& c : characters_) {
+            if (c->location.id == locationId) ids.insert(c->id);
+        }
+        return ids;
+    }
+
+    std::set<int> originIdsOf(int locationId) const {
+        std::set<int> ids;
+        for (const auto& c : characters_) {
+            if (c->origin.id == locationId) ids.insert(c->id);
+        }
+        return ids;
+    }
+
+private:
+    std::vector<Episode> episodes_;
+    std::vector<CharacterPtr> characters_;
+    const DataStore& store_;
+};
+
+int idOf(const Episode& episode) { return episode.id; }
+int idOf(const CharacterPtr& character) { return character->id; }
+
+bool nameLess(const CharacterPtr& a, const CharacterPtr& b) { return *a < *b; }
+
+template<typename T>
+std::vector<int> idsOf(const std::vector<T>& items) {
+    std::vector<int> ids;
+    for (const auto& item : items) ids.push_back(idOf(item));
+    return ids;
+}
+
+template<typename T>
+std::set<int> idSetOf(const std::vector<T>& items) {
+    const auto ids = idsOf(items);
+    return {ids.begin(), ids.end()};
+}
+
+void expectReverseQueriesMatch(const DataStore& store) {
+    const ReverseQueryOracle oracle(store);
+    for (int id : {1, 7, 100, 413, CHARACTER_COUNT}) {
+        EXPECT_EQ(idsOf(store.getEpisodesForCharacter(id)), oracle.episodeIdsFor(id)) << "character " << id;
+    }
+    for (int id : {1, 3, 20, LOCATION_COUNT}) {
+        const auto residents = store.getResidentsOfLocation(id);
+        EXPECT_EQ(idSetOf(residents), oracle.residentIdsOf(id)) << "location " << id;
+        EXPECT_TRUE(std::is_sorted(residents.begin(), residents.end(), nameLess)) << "location " << id;
+        EXPECT_EQ(idSetOf(store.getCharactersFromOrigin(id)), oracle.originIdsOf(id)) << "location " << id;
+    }
+}
+
+TEST_F(DataStoreWarmupTest, ReverseQueriesMatchScanningEveryRecord) {
+    auto store = makeStore();
+    store->warmUp();
+
+    EXPECT_FALSE(store->getEpisodesForCharacter(1).empty());
+    EXPECT_FALSE(store->getResidentsOfLocation(3).empty());
+    EXPECT_TRUE(store->getEpisodesForCharacter(CHARACTER_COUNT + 1).empty());
+    EXPECT_TRUE(store->getCharactersFromOrigin(LOCATION_COUNT).empty());
+    expectReverseQueriesMatch(*store);
+}
+
+TEST_F(DataStoreWarmupTest, ReverseIndexesStayConsistentWhenCharactersAreReplaced) {
+    auto store = makeStore();
+    store->warmUp();
+    store->warmUp();  // Replaces every cached character with a fresh copy
+
+    expectReverseQueriesMatch(*store);
+}
+
+TEST_F(DataStoreWarmupTest, HeldSnapshotIsUnchangedByLaterLoads) {
+    auto store = makeStore();
+    store->loadAllEpisodes();
+    const auto before = store->snapshot();
+
+    store->warmUp();
+    const auto after = store->snapshot();
+
+    EXPECT_GT(after->version(), before->version());
+    EXPECT_FALSE(before->warmedUp());
+    EXPECT_EQ(before->characters().size(), 0u);
+    EXPECT_EQ(before->locationCount(), 0u);
+    EXPECT_FALSE(before->charactersLoadedForEpisode(1));
+    EXPECT_TRUE(before->charactersForEpisode(1).empty());
+
+    EXPECT_TRUE(after->warmedUp());
+    EXPECT_EQ(after->characters().size(), static_cast<size_t>(CHARACTER_COUNT));
+    // Warmup found the episodes loaded, so both versions share one copy
+    EXPECT_EQ(&before->episodes(), &after->episodes());
+}
+
+TEST_F(DataStoreWarmupTest, ReadersSeeWholeVersionsDuringBackgroundWarmup) {
+    auto store = makeStore();
+    std::atomic<bool> done{false};
+    std::vector<std::string> problems;
+
+    std::thread reader([&]() {
+        uint64_t lastVersion = 0;
+        while (!done) {
+            const auto current = store->snapshot();
+            if (current->version() < lastVersion) {
+                problems.push_back("version went backwards");
+            }
+            lastVersion = current->version();
+            // Each stage is published at once, never page by page
+            const size_t characters = current->characters().size();
+            if (characters != 0 && characters != static_cast<size_t>(CHARACTER_COUNT)) {
+                problems.push_back("partial character set: " + std::to_string(characters));
+            }
+            if (current->warmedUp() && current->locationCount() != static_cast<size_t>(LOCATION_COUNT)) {
+                problems.push_back("warmed up without every location");
+            }
+            if (characters != 0 && current->charactersForEpisode(1).empty()) {
+                problems.push_back("cast missing from a version that has the characters");
+            }
+        }
+    });
+
+    store->startWarmup();
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    while (!store->isWarmedUp() && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    done = true;
+    reader.join();
+
+    EXPECT_TRUE(store->isWarmedUp());
+    EXPECT_THAT(problems, ::testing::IsEmpty());
+}
+
+TEST_F(DataStoreWarmupTest, ColumnScansMatchFilteringTheRecords) {
+    auto store = makeStore();
+    store->warmUp();
+
+    auto all = store->getAllCachedCharacters();
+    std::sort(all.begin(), all.end(), [](const CharacterPtr& a, const CharacterPtr& b) {
+        return a->name != b->name ? *a < *b : a->id < b->id;
+    });
+    auto idsWhere = [&all](auto predicate) {
+        std::vector<int> ids;
+        for (const auto& c : all) {
+            if (predicate(*c)) ids.push_back(c->id);
+        }
+        return ids;
+    };
+
+    EXPECT_EQ(idsOf(store->getCachedCharactersSortedByName()), idsWhere([](const Character&) { return true; }));
+    EXPECT_EQ(idsOf(store->getCachedCharactersWithStatus(CharacterStatus::Dead)),
+              idsWhere([](const Character& c) { return c.status == CharacterStatus::Dead; }));
+    const auto robots = store->getCachedCharactersOfSpecies("Robot");
+    EXPECT_EQ(robots.size(), static_cast<size_t>(CHARACTER_COUNT / 5));
+    EXPECT_EQ(idsOf(robots), idsWhere([](const Character& c) { return c.species == "Robot"; }));
+    EXPECT_TRUE(store->getCachedCharactersOfSpecies("Cronenberg").empty());
+}
+
+TEST_F(DataStoreWarmupTest, CompactFieldsSaveMemoryForTheFullCharacterSet) {
+    auto store = makeStore();
+    store->warmUp();
+
+    const CharacterMemoryReport report = store->getCharacterMemoryReport();
+
+    EXPECT_EQ(report.characters, static_cast<size_t>(CHARACTER_COUNT));
+    EXPECT_EQ(report.internedFields, 4u * CHARACTER_COUNT);
+    // Empty type, 5 species and 20 location names
+    EXPECT_LE(report.distinctStrings, 1u + 5u + 20u);
+    EXPECT_GT(report.stringBytes, report.internedBytes);
+    // Three URLs of 40-odd characters and a 24-character timestamp each
+    EXPECT_GT(report.derivedBytes, 4 * sizeof(std::string) * CHARACTER_COUNT);
+    EXPECT_EQ(report.bytesSaved(), report.stringBytes - report.internedBytes + report.derivedBytes);
+}
+
+TEST_F(DataStoreWarmupTest, ReportsProgressPerStageAndFinishesWithDone) {
+    auto store = makeStore();
+    NiceMockDataObserver observer;
+    store->addObserver(&observer);
+
+    std::vector<WarmupProgress> reports;
+    ON_CALL(observer, onWarmupProgress(_)).WillByDefault([&](const WarmupProgress& p) {
+        reports.push_back(p);
+    });
+    store->warmUp();
+    store->removeObserver(&observer);
+
+    ASSERT_FALSE(reports.empty());
+    EXPECT_EQ(reports.front().stage, WarmupProgress::Stage::Episodes);
+    EXPECT_EQ(reports.back().stage, WarmupProgress::Stage::Done);
+    EXPECT_EQ(reports.back().loaded, static_cast<size_t>(EPISODE_COUNT + CHARACTER_COUNT + LOCATION_COUNT));
+
+    size_t characterPages = 0;
+    for (const auto& p : reports) {
+        if (p.stage == WarmupProgress::Stage::Characters) {
+            ++characterPages;
+            EXPECT_EQ(p.total, static_cast<size_t>(CHARACTER_COUNT));
+        }
+    }
+    EXPECT_EQ(characterPages, 42u);
+}
+
+TEST_F(DataStoreWarmupTest, FailureIsReportedAsError) {
+    fake_->simulateErrorForUrl("https://rickandmortyapi.com/api/character?page=5",
+                               HttpException::Type::Timeout, "timed out");
+    auto store = makeStore();
+    NiceMockDataObserver observer;
+    store->addObserver(&observer);
+
+    EXPECT_CALL(observer, onError(_));
+    store->warmUp();
+
+    EXPECT_FALSE(store->isWarmedUp());
+    store->removeObserver(&observer);
+}
+
+TEST_F(DataStoreWarmupTest, BackgroundWarmupCompletes) {
+    auto store = makeStore();
+
+    store->startWarmup();
+    store->startWarmup();  // Second call is ignored
+
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    while (!store->isWarmedUp() && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    EXPECT_TRUE(store->isWarmedUp());
+}
+
+TEST_F(DataStoreWarmupTest, DestroyingStoreCancelsWarmup) {
+    fake_->simulateLatency(std::chrono::milliseconds(20));
+    auto store = makeStore();
+    NiceMockDataObserver observer;
+    store->addObserver(&observer);
+    EXPECT_CALL(observer, onError(_)).Times(0);
+
+    store->startWarmup();
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+    const auto start = std::chrono::steady_clock::now();
+    store.reset();
+    // The full walk takes over 150 ms even in parallel; cancellation stops after
+    // the pages already in flight
+    EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(150));
+}
+
+}  // namespace
+}  // namespace rickmorty
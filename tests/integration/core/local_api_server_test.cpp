@@ -0,0 +1,169 @@
+#include <gtest/gtest.h>
+
+// LocalApiServer uses POSIX sockets
+#ifndef _WIN32
+
+#include <chrono>
+#include "core/ApiClient.h"
+#include "core/CurlHttpClient.h"
+#include "core/RateLimitedHttpClient.h"
+#include "server/LocalApiServer.h"
+
+namespace rickmorty {
+namespace {
+
+using testing::LocalApiServer;
+
+/**
+ * End-to-end tests: ApiClient over the real CurlHttpClient against the local
+ * stand-in server, so the full transport path (sockets, keep-alive, chunked
+ * bodies, status handling) runs without network access.
+ */
+class LocalApiServerTest : public ::testing::Test {
+protected:
+    std::unique_ptr<ApiClient> makeClient(std::unique_ptr<IHttpClient> http = std::make_unique<CurlHttpClient>()) {
+        auto client = std::make_unique<ApiClient>(std::move(http));
+        client->setBaseUrl(server_.baseUrl());
+        return client;
+    }
+
+    static double elapsedMs(std::chrono::steady_clock::time_point start) {
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    LocalApiServer server_;
+};
+
+TEST_F(LocalApiServerTest, FetchAllEpisodesFollowsPagination) {
+    server_.addSyntheticEpisodes(51);
+    auto client = makeClient();
+
+    auto episodes = client->fetchAllEpisodes();
+
+    ASSERT_EQ(episodes.size(), 51u);
+    for (size_t i = 0; i < episodes.size(); ++i) {
+        EXPECT_EQ(episodes[i].id, static_cast<int>(i) + 1);
+    }
+    EXPECT_EQ(server_.stats().requests, 3u);
+}
+
+TEST_F(LocalApiServerTest, SerialPaginationUsesServedNextLinks) {
+    server_.addSyntheticEpisodes(45).setPageSize(10);
+    auto client = makeClient();
+    client->setMaxConcurrentRequests(1);
+
+    EXPECT_EQ(client->fetchAllEpisodes().size(), 45u);
+    EXPECT_EQ(server_.stats().requests, 5u);
+    EXPECT_EQ(server_.stats().connections, 1u);
+}
+
+TEST_F(LocalApiServerTest, ServesFixturesWithMultiGet) {
+    server_.loadFixtures();
+    auto client = makeClient();
+
+    auto characters = client->fetchCharacters({1, 2, 3, 999});
+    ASSERT_EQ(characters.size(), 3u);
+    EXPECT_EQ(characters[0].name, "Rick Sanchez");
+
+    auto episode = client->fetchEpisode(1);
+    ASSERT_TRUE(episode.has_value());
+    EXPECT_EQ(episode->name, "Pilot");
+    // Only the id is kept; url() names the canonical API whichever server served it
+    EXPECT_EQ(episode->id, 1);
+    EXPECT_EQ(episode->url(), "https://rickandmortyapi.com/api/episode/1");
+    EXPECT_FALSE(episode->characterIds.empty());
+
+    EXPECT_FALSE(client->fetchEpisode(999).has_value());
+    EXPECT_TRUE(client->fetchLocation(1).has_value());
+}
+
+TEST_F(LocalApiServerTest, InjectedFailuresSurfaceAsNetworkErrors) {
+    server_.addSyntheticEpisodes(5);
+    server_.failNext(1, 503);
+    auto client = makeClient();
+
+    try {
+        client->fetchEpisode(1);
+        FAIL() << "Expected ApiException";
+    } catch (const ApiException& e) {
+        EXPECT_EQ(e.type(), ApiException::Type::NetworkError);
+    }
+    EXPECT_TRUE(client->fetchEpisode(1).has_value());
+    EXPECT_EQ(server_.stats().injectedFailures, 1u);
+}
+
+TEST_F(LocalApiServerTest, RetryAfterReachesHttpException) {
+    server_.addSyntheticEpisodes(1);
+    server_.failNext(1, 429, 3);
+    CurlHttpClient http;
+
+    try {
+        http.get(server_.baseUrl() + "/episode/1");
+        FAIL() << "Expected HttpException";
+    } catch (const HttpException& e) {
+        EXPECT_EQ(e.httpCode(), 429);
+        EXPECT_EQ(e.retryAfterMs(), 3000);
+    }
+}
+
+TEST_F(LocalApiServerTest, RateLimiterRetriesServerErrors) {
+    server_.addSyntheticEpisodes(5);
+    LocalApiServer::Behavior behavior;
+    behavior.failEveryNth = 2;
+    server_.setBehavior(behavior);
+
+    RateLimitedHttpClient::Policy policy;
+    policy.baseBackoff = std::chrono::milliseconds(1);
+    auto client = makeClient(std::make_unique<RateLimitedHttpClient>(std::make_unique<CurlHttpClient>(), policy));
+
+    for (int id = 1; id <= 5; ++id) {
+        EXPECT_TRUE(client->fetchEpisode(id).has_value());
+    }
+    EXPECT_GT(server_.stats().injectedFailures, 0u);
+}
+
+TEST_F(LocalApiServerTest, ChunkedBodiesAreReassembled) {
+    server_.addSyntheticCharacters(100);
+    LocalApiServer::Behavior behavior;
+    behavior.chunked = true;
+    server_.setBehavior(behavior);
+    auto client = makeClient();
+
+    std::vector<int> ids;
+    for (int id = 1; id <= 100; ++id) {
+        ids.push_back(id);
+    }
+    EXPECT_EQ(client->fetchCharacters(ids).size(), 100u);
+}
+
+TEST_F(LocalApiServerTest, LatencyAndBandwidthAreApplied) {
+    server_.serveStatic("/payload", std::string(20000, 'x'));
+    LocalApiServer::Behavior behavior;
+    behavior.latency = std::chrono::milliseconds(30);
+    behavior.bandwidthBytesPerSecond = 200000;  // 20 KB takes ~100 ms
+    server_.setBehavior(behavior);
+    CurlHttpClient http;
+
+    const auto start = std::chrono::steady_clock::now();
+    EXPECT_EQ(http.get("http://127.0.0.1:" + std::to_string(server_.port()) + "/payload").size(), 20000u);
+    EXPECT_GE(elapsedMs(start), 120.0);
+}
+
+TEST_F(LocalApiServerTest, ConnectionCloseForcesNewConnections) {
+    server_.addSyntheticEpisodes(3);
+    LocalApiServer::Behavior behavior;
+    behavior.keepAlive = false;
+    server_.setBehavior(behavior);
+    CurlHttpClient http;
+
+    for (int id = 1; id <= 3; ++id) {
+        http.get(server_.baseUrl() + "/episode/" + std::to_string(id));
+    }
+    EXPECT_EQ(server_.stats().connections, 3u);
+    EXPECT_EQ(http.connectionStats().newConnections, 3u);
+}
+
+} // namespace
+} // namespace rickmorty
+
+#endif // _WIN32
@@ -0,0 +1,206 @@
+#include <gtest/gtest.h>
+
+// LocalApiServer uses POSIX sockets
+#ifndef _WIN32
+
+#include <cstdlib>
+#include <new>
+#include <string>
+#include "core/CachingHttpClient.h"
+#include "core/CoalescingHttpClient.h"
+#include "core/CurlHttpClient.h"
+#include "core/RateLimitedHttpClient.h"
+#include "core/ResponseBuffer.h"
+#include "server/LocalApiServer.h"
+
+namespace {
+
+// Counts operator new calls made by the current thread while tracking is on
+thread_local bool trackAllocations = false;
+thread_local size_t allocationCount = 0;
+
+} // namespace
+
+// Replacement operators pair malloc/free themselves; GCC cannot see that when inlining
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+
+void* operator new(std::size_t size) {
+    if (trackAllocations) {
+        ++allocationCount;
+    }
+    if (void* p = std::malloc(size ? size : 1)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size) {
+    return ::operator new(size);
+}
+
+void operator delete(void* p) noexcept {
+    std::free(p);
+}
+
+void operator delete[](void* p) noexcept {
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept {
+    std::free(p);
+}
+
+void operator delete[](void* p, std::size_t) noexcept {
+    std::free(p);
+}
+
+namespace rickmorty {
+namespace {
+
+using testing::LocalApiServer;
+
+std::string characterBatchUrl(const LocalApiServer& server) {
+    std::string url = server.baseUrl() + "/character/";
+    for (int id = 1; id <= 20; ++id) {
+        url += (id > 1 ? "," : "") + std::to_string(id);
+    }
+    return url;
+}
+
+TEST(TransportAllocationTest, SteadyStateRequestsDoNotAllocate) {
+    LocalApiServer server;
+    server.addSyntheticCharacters(20);
+    const std::string url = characterBatchUrl(server);
+
+    CurlHttpClient client;
+    ResponseBuffer buffer;
+
+    // Warm up: pooled handle, live connection and buffer capacity
+    for (int i = 0; i < 3; ++i) {
+        client.get(url, buffer);
+    }
+    const std::string expected(buffer.view());
+
+    trackAllocations = true;
+    allocationCount = 0;
+    for (int i = 0; i < 20; ++i) {
+        client.get(url, buffer);
+    }
+    trackAllocations = false;
+
+    EXPECT_EQ(allocationCount, 0u) << "operator new calls in 20 warm requests";
+    EXPECT_EQ(buffer.view(), expected);
+    EXPECT_EQ(client.connectionStats().newConnections, 1u);
+}
+
+TEST(TransportAllocationTest, BodyIsReservedFromContentLength) {
+    const std::string body(50000, 'x');
+    LocalApiServer server;
+    server.serveStatic("/big", body);
+
+    CurlHttpClient client;
+    std::string response;
+    client.getInto("http://127.0.0.1:" + std::to_string(server.port()) + "/big", response);
+
+    EXPECT_EQ(response.size(), body.size());
+    // Growing chunk by chunk would end at a doubled capacity (65536 or more);
+    // a single reserve lands on the body size, give or take allocator rounding
+    EXPECT_LT(response.capacity(), body.size() + 64);
+}
+
+TEST(TransportAllocationTest, PooledBufferKeepsCapacityAcrossRequests) {
+    LocalApiServer server;
+    server.addSyntheticCharacters(20);
+    CurlHttpClient client;
+
+    size_t capacity = 0;
+    {
+        ResponseBuffer first;
+        client.get(characterBatchUrl(server), first);
+        capacity = first.str().capacity();
+    }
+
+    ResponseBuffer second;
+    EXPECT_TRUE(second.empty());
+    EXPECT_GE(second.str().capacity(), capacity);
+}
+
+// The stack main.cpp builds; every layer has to pass the caller's buffer down
+std::unique_ptr<IHttpClient> appStack() {
+    return std::make_unique<CoalescingHttpClient>(
+        std::make_unique<CachingHttpClient>(
+            std::make_unique<RateLimitedHttpClient>(std::make_unique<CurlHttpClient>())));
+}
+
+TEST(TransportAllocationTest, DecoratorStackWritesIntoTheCallersBuffer) {
+    const std::string body(50000, 'x');
+    LocalApiServer server;
+    server.serveStatic("/big", body);
+    const std::string url = "http://127.0.0.1:" + std::to_string(server.port()) + "/big";
+    auto client = appStack();
+
+    std::string response;
+    client->getInto(url, response);
+    EXPECT_EQ(response, body);
+    EXPECT_LT(response.capacity(), body.size() + 64);   // Reserved from Content-Length
+
+    // A fresh body per request would move the storage every time
+    const char* storage = response.data();
+    for (int i = 0; i < 3; ++i) {
+        client->getInto(url, response);
+        EXPECT_EQ(response.data(), storage);
+    }
+    EXPECT_EQ(response, body);
+}
+
+// Serves one body with an ETag, and 304 whenever that ETag comes back
+class RevalidatingServer : public IHttpClient {
+public:
+    explicit RevalidatingServer(std::string body) : body_(std::move(body)) {}
+
+    std::string get(const std::string&) override { return body_; }
+
+    void getConditionalInto(const std::string&, const HttpValidators& validators,
+                            HttpResponse& response) override {
+        response.validators = HttpValidators{};
+        if (validators.etag == ETAG) {
+            response.status = 304;
+            response.body.clear();
+            return;
+        }
+        response.status = 200;
+        response.body.assign(body_);
+        response.validators.etag = ETAG;
+    }
+
+private:
+    static constexpr const char* ETAG = "\"v1\"";
+    std::string body_;
+};
+
+TEST(TransportAllocationTest, RevalidationCopiesTheCachedBodyOnlyIntoTheCallersBuffer) {
+    const std::string body(50000, 'x');
+    const std::string url = "https://example.test/big";
+    CachingHttpClient client(std::make_unique<RevalidatingServer>(body));
+    std::string response;
+    client.getInto(url, response);
+    ASSERT_EQ(client.stats().memoryEntries, 1u);
+
+    trackAllocations = true;
+    allocationCount = 0;
+    for (int i = 0; i < 5; ++i) {
+        client.getInto(url, response);
+    }
+    trackAllocations = false;
+
+    EXPECT_EQ(allocationCount, 0u) << "operator new calls in 5 revalidated requests";
+    EXPECT_EQ(client.stats().notModified, 5u);
+    EXPECT_EQ(response, body);
+}
+
+} // namespace
+} // namespace rickmorty
+
+#endif // _WIN32
@@ -27,9 +27,10 @@ public:
 
     // Mock all IDataObserver interface methods
     MOCK_METHOD(void, onEpisodesLoaded, (const std::vector<Episode>& episodes), (override));
-    MOCK_METHOD(void, onCharactersLoaded, (int episodeId, const std::vector<Character>& characters), (override));
+    MOCK_METHOD(void, onCharactersLoaded, (int episodeId, const std::vector<CharacterPtr>& characters), (override));
     MOCK_METHOD(void, onLoadingStateChanged, (bool isLoading), (override));
     MOCK_METHOD(void, onError, (const std::string& message), (override));
+    MOCK_METHOD(void, onWarmupProgress, (const WarmupProgress& progress), (override));
 };
 
 // =============================================================================
@@ -48,7 +49,7 @@ MATCHER_P(ContainsEpisodeWithId, id,
           " episode with id " + std::to_string(id)) {
     const auto& episodes = arg;
     return std::any_of(episodes.begin(), episodes.end(),
-                       [id](const Episode& ep) { return ep.id == id; });
+                       [this](const Episode& ep) { return ep.id == id; });
 }
 
 /**
@@ -99,7 +100,7 @@ MATCHER_P(ContainsCharacterNamed, name,
           " character named '" + std::string(name) + "'") {
     const auto& characters = arg;
     return std::any_of(characters.begin(), characters.end(),
-                       [name](const Character& ch) { return ch.name == name; });
+                       [this](const CharacterPtr& ch) { return ch->name == name; });
 }
 
 /**
@@ -129,8 +130,8 @@ MATCHER(CharactersAreSortedByName,
         return true;
     }
     return std::is_sorted(characters.begin(), characters.end(),
-                          [](const Character& a, const Character& b) {
-                              return a.name < b.name;
+                          [](const CharacterPtr& a, const CharacterPtr& b) {
+                              return a->name < b->name;
                           });
 }
 
@@ -168,7 +169,7 @@ MATCHER_P(ContainsEpisodeWithCode, code,
           " episode with code '" + std::string(code) + "'") {
     const auto& episodes = arg;
     return std::any_of(episodes.begin(), episodes.end(),
-                       [code](const Episode& ep) { return ep.episodeCode == code; });
+                       [this](const Episode& ep) { return ep.episodeCode == code; });
 }
 
 /**
@@ -183,7 +184,7 @@ MATCHER_P(ContainsCharacterWithId, id,
           " character with id " + std::to_string(id)) {
     const auto& characters = arg;
     return std::any_of(characters.begin(), characters.end(),
-                       [id](const Character& ch) { return ch.id == id; });
+                       [this](const CharacterPtr& ch) { return ch->id == id; });
 }
 
 /**
@@ -198,7 +199,7 @@ MATCHER_P(ContainsCharacterWithStatus, status,
           " character with status " + statusToString(status)) {
     const auto& characters = arg;
     return std::any_of(characters.begin(), characters.end(),
-                       [status](const Character& ch) { return ch.status == status; });
+                       [this](const CharacterPtr& ch) { return ch->status == status; });
 }
 
 /**
@@ -213,10 +214,10 @@ MATCHER_P(AllEpisodesInSeason, season,
           " in season " + std::to_string(season)) {
     const auto& episodes = arg;
     if (episodes.empty()) {
-        return !negation;  // Empty vector matches "all" in positive case
+        return true;  // "All" holds vacuously; negation is applied by gmock
     }
     return std::all_of(episodes.begin(), episodes.end(),
-                       [season](const Episode& ep) { return ep.season == season; });
+                       [this](const Episode& ep) { return ep.season == season; });
 }
 
 /**
@@ -285,8 +286,8 @@ MATCHER_P(CharactersAreSortedWithCount, expectedCount,
         return true;
     }
     return std::is_sorted(characters.begin(), characters.end(),
-                          [](const Character& a, const Character& b) {
-                              return a.name < b.name;
+                          [](const CharacterPtr& a, const CharacterPtr& b) {
+                              return a->name < b->name;
                           });
 }
 
@@ -0,0 +1,446 @@
+#include "LocalApiServer.h"
+#include "fakes/SyntheticApiData.h"
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cctype>
+#include <fstream>
+#include <iterator>
+#include <sstream>
+#include <stdexcept>
+#include <nlohmann/json.hpp>
+
+#ifndef RICKMORTY_FIXTURE_DIR
+#define RICKMORTY_FIXTURE_DIR "tests/fixtures/json"
+#endif
+
+namespace rickmorty {
+namespace testing {
+
+namespace {
+
+#ifdef MSG_NOSIGNAL
+constexpr int SEND_FLAGS = MSG_NOSIGNAL;
+#else
+constexpr int SEND_FLAGS = 0;  // SO_NOSIGPIPE is set on the socket instead
+#endif
+
+constexpr const char* REAL_API_BASE = "https://rickandmortyapi.com/api";
+constexpr size_t CHUNK_SIZE = 8 * 1024;
+
+const char* reasonPhrase(int status) {
+    switch (status) {
+        case 200: return "OK";
+        case 404: return "Not Found";
+        case 429: return "Too Many Requests";
+        case 500: return "Internal Server Error";
+        case 502: return "Bad Gateway";
+        case 503: return "Service Unavailable";
+        default:  return "Error";
+    }
+}
+
+std::string readFile(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        throw std::runtime_error("LocalApiServer: cannot read fixture " + path);
+    }
+    return std::string(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+}
+
+// Adds every record of a fixture (object, array, or paginated page) keyed by id
+void addRecords(std::map<int, std::string>& items, const nlohmann::json& json) {
+    if (json.is_object() && json.contains("results")) {
+        addRecords(items, json.at("results"));
+    } else if (json.is_array()) {
+        for (const auto& record : json) {
+            addRecords(items, record);
+        }
+    } else if (json.is_object() && json.contains("id")) {
+        items[json.at("id").get<int>()] = json.dump();
+    }
+}
+
+std::string joinArray(const std::vector<const std::string*>& records) {
+    std::string out = "[";
+    for (size_t i = 0; i < records.size(); ++i) {
+        if (i > 0) {
+            out += ',';
+        }
+        out += *records[i];
+    }
+    out += ']';
+    return out;
+}
+
+std::string errorBody(const std::string& message) {
+    return nlohmann::json{{"error", message}}.dump();
+}
+
+} // namespace
+
+LocalApiServer::LocalApiServer() {
+    listenFd_ = ::socket(AF_INET, SOCK_STREAM, 0);
+    if (listenFd_ < 0) {
+        throw std::runtime_error("LocalApiServer: socket() failed");
+    }
+    int reuse = 1;
+    ::setsockopt(listenFd_, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    addr.sin_port = 0;
+    socklen_t len = sizeof(addr);
+    if (::bind(listenFd_, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0
+        || ::listen(listenFd_, 64) != 0
+        || ::getsockname(listenFd_, reinterpret_cast<sockaddr*>(&addr), &len) != 0) {
+        ::close(listenFd_);
+        throw std::runtime_error("LocalApiServer: cannot listen on 127.0.0.1");
+    }
+    port_ = ntohs(addr.sin_port);
+    acceptThread_ = std::thread(&LocalApiServer::acceptLoop, this);
+}
+
+LocalApiServer::~LocalApiServer() {
+    stopping_ = true;
+    acceptThread_.join();
+
+    std::vector<std::thread> threads;
+    {
+        std::lock_guard<std::mutex> lock(connectionsMutex_);
+        for (int fd : connectionFds_) {
+            ::shutdown(fd, SHUT_RDWR);
+        }
+        threads.swap(connectionThreads_);
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    ::close(listenFd_);
+}
+
+LocalApiServer& LocalApiServer::loadFixtures(const std::string& fixtureDir) {
+    const std::string dir = fixtureDir.empty() || fixtureDir.back() == '/' ? fixtureDir : fixtureDir + "/";
+    std::lock_guard<std::mutex> lock(dataMutex_);
+    addRecords(episodes_, nlohmann::json::parse(readFile(dir + "episodes/episode_page_1.json")));
+    addRecords(episodes_, nlohmann::json::parse(readFile(dir + "episodes/single_episode.json")));
+    addRecords(characters_, nlohmann::json::parse(readFile(dir + "characters/character_batch.json")));
+    addRecords(characters_, nlohmann::json::parse(readFile(dir + "characters/single_character.json")));
+    addRecords(locations_, nlohmann::json::parse(readFile(dir + "locations/single_location.json")));
+    return *this;
+}
+
+LocalApiServer& LocalApiServer::addSyntheticEpisodes(int count, int charactersPerEpisode) {
+    std::vector<int> characterIds;
+    for (int i = 1; i <= charactersPerEpisode; ++i) {
+        characterIds.push_back(i);
+    }
+    std::lock_guard<std::mutex> lock(dataMutex_);
+    for (int id = 1; id <= count; ++id) {
+        episodes_[id] = syntheticEpisodeJson(id, characterIds);
+    }
+    return *this;
+}
+
+LocalApiServer& LocalApiServer::addSyntheticCharacters(int count) {
+    std::lock_guard<std::mutex> lock(dataMutex_);
+    for (int id = 1; id <= count; ++id) {
+        characters_[id] = syntheticCharacterJson(id);
+    }
+    return *this;
+}
+
+LocalApiServer& LocalApiServer::setPageSize(int pageSize) {
+    std::lock_guard<std::mutex> lock(dataMutex_);
+    pageSize_ = std::max(1, pageSize);
+    return *this;
+}
+
+LocalApiServer& LocalApiServer::serveStatic(const std::string& path, std::string body) {
+    std::lock_guard<std::mutex> lock(dataMutex_);
+    staticRoutes_[path] = std::move(body);
+    return *this;
+}
+
+void LocalApiServer::setBehavior(const Behavior& behavior) {
+    std::lock_guard<std::mutex> lock(dataMutex_);
+    behavior_ = behavior;
+}
+
+LocalApiServer::Behavior LocalApiServer::behavior() const {
+    std::lock_guard<std::mutex> lock(dataMutex_);
+    return behavior_;
+}
+
+void LocalApiServer::failNext(int count, int status, int retryAfterSeconds) {
+    std::lock_guard<std::mutex> lock(dataMutex_);
+    failNextCount_ = count;
+    failNextStatus_ = status;
+    failNextRetryAfter_ = retryAfterSeconds;
+}
+
+std::string LocalApiServer::baseUrl() const {
+    return "http://127.0.0.1:" + std::to_string(port_) + "/api";
+}
+
+LocalApiServer::Stats LocalApiServer::stats() const {
+    Stats stats;
+    stats.requests = requests_.load();
+    stats.connections = connections_.load();
+    stats.injectedFailures = injectedFailures_.load();
+    stats.bytesSent = bytesSent_.load();
+    return stats;
+}
+
+std::string LocalApiServer::defaultFixtureDir() {
+    return RICKMORTY_FIXTURE_DIR;
+}
+
+bool LocalApiServer::waitReadable(int fd) {
+    while (!stopping_) {
+        pollfd pfd{fd, POLLIN, 0};
+        const int ready = ::poll(&pfd, 1, 50);
+        if (ready > 0) {
+            return true;
+        }
+        if (ready < 0) {
+            return false;
+        }
+    }
+    return false;
+}
+
+void LocalApiServer::acceptLoop() {
+    while (waitReadable(listenFd_)) {
+        const int fd = ::accept(listenFd_, nullptr, nullptr);
+        if (fd < 0) {
+            continue;
+        }
+        // Responses may be written in small throttled slices; don't let Nagle hold them back
+        int one = 1;
+        ::setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+#ifdef SO_NOSIGPIPE
+        ::setsockopt(fd, SOL_SOCKET, SO_NOSIGPIPE, &one, sizeof(one));
+#endif
+        connections_++;
+
+        std::lock_guard<std::mutex> lock(connectionsMutex_);
+        connectionFds_.push_back(fd);
+        connectionThreads_.emplace_back(&LocalApiServer::serveConnection, this, fd);
+    }
+}
+
+void LocalApiServer::serveConnection(int fd) {
+    std::string pending;
+    char chunk[4096];
+    bool open = true;
+
+    while (open && waitReadable(fd)) {
+        const ssize_t n = ::recv(fd, chunk, sizeof(chunk), 0);
+        if (n <= 0) {
+            break;
+        }
+        pending.append(chunk, static_cast<size_t>(n));
+
+        // GET requests carry no body, so every header block is one request
+        size_t end;
+        while (open && (end = pending.find("\r\n\r\n")) != std::string::npos) {
+            const std::string head = pending.substr(0, end);
+            pending.erase(0, end + 4);
+
+            const size_t methodEnd = head.find(' ');
+            const size_t targetEnd = head.find(' ', methodEnd + 1);
+            if (methodEnd == std::string::npos || targetEnd == std::string::npos) {
+                open = false;
+                break;
+            }
+            const std::string target = head.substr(methodEnd + 1, targetEnd - methodEnd - 1);
+            const uint64_t number = ++requests_;
+
+            Behavior behavior;
+            Response response;
+            {
+                std::lock_guard<std::mutex> lock(dataMutex_);
+                behavior = behavior_;
+                if (failNextCount_ > 0) {
+                    failNextCount_--;
+                    response = Response{failNextStatus_, errorBody("Injected failure"), failNextRetryAfter_};
+                } else if (behavior.failEveryNth > 0 && number % static_cast<uint64_t>(behavior.failEveryNth) == 0) {
+                    response = Response{behavior.failStatus, errorBody("Injected failure"), behavior.retryAfterSeconds};
+                }
+            }
+            if (response.status != 200) {
+                injectedFailures_++;
+            } else {
+                response = route(target);
+            }
+
+            if (behavior.latency.count() > 0) {
+                std::this_thread::sleep_for(behavior.latency);
+            }
+            send(fd, response, behavior, behavior.keepAlive);
+            open = behavior.keepAlive;
+        }
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(connectionsMutex_);
+        connectionFds_.erase(std::remove(connectionFds_.begin(), connectionFds_.end(), fd), connectionFds_.end());
+    }
+    ::close(fd);
+}
+
+LocalApiServer::Response LocalApiServer::route(const std::string& target) {
+    const size_t queryStart = target.find('?');
+    const std::string path = target.substr(0, queryStart);
+    const std::string query = queryStart == std::string::npos ? "" : target.substr(queryStart + 1);
+
+    std::lock_guard<std::mutex> lock(dataMutex_);
+    auto staticRoute = staticRoutes_.find(path);
+    if (staticRoute != staticRoutes_.end()) {
+        return Response{200, staticRoute->second, 0};
+    }
+
+    static const std::string prefix = "/api/";
+    if (path.compare(0, prefix.size(), prefix) != 0) {
+        return Response{404, errorBody("There is nothing here"), 0};
+    }
+    const std::string rest = path.substr(prefix.size());
+    const size_t slash = rest.find('/');
+    const std::string resource = rest.substr(0, slash);
+    const std::string ids = slash == std::string::npos ? "" : rest.substr(slash + 1);
+
+    const std::map<int, std::string>* items = nullptr;
+    if (resource == "episode") {
+        items = &episodes_;
+    } else if (resource == "character") {
+        items = &characters_;
+    } else if (resource == "location") {
+        items = &locations_;
+    } else {
+        return Response{404, errorBody("There is nothing here"), 0};
+    }
+
+    if (ids.empty()) {
+        return list(*items, resource, pageFromUrl(target));
+    }
+    return lookup(*items, resource, ids);
+}
+
+LocalApiServer::Response LocalApiServer::list(const std::map<int, std::string>& items,
+                                              const std::string& resource, int page) {
+    const int count = static_cast<int>(items.size());
+    const int pages = std::max(1, (count + pageSize_ - 1) / pageSize_);
+    if (page < 1 || page > pages) {
+        return Response{404, errorBody("There is nothing here"), 0};
+    }
+
+    std::vector<const std::string*> records;
+    auto it = items.begin();
+    std::advance(it, std::min(count, (page - 1) * pageSize_));
+    for (int i = 0; i < pageSize_ && it != items.end(); ++i, ++it) {
+        records.push_back(&it->second);
+    }
+
+    const std::string listUrl = baseUrl() + "/" + resource + "?page=";
+    nlohmann::json info = {
+        {"count", count},
+        {"pages", pages},
+        {"next", page < pages ? nlohmann::json(listUrl + std::to_string(page + 1)) : nlohmann::json(nullptr)},
+        {"prev", page > 1 ? nlohmann::json(listUrl + std::to_string(page - 1)) : nlohmann::json(nullptr)},
+    };
+    return Response{200, withLocalUrls("{\"info\":" + info.dump() + ",\"results\":" + joinArray(records) + "}"), 0};
+}
+
+LocalApiServer::Response LocalApiServer::lookup(const std::map<int, std::string>& items,
+                                                const std::string& resource, const std::string& ids) {
+    const bool multi = ids.find(',') != std::string::npos;
+    std::vector<const std::string*> records;
+
+    std::istringstream stream(ids);
+    std::string token;
+    while (std::getline(stream, token, ',')) {
+        try {
+            auto it = items.find(std::stoi(token));
+            if (it != items.end()) {
+                records.push_back(&it->second);
+            }
+        } catch (const std::exception&) {
+            // Like the real API, unparsable ids are skipped in multi-gets
+        }
+    }
+
+    if (multi) {
+        return Response{200, withLocalUrls(joinArray(records)), 0};
+    }
+    if (records.empty()) {
+        std::string name = resource;
+        name[0] = static_cast<char>(std::toupper(static_cast<unsigned char>(name[0])));
+        return Response{404, errorBody(name + " not found"), 0};
+    }
+    return Response{200, withLocalUrls(*records.front()), 0};
+}
+
+void LocalApiServer::send(int fd, const Response& response, const Behavior& behavior, bool keepAlive) {
+    std::string wire = "HTTP/1.1 " + std::to_string(response.status) + " " + reasonPhrase(response.status) + "\r\n"
+        "Content-Type: application/json; charset=utf-8\r\n";
+    wire += keepAlive ? "Connection: keep-alive\r\n" : "Connection: close\r\n";
+    if (response.retryAfterSeconds > 0) {
+        wire += "Retry-After: " + std::to_string(response.retryAfterSeconds) + "\r\n";
+    }
+
+    if (behavior.chunked) {
+        wire += "Transfer-Encoding: chunked\r\n\r\n";
+        for (size_t offset = 0; offset < response.body.size(); offset += CHUNK_SIZE) {
+            const size_t size = std::min(CHUNK_SIZE, response.body.size() - offset);
+            std::ostringstream header;
+            header << std::hex << size << "\r\n";
+            wire += header.str();
+            wire.append(response.body, offset, size);
+            wire += "\r\n";
+        }
+        wire += "0\r\n\r\n";
+    } else {
+        wire += "Content-Length: " + std::to_string(response.body.size()) + "\r\n\r\n";
+        wire += response.body;
+    }
+
+    // Without a cap the whole response goes out at once; with one it is paced
+    // in slices against a fixed schedule so sleep overshoot does not accumulate
+    const size_t bandwidth = behavior.bandwidthBytesPerSecond;
+    const size_t slice = bandwidth == 0 ? wire.size() : std::max<size_t>(512, bandwidth / 1000);
+    const auto start = std::chrono::steady_clock::now();
+    size_t sent = 0;
+    while (sent < wire.size()) {
+        const size_t size = std::min(slice, wire.size() - sent);
+        // A slice leaves only once the schedule says its last byte is due
+        if (bandwidth > 0) {
+            std::this_thread::sleep_until(start + std::chrono::microseconds((sent + size) * 1000000 / bandwidth));
+        }
+        const ssize_t n = ::send(fd, wire.data() + sent, size, SEND_FLAGS);
+        if (n <= 0) {
+            return;
+        }
+        sent += static_cast<size_t>(n);
+        bytesSent_ += static_cast<uint64_t>(n);
+    }
+}
+
+std::string LocalApiServer::withLocalUrls(std::string json) const {
+    const std::string from = REAL_API_BASE;
+    const std::string to = baseUrl();
+    for (size_t pos = json.find(from); pos != std::string::npos; pos = json.find(from, pos + to.size())) {
+        json.replace(pos, from.size(), to);
+    }
+    return json;
+}
+
+} // namespace testing
+} // namespace rickmorty
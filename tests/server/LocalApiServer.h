@@ -0,0 +1,179 @@
+#pragma once
+
+/**
+ * @file LocalApiServer.h
+ * @brief Embedded HTTP/1.1 stand-in for the Rick and Morty API.
+ *
+ * FakeHttpClient replaces the transport entirely, so it cannot exercise
+ * CurlHttpClient (sockets, keep-alive, chunked bodies, header parsing).
+ * LocalApiServer listens on 127.0.0.1 on an ephemeral port and serves the
+ * fixture and synthetic JSON with the real API's URL shapes, so integration
+ * tests and benchmarks can drive the real client offline.
+ */
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace rickmorty {
+namespace testing {
+
+/**
+ * @class LocalApiServer
+ * @brief Deterministic local API server with latency, bandwidth and error injection.
+ *
+ * Routes (all under baseUrl(), i.e. http://127.0.0.1:<port>/api):
+ * - GET /episode, /character, /location         paginated list, "?page=N"
+ * - GET /episode/7                                single resource (404 if unknown)
+ * - GET /character/1,2,3                          multi-get, array of the known ids
+ * - any path registered with serveStatic()
+ *
+ * URLs inside served JSON (pagination links, character references) point at
+ * the server itself, so clients can follow them as they would the real API.
+ *
+ * Example usage:
+ * @code
+ * LocalApiServer server;
+ * server.loadFixtures().addSyntheticEpisodes(51);
+ * ApiClient client(std::make_unique<CurlHttpClient>());
+ * client.setBaseUrl(server.baseUrl());
+ * auto episodes = client.fetchAllEpisodes();
+ * @endcode
+ */
+class LocalApiServer {
+public:
+    /**
+     * @struct Behavior
+     * @brief Transport conditions applied to every response.
+     */
+    struct Behavior {
+        std::chrono::milliseconds latency{0};   ///< Delay before each response is sent
+        size_t bandwidthBytesPerSecond = 0;     ///< Send rate cap per connection; 0 = unlimited
+        bool chunked = false;                   ///< Transfer-Encoding: chunked instead of Content-Length
+        bool keepAlive = true;                  ///< Keep connections open between requests
+        int failEveryNth = 0;                   ///< Every Nth request fails with failStatus; 0 = never
+        int failStatus = 503;                   ///< Status used by failEveryNth
+        int retryAfterSeconds = 0;              ///< Retry-After sent with injected failures; 0 = none
+    };
+
+    /**
+     * @struct Stats
+     * @brief Counters for what the server has handled.
+     */
+    struct Stats {
+        uint64_t requests = 0;          ///< Requests parsed
+        uint64_t connections = 0;       ///< TCP connections accepted
+        uint64_t injectedFailures = 0;  ///< Responses replaced by an injected error
+        uint64_t bytesSent = 0;         ///< Response bytes written, headers included
+    };
+
+    /**
+     * @brief Binds 127.0.0.1 on an ephemeral port and starts serving an empty dataset.
+     * @throws std::runtime_error if the socket cannot be set up.
+     */
+    LocalApiServer();
+
+    /**
+     * @brief Stops accepting, closes open connections and joins all threads.
+     */
+    ~LocalApiServer();
+
+    LocalApiServer(const LocalApiServer&) = delete;
+    LocalApiServer& operator=(const LocalApiServer&) = delete;
+
+    /**
+     * @brief Adds the records from the JSON fixtures (episodes, characters, location).
+     * @param fixtureDir Directory laid out like tests/fixtures/json.
+     * @throws std::runtime_error if a fixture file cannot be read.
+     */
+    LocalApiServer& loadFixtures(const std::string& fixtureDir = defaultFixtureDir());
+
+    /**
+     * @brief Adds episodes 1..count built by syntheticEpisodeJson().
+     * @param charactersPerEpisode Character references per episode (ids 1..N).
+     */
+    LocalApiServer& addSyntheticEpisodes(int count, int charactersPerEpisode = 10);
+
+    /**
+     * @brief Adds characters 1..count built by syntheticCharacterJson().
+     */
+    LocalApiServer& addSyntheticCharacters(int count);
+
+    /**
+     * @brief Sets the number of results per list page (the real API uses 20).
+     */
+    LocalApiServer& setPageSize(int pageSize);
+
+    /**
+     * @brief Serves body verbatim (as JSON) for an exact path such as "/api/big".
+     */
+    LocalApiServer& serveStatic(const std::string& path, std::string body);
+
+    void setBehavior(const Behavior& behavior);
+    Behavior behavior() const;
+
+    /**
+     * @brief Makes the next count requests fail with status, regardless of Behavior.
+     * @param retryAfterSeconds Retry-After header value; 0 sends none.
+     */
+    void failNext(int count, int status, int retryAfterSeconds = 0);
+
+    /// Root URL of the API routes, e.g. http://127.0.0.1:40123/api
+    std::string baseUrl() const;
+    unsigned short port() const { return port_; }
+
+    Stats stats() const;
+
+    /// tests/fixtures/json in the source tree
+    static std::string defaultFixtureDir();
+
+private:
+    struct Response {
+        int status = 200;
+        std::string body;
+        int retryAfterSeconds = 0;
+    };
+
+    void acceptLoop();
+    void serveConnection(int fd);
+    bool waitReadable(int fd);
+    Response route(const std::string& target);
+    Response list(const std::map<int, std::string>& items, const std::string& resource, int page);
+    Response lookup(const std::map<int, std::string>& items, const std::string& resource,
+                    const std::string& ids);
+    void send(int fd, const Response& response, const Behavior& behavior, bool keepAlive);
+    std::string withLocalUrls(std::string json) const;
+
+    int listenFd_ = -1;
+    unsigned short port_ = 0;
+    std::atomic<bool> stopping_{false};
+    std::thread acceptThread_;
+
+    std::mutex connectionsMutex_;
+    std::vector<std::thread> connectionThreads_;
+    std::vector<int> connectionFds_;
+
+    mutable std::mutex dataMutex_;
+    std::map<int, std::string> episodes_;
+    std::map<int, std::string> characters_;
+    std::map<int, std::string> locations_;
+    std::map<std::string, std::string> staticRoutes_;
+    int pageSize_ = 20;
+    Behavior behavior_;
+    int failNextCount_ = 0;
+    int failNextStatus_ = 0;
+    int failNextRetryAfter_ = 0;
+
+    std::atomic<uint64_t> requests_{0};
+    std::atomic<uint64_t> connections_{0};
+    std::atomic<uint64_t> injectedFailures_{0};
+    std::atomic<uint64_t> bytesSent_{0};
+};
+
+} // namespace testing
+} // namespace rickmorty
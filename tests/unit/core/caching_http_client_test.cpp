@@ -0,0 +1,215 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include <filesystem>
+#include "core/CachingHttpClient.h"
+
+namespace rickmorty {
+namespace {
+
+/**
+ * @brief Origin double that honours If-None-Match like a real server.
+ *
+ * Serves one body per URL with an ETag derived from a version number, and
+ * records the validators it received on each request.
+ */
+class VersionedOrigin : public IHttpClient {
+public:
+    std::string get(const std::string& url) override {
+        return getConditional(url, {}).body;
+    }
+
+    HttpResponse getConditional(const std::string& url, const HttpValidators& validators) override {
+        received.push_back(validators);
+        auto it = bodies.find(url);
+        if (it == bodies.end()) {
+            throw HttpException(HttpException::Type::NotFound, "Resource not found", 404);
+        }
+
+        HttpResponse response;
+        response.validators.etag = withEtags ? "\"v" + std::to_string(version) + "\"" : "";
+        if (!validators.etag.empty() && validators.etag == response.validators.etag) {
+            response.status = 304;
+            return response;
+        }
+        response.body = it->second;
+        return response;
+    }
+
+    std::map<std::string, std::string> bodies;
+    std::vector<HttpValidators> received;
+    int version = 1;
+    bool withEtags = true;
+};
+
+class CachingHttpClientTest : public ::testing::Test {
+protected:
+    static constexpr const char* URL = "https://rickandmortyapi.com/api/episode";
+
+    void SetUp() override {
+        cacheDir_ = std::filesystem::temp_directory_path() /
+            ("rickmorty_http_cache_" + std::to_string(::testing::UnitTest::GetInstance()->random_seed()) +
+             "_" + ::testing::UnitTest::GetInstance()->current_test_info()->name());
+        std::filesystem::remove_all(cacheDir_);
+    }
+
+    void TearDown() override {
+        std::filesystem::remove_all(cacheDir_);
+    }
+
+    std::unique_ptr<VersionedOrigin> makeOrigin(const std::string& body) {
+        auto origin = std::make_unique<VersionedOrigin>();
+        origin->bodies[URL] = body;
+        return origin;
+    }
+
+    std::filesystem::path cacheDir_;
+};
+
+TEST_F(CachingHttpClientTest, FirstRequestSendsNoValidators) {
+    auto origin = makeOrigin("payload");
+    auto* originPtr = origin.get();
+    CachingHttpClient client(std::move(origin));
+
+    EXPECT_EQ(client.get(URL), "payload");
+
+    ASSERT_EQ(originPtr->received.size(), 1u);
+    EXPECT_TRUE(originPtr->received[0].empty());
+    EXPECT_EQ(client.stats().fullResponses, 1u);
+}
+
+TEST_F(CachingHttpClientTest, RevalidationServesCachedBodyOn304) {
+    auto origin = makeOrigin("payload");
+    auto* originPtr = origin.get();
+    CachingHttpClient client(std::move(origin));
+
+    client.get(URL);
+    EXPECT_EQ(client.get(URL), "payload");
+
+    ASSERT_EQ(originPtr->received.size(), 2u);
+    EXPECT_EQ(originPtr->received[1].etag, "\"v1\"");
+    EXPECT_EQ(client.stats().notModified, 1u);
+    EXPECT_EQ(client.stats().bytesSaved, 7u);
+}
+
+TEST_F(CachingHttpClientTest, ChangedResourceReplacesCachedBody) {
+    auto origin = makeOrigin("old");
+    auto* originPtr = origin.get();
+    CachingHttpClient client(std::move(origin));
+
+    client.get(URL);
+    originPtr->bodies[URL] = "new";
+    originPtr->version = 2;
+
+    EXPECT_EQ(client.get(URL), "new");
+    EXPECT_EQ(client.get(URL), "new");
+    EXPECT_EQ(originPtr->received.back().etag, "\"v2\"");
+    EXPECT_EQ(client.stats().fullResponses, 2u);
+    EXPECT_EQ(client.stats().notModified, 1u);
+}
+
+TEST_F(CachingHttpClientTest, ResponsesWithoutValidatorsAreNotCached) {
+    auto origin = makeOrigin("payload");
+    origin->withEtags = false;
+    auto* originPtr = origin.get();
+    CachingHttpClient client(std::move(origin));
+
+    client.get(URL);
+    client.get(URL);
+
+    EXPECT_TRUE(originPtr->received[1].empty());
+    EXPECT_EQ(client.stats().notModified, 0u);
+}
+
+TEST_F(CachingHttpClientTest, ErrorsPropagateUnchanged) {
+    CachingHttpClient client(std::make_unique<VersionedOrigin>());
+
+    try {
+        client.get(URL);
+        FAIL() << "Expected HttpException";
+    } catch (const HttpException& e) {
+        EXPECT_EQ(e.type(), HttpException::Type::NotFound);
+    }
+}
+
+TEST_F(CachingHttpClientTest, DiskCacheSurvivesRestart) {
+    {
+        CachingHttpClient client(makeOrigin("persisted body\nwith newline"), cacheDir_.string());
+        client.get(URL);
+    }
+
+    auto origin = makeOrigin("persisted body\nwith newline");
+    auto* originPtr = origin.get();
+    CachingHttpClient restarted(std::move(origin), cacheDir_.string());
+
+    EXPECT_EQ(restarted.get(URL), "persisted body\nwith newline");
+    EXPECT_EQ(originPtr->received[0].etag, "\"v1\"");
+    EXPECT_EQ(restarted.stats().notModified, 1u);
+}
+
+TEST_F(CachingHttpClientTest, FailedDiskWriteLeavesNoEntryBehind) {
+    auto origin = makeOrigin("payload");
+    auto* originPtr = origin.get();
+    CachingHttpClient client(std::move(origin), cacheDir_.string());
+    std::filesystem::remove_all(cacheDir_);   // Every write now fails
+
+    EXPECT_EQ(client.get(URL), "payload");
+    EXPECT_EQ(client.get(URL), "payload");   // Still revalidated from memory
+
+    EXPECT_FALSE(std::filesystem::exists(cacheDir_));
+    EXPECT_EQ(originPtr->received[1].etag, "\"v1\"");
+}
+
+TEST_F(CachingHttpClientTest, MemoryIsBoundedLeastRecentlyUsedFirst) {
+    auto origin = std::make_unique<VersionedOrigin>();
+    auto* originPtr = origin.get();
+    for (const char* url : {"https://a", "https://b", "https://c"}) {
+        origin->bodies[url] = std::string(100, 'x');
+    }
+    CachingHttpClient client(std::move(origin));
+    client.setMemoryBudget(250);   // Room for two entries
+
+    client.get("https://a");
+    client.get("https://b");
+    client.get("https://a");   // b is now the least recently used
+    client.get("https://c");
+
+    EXPECT_EQ(client.stats().memoryEntries, 2u);
+    EXPECT_LE(client.stats().memoryBytes, 250u);
+    client.get("https://b");
+    EXPECT_TRUE(originPtr->received.back().empty());   // Forgotten, so a plain GET
+    client.get("https://c");
+    EXPECT_EQ(originPtr->received.back().etag, "\"v1\"");
+}
+
+TEST_F(CachingHttpClientTest, EntriesEvictedFromMemoryAreReadFromDisk) {
+    auto origin = makeOrigin("payload");
+    auto* originPtr = origin.get();
+    CachingHttpClient client(std::move(origin), cacheDir_.string());
+    client.setMemoryBudget(0);
+
+    client.get(URL);
+    EXPECT_EQ(client.stats().memoryEntries, 0u);
+
+    EXPECT_EQ(client.get(URL), "payload");
+    EXPECT_EQ(originPtr->received[1].etag, "\"v1\"");
+    EXPECT_EQ(client.stats().notModified, 1u);
+}
+
+TEST_F(CachingHttpClientTest, ClearForgetsPersistedEntries) {
+    auto origin = makeOrigin("payload");
+    auto* originPtr = origin.get();
+    CachingHttpClient client(std::move(origin), cacheDir_.string());
+
+    client.get(URL);
+    client.clear();
+    client.get(URL);
+
+    EXPECT_TRUE(originPtr->received[1].empty());
+}
+
+TEST_F(CachingHttpClientTest, NullInnerClientThrows) {
+    EXPECT_THROW(CachingHttpClient(nullptr), HttpException);
+}
+
+}  // namespace
+}  // namespace rickmorty
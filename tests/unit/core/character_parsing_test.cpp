@@ -56,8 +56,9 @@ TEST_F(CharacterParsingTest, ParsesValidCharacterJson) {
     EXPECT_EQ(character.species, "Human");
     EXPECT_EQ(character.type, "");
     EXPECT_EQ(character.imageUrl, "https://rickandmortyapi.com/api/character/avatar/1.jpeg");
-    EXPECT_EQ(character.url, "https://rickandmortyapi.com/api/character/1");
-    EXPECT_EQ(character.created, "2017-11-04T18:48:46.250Z");
+    EXPECT_EQ(character.url(), "https://rickandmortyapi.com/api/character/1");
+    EXPECT_EQ(character.createdMs, 1509821326250);
+    EXPECT_EQ(formatTimestamp(character.createdMs), "2017-11-04T18:48:46.250Z");
 }
 
 TEST_F(CharacterParsingTest, ParsesCharacterWithTypeField) {
@@ -243,7 +244,7 @@ TEST_F(CharacterParsingTest, ParsesOriginLocationReference) {
     Character character = j.get<Character>();
 
     EXPECT_EQ(character.origin.name, "Earth (C-137)");
-    EXPECT_EQ(character.origin.url, "https://rickandmortyapi.com/api/location/1");
+    EXPECT_EQ(character.origin.url(), "https://rickandmortyapi.com/api/location/1");
     EXPECT_EQ(character.origin.id, 1);
 }
 
@@ -253,7 +254,7 @@ TEST_F(CharacterParsingTest, ParsesCurrentLocationReference) {
     Character character = j.get<Character>();
 
     EXPECT_EQ(character.location.name, "Citadel of Ricks");
-    EXPECT_EQ(character.location.url, "https://rickandmortyapi.com/api/location/3");
+    EXPECT_EQ(character.location.url(), "https://rickandmortyapi.com/api/location/3");
     EXPECT_EQ(character.location.id, 3);
 }
 
@@ -264,7 +265,7 @@ TEST_F(CharacterParsingTest, ParsesLocationWithEmptyUrl) {
     Character character = j.get<Character>();
 
     EXPECT_EQ(character.origin.name, "Earth (C-137)");
-    EXPECT_EQ(character.origin.url, "");
+    EXPECT_EQ(character.origin.url(), "");
     EXPECT_EQ(character.origin.id, -1);
 }
 
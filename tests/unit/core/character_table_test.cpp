@@ -0,0 +1,215 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include "core/CharacterTable.h"
+
+namespace rickmorty {
+namespace {
+
+Character makeCharacter(int id, const std::string& name, CharacterStatus status, const char* species) {
+    Character c;
+    c.id = id;
+    c.name = name;
+    c.status = status;
+    c.species = species;
+    c.gender = Gender::Male;
+    return c;
+}
+
+std::vector<int> idsOf(const CharacterTable& table, const std::vector<CharacterTable::Row>& rows) {
+    std::vector<int> ids;
+    for (auto row : rows) {
+        ids.push_back(table.record(row).id);
+    }
+    return ids;
+}
+
+class CharacterTableTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        table.upsert(makeCharacter(1, "Rick Sanchez", CharacterStatus::Alive, "Human"));
+        table.upsert(makeCharacter(2, "Morty Smith", CharacterStatus::Alive, "Human"));
+        table.upsert(makeCharacter(7, "Abradolf Lincler", CharacterStatus::Unknown, "Human"));
+        table.upsert(makeCharacter(47, "Birdperson", CharacterStatus::Dead, "Alien"));
+    }
+
+    CharacterTable table;
+};
+
+TEST_F(CharacterTableTest, FindsCharactersById) {
+    ASSERT_EQ(table.size(), 4u);
+    ASSERT_NE(table.find(47), nullptr);
+    EXPECT_EQ(table.find(47)->name, "Birdperson");
+    EXPECT_TRUE(table.contains(7));
+    EXPECT_FALSE(table.contains(3));
+    EXPECT_FALSE(table.contains(100000));
+    EXPECT_EQ(table.find(-1), nullptr);
+}
+
+TEST_F(CharacterTableTest, ColumnsMatchRecords) {
+    for (CharacterTable::Row row = 0; row < table.size(); ++row) {
+        const Character& c = table.record(row);
+        EXPECT_EQ(table.name(row), c.name);
+        EXPECT_EQ(table.status(row), c.status);
+        EXPECT_EQ(table.gender(row), c.gender);
+        EXPECT_EQ(table.speciesName(table.species(row)), c.species);
+    }
+    EXPECT_EQ(table.speciesCount(), 2u);
+}
+
+TEST_F(CharacterTableTest, UpsertReplacesInPlace) {
+    const auto row = table.findRow(2);
+    table.upsert(makeCharacter(2, "Evil Morty", CharacterStatus::Unknown, "Human"));
+
+    EXPECT_EQ(table.size(), 4u);
+    EXPECT_EQ(table.findRow(2), row);
+    EXPECT_EQ(table.name(*row), "Evil Morty");
+    EXPECT_EQ(table.status(*row), CharacterStatus::Unknown);
+    EXPECT_EQ(table.find(2)->name, "Evil Morty");
+}
+
+TEST_F(CharacterTableTest, RenamesKeepOtherNamesIntact) {
+    // Enough renames of one row to force the name arena to compact
+    for (int i = 0; i <= 48; ++i) {
+        table.upsert(makeCharacter(1, "Rick " + std::string(static_cast<size_t>(i % 7), 'C'),
+                                   CharacterStatus::Alive, "Human"));
+    }
+
+    EXPECT_EQ(table.name(*table.findRow(1)), "Rick CCCCCC");
+    EXPECT_EQ(table.name(*table.findRow(2)), "Morty Smith");
+    EXPECT_EQ(table.name(*table.findRow(7)), "Abradolf Lincler");
+    EXPECT_EQ(table.name(*table.findRow(47)), "Birdperson");
+}
+
+TEST_F(CharacterTableTest, FiltersByStatusAndSpecies) {
+    EXPECT_EQ(idsOf(table, table.rowsWithStatus(CharacterStatus::Alive)), (std::vector<int>{1, 2}));
+    EXPECT_EQ(idsOf(table, table.rowsWithStatus(CharacterStatus::Dead)), (std::vector<int>{47}));
+    EXPECT_EQ(idsOf(table, table.rowsWithSpecies("Human")), (std::vector<int>{1, 2, 7}));
+    EXPECT_TRUE(table.rowsWithSpecies("Robot").empty());
+}
+
+TEST_F(CharacterTableTest, SortsByNameLikeCharacterOrdering) {
+    // Same 8-byte prefix, so the full names decide; equal names fall back to id
+    table.upsert(makeCharacter(20, "Morty Smithers", CharacterStatus::Alive, "Human"));
+    table.upsert(makeCharacter(10, "Morty Smith", CharacterStatus::Dead, "Human"));
+    table.upsert(makeCharacter(30, "Mort", CharacterStatus::Dead, "Human"));
+
+    std::vector<CharacterPtr> expected = table.records();
+    std::stable_sort(expected.begin(), expected.end(), [](const CharacterPtr& a, const CharacterPtr& b) {
+        return a->name != b->name ? *a < *b : a->id < b->id;
+    });
+
+    std::vector<int> expectedIds;
+    for (const auto& c : expected) {
+        expectedIds.push_back(c->id);
+    }
+    EXPECT_EQ(idsOf(table, table.rowsSortedByName()), expectedIds);
+    EXPECT_EQ(expectedIds, (std::vector<int>{7, 47, 30, 2, 10, 20, 1}));
+}
+
+TEST_F(CharacterTableTest, RenamesReorderLaterSorts) {
+    EXPECT_EQ(idsOf(table, table.rowsSortedByName()), (std::vector<int>{7, 47, 2, 1}));
+
+    table.upsert(makeCharacter(1, "Adjudicator Rick", CharacterStatus::Alive, "Human"));
+    table.upsert(makeCharacter(3, "Zeep Xanflorp", CharacterStatus::Alive, "Alien"));
+
+    EXPECT_EQ(idsOf(table, table.rowsSortedByName()), (std::vector<int>{7, 1, 47, 2, 3}));
+    auto aliens = table.rowsWithSpecies("Alien");
+    table.sortByName(aliens);
+    EXPECT_EQ(idsOf(table, aliens), (std::vector<int>{47, 3}));
+}
+
+TEST_F(CharacterTableTest, RefreshedNameOrderIsUsedUntilNamesChange) {
+    const auto unrefreshed = table.rowsSortedByName();
+    table.refreshNameOrder();
+    EXPECT_EQ(table.rowsSortedByName(), unrefreshed);
+
+    // Stale ranks are ignored, not consulted
+    table.upsert(makeCharacter(47, "Aaa Alien", CharacterStatus::Alive, "Alien"));
+    EXPECT_EQ(idsOf(table, table.rowsSortedByName()), (std::vector<int>{47, 7, 2, 1}));
+
+    table.refreshNameOrder();
+    auto rows = table.rowsWithStatus(CharacterStatus::Alive);
+    table.sortByName(rows);
+    EXPECT_EQ(idsOf(table, rows).front(), 47);
+}
+
+TEST_F(CharacterTableTest, RefreshMergesChangedRowsIntoTheCachedOrder) {
+    table.refreshNameOrder();
+
+    // Additions, renames and removals, including of the row a removal moved
+    table.upsert(makeCharacter(3, "Summer Smith", CharacterStatus::Alive, "Human"));
+    table.upsert(makeCharacter(4, "Beth Smith", CharacterStatus::Alive, "Human"));
+    table.upsert(makeCharacter(1, "Adjudicator Rick", CharacterStatus::Alive, "Human"));
+    EXPECT_TRUE(table.remove(2));
+    table.upsert(makeCharacter(4, "Zeep Xanflorp", CharacterStatus::Alive, "Alien"));
+    EXPECT_TRUE(table.remove(7));
+    table.upsert(makeCharacter(5, "Jerry Smith", CharacterStatus::Alive, "Human"));
+    const auto fullSort = table.rowsSortedByName();
+
+    table.refreshNameOrder();
+
+    EXPECT_EQ(table.rowsSortedByName(), fullSort);
+    EXPECT_EQ(idsOf(table, fullSort), (std::vector<int>{1, 47, 5, 3, 4}));
+    auto rows = table.rowsWithStatus(CharacterStatus::Alive);
+    table.sortByName(rows);
+    EXPECT_EQ(idsOf(table, rows), (std::vector<int>{1, 5, 3, 4}));
+}
+
+TEST_F(CharacterTableTest, SelectReturnsRecordsInRowOrder) {
+    auto rows = table.rowsWithSpecies("Human");
+    table.sortByName(rows);
+
+    const auto selected = table.select(rows);
+
+    ASSERT_EQ(selected.size(), 3u);
+    EXPECT_EQ(selected[0]->name, "Abradolf Lincler");
+    EXPECT_EQ(selected[2]->name, "Rick Sanchez");
+    EXPECT_EQ(selected[2], table.find(1));
+}
+
+TEST_F(CharacterTableTest, HandlesOutliveReplacementAndAreSharedByCopies) {
+    const CharacterPtr before = table.find(1);
+    const CharacterTable copy = table;
+    EXPECT_EQ(copy.find(1), before);
+
+    table.upsert(makeCharacter(1, "Adjudicator Rick", CharacterStatus::Alive, "Human"));
+
+    EXPECT_EQ(before->name, "Rick Sanchez");
+    EXPECT_EQ(copy.find(1)->name, "Rick Sanchez");
+    EXPECT_EQ(table.find(1)->name, "Adjudicator Rick");
+    EXPECT_EQ(table.find(99), nullptr);
+}
+
+TEST_F(CharacterTableTest, RemoveMovesTheLastRowIntoTheGap) {
+    table.refreshNameOrder();
+    const size_t removedBytes = table.rowBytes(*table.findRow(2));
+    EXPECT_GT(removedBytes, sizeof(Character));
+
+    EXPECT_TRUE(table.remove(2));
+    EXPECT_FALSE(table.remove(2));
+
+    EXPECT_EQ(table.size(), 3u);
+    EXPECT_EQ(table.find(2), nullptr);
+    EXPECT_EQ(table.findRow(47), CharacterTable::Row{1});
+    EXPECT_EQ(table.name(*table.findRow(47)), "Birdperson");
+    EXPECT_EQ(idsOf(table, table.rowsSortedByName()), (std::vector<int>{7, 47, 1}));
+    EXPECT_EQ(idsOf(table, table.rowsWithStatus(CharacterStatus::Alive)), (std::vector<int>{1}));
+}
+
+TEST(CharacterTableSparseTest, AcceptsIdsOutsideTheDenseRange) {
+    CharacterTable table;
+    table.upsert(makeCharacter(-5, "Negative", CharacterStatus::Alive, "Human"));
+    table.upsert(makeCharacter(50000000, "Huge", CharacterStatus::Alive, "Human"));
+
+    ASSERT_NE(table.find(-5), nullptr);
+    ASSERT_NE(table.find(50000000), nullptr);
+    EXPECT_EQ(table.find(50000000)->name, "Huge");
+    EXPECT_EQ(table.size(), 2u);
+
+    EXPECT_TRUE(table.remove(-5));
+    EXPECT_EQ(table.find(-5), nullptr);
+    EXPECT_EQ(table.findRow(50000000), CharacterTable::Row{0});
+}
+
+}  // namespace
+}  // namespace rickmorty
@@ -0,0 +1,73 @@
+#include <gtest/gtest.h>
+#include "core/ClockEviction.h"
+
+namespace rickmorty {
+namespace {
+
+TEST(ClockEvictionTest, TracksResidentBytes) {
+    ClockEviction clock;
+    clock.insert(1, 100);
+    clock.insert(2, 50);
+    clock.insert(1, 70);   // Resized, not added twice
+
+    EXPECT_EQ(clock.size(), 2u);
+    EXPECT_EQ(clock.residentBytes(), 120u);
+
+    clock.erase(1);
+    clock.erase(99);
+    EXPECT_FALSE(clock.contains(1));
+    EXPECT_EQ(clock.residentBytes(), 50u);
+}
+
+TEST(ClockEvictionTest, NothingIsEvictedWithinBudget) {
+    ClockEviction clock;
+    clock.insert(1, 100);
+
+    EXPECT_TRUE(clock.evict(100).empty());
+    EXPECT_TRUE(clock.contains(1));
+}
+
+TEST(ClockEvictionTest, UsedEntriesGetASecondChance) {
+    ClockEviction clock;
+    for (int key = 1; key <= 4; ++key) {
+        clock.insert(key, 10);
+    }
+    // First sweep clears every bit and evicts 1; then only 3 is used again
+    EXPECT_EQ(clock.evict(30), (std::vector<int>{1}));
+    EXPECT_TRUE(clock.touch(3));
+    EXPECT_FALSE(clock.touch(1));
+
+    const auto victims = clock.evict(10);
+
+    EXPECT_EQ(victims.size(), 2u);
+    EXPECT_TRUE(clock.contains(3));
+    EXPECT_EQ(clock.residentBytes(), 10u);
+}
+
+TEST(ClockEvictionTest, PinnedEntriesAreSkipped) {
+    ClockEviction clock;
+    clock.insert(1, 10);
+    clock.insert(2, 10);
+    clock.insert(3, 10);
+
+    const auto victims = clock.evict(10, [](int key) { return key == 1; });
+
+    EXPECT_EQ(victims.size(), 2u);
+    EXPECT_TRUE(clock.contains(1));
+}
+
+TEST(ClockEvictionTest, StopsWhenOnlyPinnedEntriesRemain) {
+    ClockEviction clock;
+    clock.insert(1, 10);
+    clock.insert(2, 10);
+    clock.insert(3, 10);
+
+    const auto victims = clock.evict(0, [](int key) { return key != 3; });
+
+    EXPECT_EQ(victims, (std::vector<int>{3}));
+    EXPECT_EQ(clock.size(), 2u);
+    EXPECT_EQ(clock.residentBytes(), 20u);
+}
+
+}  // namespace
+}  // namespace rickmorty
@@ -0,0 +1,137 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <condition_variable>
+#include <future>
+#include <mutex>
+#include <thread>
+#include "core/CoalescingHttpClient.h"
+
+namespace rickmorty {
+namespace {
+
+/**
+ * @brief Origin double whose requests block until the test releases them.
+ *
+ * Lets a test hold the first request in flight while more callers arrive,
+ * so overlap does not depend on timing.
+ */
+class GatedOrigin : public IHttpClient {
+public:
+    std::string get(const std::string& url) override {
+        calls++;
+        std::unique_lock<std::mutex> lock(mutex_);
+        started_++;
+        cv_.notify_all();
+        cv_.wait(lock, [this] { return open_; });
+        if (fail) {
+            throw HttpException(HttpException::Type::InvalidResponse, "HTTP error: 500", 500);
+        }
+        return "body of " + url;
+    }
+
+    bool supportsConcurrentRequests() const override { return true; }
+
+    void waitUntilStarted(int count) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        cv_.wait(lock, [&] { return started_ >= count; });
+    }
+
+    void release() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        open_ = true;
+        cv_.notify_all();
+    }
+
+    std::atomic<int> calls{0};
+    bool fail = false;
+
+private:
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    int started_ = 0;
+    bool open_ = false;
+};
+
+constexpr const char* URL = "https://rickandmortyapi.com/api/character/1,2,3";
+
+/// Polls until the client reports the given number of joined callers
+void waitForDeduplicated(const CoalescingHttpClient& client, uint64_t count) {
+    while (client.stats().deduplicated < count) {
+        std::this_thread::yield();
+    }
+}
+
+TEST(CoalescingHttpClientTest, IdenticalInFlightRequestsShareOneNetworkCall) {
+    auto origin = std::make_unique<GatedOrigin>();
+    auto* originPtr = origin.get();
+    CoalescingHttpClient client(std::move(origin));
+
+    auto first = std::async(std::launch::async, [&] { return client.get(URL); });
+    originPtr->waitUntilStarted(1);
+    auto second = std::async(std::launch::async, [&] { return client.get(URL); });
+    auto third = std::async(std::launch::async, [&] { return client.get(URL); });
+    waitForDeduplicated(client, 2);
+    originPtr->release();
+
+    EXPECT_EQ(first.get(), std::string("body of ") + URL);
+    EXPECT_EQ(second.get(), std::string("body of ") + URL);
+    EXPECT_EQ(third.get(), std::string("body of ") + URL);
+    EXPECT_EQ(originPtr->calls, 1);
+
+    const auto stats = client.stats();
+    EXPECT_EQ(stats.requests, 3u);
+    EXPECT_EQ(stats.networkRequests, 1u);
+    EXPECT_EQ(stats.deduplicated, 2u);
+}
+
+TEST(CoalescingHttpClientTest, DifferentUrlsAreNotMerged) {
+    auto origin = std::make_unique<GatedOrigin>();
+    auto* originPtr = origin.get();
+    CoalescingHttpClient client(std::move(origin));
+
+    auto a = std::async(std::launch::async, [&] { return client.get("https://example.test/a"); });
+    auto b = std::async(std::launch::async, [&] { return client.get("https://example.test/b"); });
+    originPtr->waitUntilStarted(2);
+    originPtr->release();
+
+    EXPECT_EQ(a.get(), "body of https://example.test/a");
+    EXPECT_EQ(b.get(), "body of https://example.test/b");
+    EXPECT_EQ(client.stats().deduplicated, 0u);
+}
+
+TEST(CoalescingHttpClientTest, FailureIsDeliveredToEveryWaiter) {
+    auto origin = std::make_unique<GatedOrigin>();
+    origin->fail = true;
+    auto* originPtr = origin.get();
+    CoalescingHttpClient client(std::move(origin));
+
+    auto first = std::async(std::launch::async, [&] { return client.get(URL); });
+    originPtr->waitUntilStarted(1);
+    auto second = std::async(std::launch::async, [&] { return client.get(URL); });
+    waitForDeduplicated(client, 1);
+    originPtr->release();
+
+    EXPECT_THROW(first.get(), HttpException);
+    EXPECT_THROW(second.get(), HttpException);
+    EXPECT_EQ(originPtr->calls, 1);
+}
+
+TEST(CoalescingHttpClientTest, CompletedRequestsAreNotReused) {
+    auto origin = std::make_unique<GatedOrigin>();
+    auto* originPtr = origin.get();
+    originPtr->release();
+    CoalescingHttpClient client(std::move(origin));
+
+    client.get(URL);
+    client.get(URL);
+
+    EXPECT_EQ(originPtr->calls, 2);
+    EXPECT_EQ(client.stats().deduplicated, 0u);
+}
+
+TEST(CoalescingHttpClientTest, NullInnerClientThrows) {
+    EXPECT_THROW(CoalescingHttpClient(nullptr), HttpException);
+}
+
+}  // namespace
+}  // namespace rickmorty
@@ -44,8 +44,8 @@ TEST_F(EpisodeParsingTest, ParsesValidEpisodeJson) {
     EXPECT_EQ(episode.name, "Pilot");
     EXPECT_EQ(episode.airDate, "December 2, 2013");
     EXPECT_EQ(episode.episodeCode, "S01E01");
-    EXPECT_EQ(episode.url, "https://rickandmortyapi.com/api/episode/1");
-    EXPECT_EQ(episode.created, "2017-11-10T12:56:33.798Z");
+    EXPECT_EQ(episode.url(), "https://rickandmortyapi.com/api/episode/1");
+    EXPECT_EQ(formatTimestamp(episode.createdMs), "2017-11-10T12:56:33.798Z");
 }
 
 TEST_F(EpisodeParsingTest, ParsesEpisodeWithAllFields) {
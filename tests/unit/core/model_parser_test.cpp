@@ -0,0 +1,312 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include <fstream>
+#include <sstream>
+#include <nlohmann/json.hpp>
+#include "core/ModelParser.h"
+#include "fakes/SyntheticApiData.h"
+
+namespace rickmorty {
+namespace {
+
+using json = nlohmann::json;
+using ::testing::ElementsAre;
+using ::testing::HasSubstr;
+
+/**
+ * Every parser backend must produce exactly what the from_json (DOM) path
+ * does, so most tests parse the same text both ways and compare. The suite
+ * runs once per backend compiled into core.
+ */
+template<typename Parser>
+class ModelParserTest : public ::testing::Test {
+protected:
+    static std::string fixture(const std::string& path) {
+        std::ifstream file(std::string(RICKMORTY_FIXTURE_DIR) + "/" + path);
+        std::stringstream contents;
+        contents << file.rdbuf();
+        return contents.str();
+    }
+
+    static json characterJson(int id) {
+        return json::parse(testing::syntheticCharacterJson(id));
+    }
+
+    static void expectSame(const LocationReference& a, const LocationReference& b) {
+        EXPECT_EQ(a.name, b.name);
+        EXPECT_EQ(a.id, b.id);
+        EXPECT_EQ(a.url(), b.url());
+    }
+
+    static void expectSame(const Character& a, const Character& b) {
+        EXPECT_EQ(a.id, b.id);
+        EXPECT_EQ(a.name, b.name);
+        EXPECT_EQ(a.status, b.status);
+        EXPECT_EQ(a.species, b.species);
+        EXPECT_EQ(a.type, b.type);
+        EXPECT_EQ(a.gender, b.gender);
+        expectSame(a.origin, b.origin);
+        expectSame(a.location, b.location);
+        EXPECT_EQ(a.imageUrl, b.imageUrl);
+        EXPECT_EQ(a.episodeIds, b.episodeIds);
+        EXPECT_EQ(a.createdMs, b.createdMs);
+    }
+
+    static void expectSame(const Episode& a, const Episode& b) {
+        EXPECT_EQ(a.id, b.id);
+        EXPECT_EQ(a.name, b.name);
+        EXPECT_EQ(a.airDate, b.airDate);
+        EXPECT_EQ(a.episodeCode, b.episodeCode);
+        EXPECT_EQ(a.characterIds, b.characterIds);
+        EXPECT_EQ(a.createdMs, b.createdMs);
+        EXPECT_EQ(a.season, b.season);
+        EXPECT_EQ(a.episodeNumber, b.episodeNumber);
+    }
+
+    static void expectSame(const Location& a, const Location& b) {
+        EXPECT_EQ(a.id, b.id);
+        EXPECT_EQ(a.name, b.name);
+        EXPECT_EQ(a.type, b.type);
+        EXPECT_EQ(a.dimension, b.dimension);
+        EXPECT_EQ(a.residentIds, b.residentIds);
+        EXPECT_EQ(a.createdMs, b.createdMs);
+    }
+};
+
+#ifdef RICKMORTY_JSON_SIMDJSON
+using Parsers = ::testing::Types<NlohmannModelParser, SimdjsonModelParser>;
+#else
+using Parsers = ::testing::Types<NlohmannModelParser>;
+#endif
+
+class ParserNames {
+public:
+    template<typename Parser>
+    static std::string GetName(int) {
+        return Parser::NAME;
+    }
+};
+
+TYPED_TEST_SUITE(ModelParserTest, Parsers, ParserNames);
+
+TYPED_TEST(ModelParserTest, CharactersMatchDomParsing) {
+    for (int id = 1; id <= 30; ++id) {
+        const std::string text = testing::syntheticCharacterJson(id);
+        this->expectSame(TypeParam::parseCharacter(text), json::parse(text).get<Character>());
+    }
+}
+
+TYPED_TEST(ModelParserTest, EpisodesMatchDomParsing) {
+    for (int id = 1; id <= 30; ++id) {
+        const std::string text = testing::syntheticEpisodeJson(id, {1, 2, id + 100});
+        this->expectSame(TypeParam::parseEpisode(text), json::parse(text).get<Episode>());
+    }
+}
+
+TYPED_TEST(ModelParserTest, DecodesEpisodeCode) {
+    Episode episode = TypeParam::parseEpisode(testing::syntheticEpisodeJson(23, {}));
+    EXPECT_EQ(episode.episodeCode, "S03E03");
+    EXPECT_EQ(episode.season, 3);
+    EXPECT_EQ(episode.episodeNumber, 3);
+    EXPECT_TRUE(episode.characterIds.empty());
+}
+
+TYPED_TEST(ModelParserTest, LocationsMatchDomParsing) {
+    const std::string page = testing::syntheticLocationPageJson(1, 20);
+    for (const auto& item : json::parse(page).at("results")) {
+        const std::string text = item.dump();
+        this->expectSame(TypeParam::parseLocation(text), item.get<Location>());
+    }
+}
+
+TYPED_TEST(ModelParserTest, CharacterListAcceptsArrayOrSingleObject) {
+    auto many = TypeParam::parseCharacterList(testing::syntheticCharacterListJson({3, 1, 2}));
+    ASSERT_EQ(many.size(), 3u);
+    EXPECT_EQ(many[0].id, 3);
+    EXPECT_EQ(many[2].id, 2);
+
+    auto one = TypeParam::parseCharacterList(testing::syntheticCharacterListJson({7}));
+    ASSERT_EQ(one.size(), 1u);
+    EXPECT_EQ(one[0].id, 7);
+
+    EXPECT_TRUE(TypeParam::parseCharacterList("[]").empty());
+}
+
+TYPED_TEST(ModelParserTest, PageAppendsResultsAndReturnsInfo) {
+    std::vector<Episode> episodes;
+    episodes.emplace_back();  // Existing content is kept
+
+    PaginationInfo info = TypeParam::parsePage(testing::syntheticEpisodePageJson(3, 51), episodes);
+
+    EXPECT_EQ(info.count, 51);
+    EXPECT_EQ(info.pages, 3);
+    EXPECT_FALSE(info.next.has_value());
+    EXPECT_EQ(info.prev, "https://rickandmortyapi.com/api/episode?page=2");
+    ASSERT_EQ(episodes.size(), 12u);
+    EXPECT_EQ(episodes[1].id, 41);
+    EXPECT_EQ(episodes.back().id, 51);
+}
+
+TYPED_TEST(ModelParserTest, PageWithFieldsInAnyOrder) {
+    std::vector<Character> characters;
+    PaginationInfo info = TypeParam::parsePage(
+        R"({"results": [)" + testing::syntheticCharacterJson(5) + R"(],
+            "extra": {"nested": [1, {"a": null}]},
+            "info": {"pages": 1, "next": null, "count": 1, "prev": null}})",
+        characters);
+
+    EXPECT_EQ(info.count, 1);
+    ASSERT_EQ(characters.size(), 1u);
+    EXPECT_EQ(characters[0].id, 5);
+}
+
+TYPED_TEST(ModelParserTest, PageWithoutResultsThrows) {
+    std::vector<Location> locations;
+    EXPECT_THROW(TypeParam::parsePage(R"({"info": {"count": 0, "pages": 0}})", locations), ModelParseError);
+    EXPECT_THROW(TypeParam::parsePage(R"({"results": []})", locations), ModelParseError);
+}
+
+TYPED_TEST(ModelParserTest, EveryMissingCharacterFieldIsReported) {
+    for (const char* field : {"id", "name", "status", "species", "type", "gender",
+                              "origin", "location", "image", "episode", "url", "created"}) {
+        json j = this->characterJson(1);
+        j.erase(field);
+        try {
+            TypeParam::parseCharacter(j.dump());
+            ADD_FAILURE() << "Expected ModelParseError without '" << field << "'";
+        } catch (const ModelParseError& e) {
+            EXPECT_THAT(e.what(), HasSubstr(std::string("'") + field + "'"));
+        }
+    }
+}
+
+TYPED_TEST(ModelParserTest, ReferenceWithoutNameThrows) {
+    json j = this->characterJson(1);
+    j["origin"].erase("name");
+    EXPECT_THROW(TypeParam::parseCharacter(j.dump()), ModelParseError);
+}
+
+TYPED_TEST(ModelParserTest, NullReferenceUrlIsAllowed) {
+    json j = this->characterJson(1);
+    j["origin"]["url"] = nullptr;
+
+    Character character = TypeParam::parseCharacter(j.dump());
+
+    EXPECT_EQ(character.origin.id, -1);
+    EXPECT_EQ(character.origin.url(), "");
+}
+
+TYPED_TEST(ModelParserTest, WrongValueTypesThrow) {
+    json wrongId = this->characterJson(1);
+    wrongId["id"] = "not_a_number";
+    EXPECT_THROW(TypeParam::parseCharacter(wrongId.dump()), ModelParseError);
+
+    json wrongName = this->characterJson(1);
+    wrongName["name"] = 42;
+    EXPECT_THROW(TypeParam::parseCharacter(wrongName.dump()), ModelParseError);
+
+    json nullName = this->characterJson(1);
+    nullName["name"] = nullptr;
+    EXPECT_THROW(TypeParam::parseCharacter(nullName.dump()), ModelParseError);
+
+    json nestedEpisodes = this->characterJson(1);
+    nestedEpisodes["episode"] = json::array({json::array({"x"})});
+    EXPECT_THROW(TypeParam::parseCharacter(nestedEpisodes.dump()), ModelParseError);
+}
+
+TYPED_TEST(ModelParserTest, BareStringListCountsAsOneElement) {
+    // Mirrors from_json, which iterates a string as a single value
+    json j = this->characterJson(1);
+    j["episode"] = "https://rickandmortyapi.com/api/episode/9";
+
+    EXPECT_THAT(TypeParam::parseCharacter(j.dump()).episodeIds, ElementsAre(9));
+}
+
+TYPED_TEST(ModelParserTest, UnknownFieldsAreIgnored) {
+    json j = this->characterJson(1);
+    j["extra"] = {{"deep", json::array({1, 2, {{"x", true}}})}};
+    j["origin"]["dimension"] = {{"name", "C-137"}};
+
+    Character character = TypeParam::parseCharacter(j.dump());
+
+    EXPECT_EQ(character.id, 1);
+    EXPECT_EQ(character.origin.name, "Location 2");
+}
+
+TYPED_TEST(ModelParserTest, MalformedJsonThrows) {
+    EXPECT_THROW(TypeParam::parseCharacter("{not json"), ModelParseError);
+    EXPECT_THROW(TypeParam::parseCharacter(testing::syntheticCharacterJson(1) + "trailing"), ModelParseError);
+    EXPECT_THROW(TypeParam::parseEpisode("[]"), ModelParseError);
+    EXPECT_THROW(TypeParam::parseCharacterList("[1, 2]"), ModelParseError);
+    EXPECT_THROW(TypeParam::parseLocation(""), ModelParseError);
+}
+
+TYPED_TEST(ModelParserTest, FixturesMatchDomParsing) {
+    const std::string character = this->fixture("characters/single_character.json");
+    this->expectSame(TypeParam::parseCharacter(character), json::parse(character).get<Character>());
+
+    const std::string batch = this->fixture("characters/character_batch.json");
+    const auto domBatch = json::parse(batch).get<std::vector<Character>>();
+    const auto batchResult = TypeParam::parseCharacterList(batch);
+    ASSERT_EQ(batchResult.size(), domBatch.size());
+    for (size_t i = 0; i < domBatch.size(); ++i) {
+        this->expectSame(batchResult[i], domBatch[i]);
+    }
+
+    const std::string episode = this->fixture("episodes/single_episode.json");
+    this->expectSame(TypeParam::parseEpisode(episode), json::parse(episode).get<Episode>());
+
+    const std::string location = this->fixture("locations/single_location.json");
+    this->expectSame(TypeParam::parseLocation(location), json::parse(location).get<Location>());
+
+    const std::string page = this->fixture("episodes/episode_page_1.json");
+    std::vector<Episode> episodes;
+    PaginationInfo info = TypeParam::parsePage(page, episodes);
+    const json domPage = json::parse(page);
+    EXPECT_EQ(info.count, domPage.at("info").get<PaginationInfo>().count);
+    ASSERT_EQ(episodes.size(), domPage.at("results").size());
+    this->expectSame(episodes.back(), domPage.at("results").back().get<Episode>());
+}
+
+TYPED_TEST(ModelParserTest, MalformedFixturesThrow) {
+    EXPECT_THROW(TypeParam::parseCharacter(this->fixture("characters/malformed_character.json")),
+                 ModelParseError);
+    EXPECT_THROW(TypeParam::parseCharacterList(this->fixture("characters/malformed_character.json")),
+                 ModelParseError);
+    EXPECT_THROW(TypeParam::parseEpisode(this->fixture("episodes/malformed_episode.json")), ModelParseError);
+}
+
+TYPED_TEST(ModelParserTest, EpisodeCodeEdgeCasesMatchDomParsing) {
+    for (const char* code : {"S01E01", "S10E12", "S05E03", "INVALID", "", "S01", "E01S01", "SxxEyy"}) {
+        json j = json::parse(testing::syntheticEpisodeJson(1, {1}));
+        j["episode"] = code;
+        const std::string text = j.dump();
+        this->expectSame(TypeParam::parseEpisode(text), j.get<Episode>());
+    }
+}
+
+TYPED_TEST(ModelParserTest, EscapedAndUnicodeStringsMatchDomParsing) {
+    json j = this->characterJson(1);
+    j["name"] = "Rick \"Sanchez\" \\ C-137\n\t";
+    j["species"] = "Humanoïde 人間 🧪";
+    j["origin"]["url"] = "";
+    const std::string text = j.dump(-1, ' ', /*ensure_ascii=*/true);
+
+    Character character = TypeParam::parseCharacter(text);
+
+    this->expectSame(character, j.get<Character>());
+    EXPECT_EQ(character.species, "Humanoïde 人間 🧪");
+    EXPECT_EQ(character.origin.id, -1);
+}
+
+TYPED_TEST(ModelParserTest, NumericVariantsOfIdMatchDomParsing) {
+    for (const char* id : {"42", "42.9", "true", "4294967295"}) {
+        json j = this->characterJson(1);
+        j["id"] = json::parse(id);
+        const std::string text = j.dump();
+        EXPECT_EQ(TypeParam::parseCharacter(text).id, j.get<Character>().id) << id;
+    }
+}
+
+} // namespace
+} // namespace rickmorty
@@ -0,0 +1,156 @@
+#include <gtest/gtest.h>
+#include <chrono>
+#include <deque>
+#include "core/RateLimitedHttpClient.h"
+
+namespace rickmorty {
+namespace {
+
+/**
+ * @brief Origin double that fails with a scripted sequence of errors.
+ *
+ * Each get() pops the next scripted error and throws it; once the script is
+ * empty every request succeeds.
+ */
+class ScriptedOrigin : public IHttpClient {
+public:
+    std::string get(const std::string& url) override {
+        calls++;
+        if (!script.empty()) {
+            HttpException error = script.front();
+            script.pop_front();
+            throw error;
+        }
+        return "body of " + url;
+    }
+
+    std::deque<HttpException> script;
+    int calls = 0;
+};
+
+constexpr const char* URL = "https://rickandmortyapi.com/api/episode?page=1";
+
+HttpException httpError(int code, long retryAfterMs = 0) {
+    return HttpException(HttpException::Type::InvalidResponse,
+        "HTTP error: " + std::to_string(code), code, retryAfterMs);
+}
+
+RateLimitedHttpClient::Policy fastPolicy() {
+    RateLimitedHttpClient::Policy policy;
+    policy.requestsPerSecond = 1000.0;
+    policy.burst = 100.0;
+    policy.maxRetries = 3;
+    policy.baseBackoff = std::chrono::milliseconds(1);
+    policy.maxBackoff = std::chrono::milliseconds(200);
+    return policy;
+}
+
+double elapsedMs(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+TEST(RateLimitedHttpClientTest, BurstWithinBucketIsNotDelayed) {
+    RateLimitedHttpClient client(std::make_unique<ScriptedOrigin>(), fastPolicy());
+
+    for (int i = 0; i < 10; ++i) {
+        client.get(URL);
+    }
+
+    EXPECT_EQ(client.stats().requests, 10u);
+    EXPECT_EQ(client.stats().throttledMs, 0u);
+}
+
+TEST(RateLimitedHttpClientTest, EmptyBucketThrottlesToConfiguredRate) {
+    auto policy = fastPolicy();
+    policy.requestsPerSecond = 100.0;  // one token every 10 ms
+    policy.burst = 2.0;
+    RateLimitedHttpClient client(std::make_unique<ScriptedOrigin>(), policy);
+
+    const auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < 6; ++i) {
+        client.get(URL);
+    }
+
+    // 2 requests from the burst, 4 more at 10 ms each
+    EXPECT_GE(elapsedMs(start), 35.0);
+    EXPECT_GT(client.stats().throttledMs, 0u);
+}
+
+TEST(RateLimitedHttpClientTest, TooManyRequestsHonoursRetryAfter) {
+    auto origin = std::make_unique<ScriptedOrigin>();
+    origin->script.push_back(httpError(429, 50));
+    auto* originPtr = origin.get();
+    RateLimitedHttpClient client(std::move(origin), fastPolicy());
+
+    const auto start = std::chrono::steady_clock::now();
+    EXPECT_EQ(client.get(URL), std::string("body of ") + URL);
+
+    EXPECT_GE(elapsedMs(start), 45.0);
+    EXPECT_EQ(originPtr->calls, 2);
+    EXPECT_EQ(client.stats().rateLimited, 1u);
+    EXPECT_EQ(client.stats().retries, 1u);
+}
+
+TEST(RateLimitedHttpClientTest, RetryAfterBeyondBackoffLimitIsNotWaitedFor) {
+    auto origin = std::make_unique<ScriptedOrigin>();
+    origin->script.push_back(httpError(429, 60000));
+    auto* originPtr = origin.get();
+    RateLimitedHttpClient client(std::move(origin), fastPolicy());
+
+    try {
+        client.get(URL);
+        FAIL() << "Expected HttpException";
+    } catch (const HttpException& e) {
+        EXPECT_EQ(e.httpCode(), 429);
+        EXPECT_EQ(e.retryAfterMs(), 60000);
+    }
+    EXPECT_EQ(originPtr->calls, 1);
+}
+
+TEST(RateLimitedHttpClientTest, ServerErrorsAndTimeoutsAreRetried) {
+    auto origin = std::make_unique<ScriptedOrigin>();
+    origin->script.push_back(httpError(503));
+    origin->script.push_back(HttpException(HttpException::Type::Timeout, "HTTP request timed out"));
+    auto* originPtr = origin.get();
+    RateLimitedHttpClient client(std::move(origin), fastPolicy());
+
+    EXPECT_EQ(client.get(URL), std::string("body of ") + URL);
+    EXPECT_EQ(originPtr->calls, 3);
+    EXPECT_EQ(client.stats().retries, 2u);
+}
+
+TEST(RateLimitedHttpClientTest, GivesUpAfterMaxRetries) {
+    auto origin = std::make_unique<ScriptedOrigin>();
+    for (int i = 0; i < 10; ++i) {
+        origin->script.push_back(httpError(500));
+    }
+    auto* originPtr = origin.get();
+    RateLimitedHttpClient client(std::move(origin), fastPolicy());
+
+    EXPECT_THROW(client.get(URL), HttpException);
+    EXPECT_EQ(originPtr->calls, 4);  // first attempt + maxRetries
+}
+
+TEST(RateLimitedHttpClientTest, ClientErrorsAreNotRetried) {
+    auto origin = std::make_unique<ScriptedOrigin>();
+    origin->script.push_back(HttpException(HttpException::Type::NotFound, "Resource not found", 404));
+    origin->script.push_back(HttpException(HttpException::Type::NetworkError, "Connection refused"));
+    auto* originPtr = origin.get();
+    RateLimitedHttpClient client(std::move(origin), fastPolicy());
+
+    EXPECT_THROW(client.get(URL), HttpException);
+    EXPECT_THROW(client.get(URL), HttpException);
+    EXPECT_EQ(originPtr->calls, 2);
+    EXPECT_EQ(client.stats().retries, 0u);
+}
+
+TEST(RateLimitedHttpClientTest, InvalidConstructionThrows) {
+    EXPECT_THROW(RateLimitedHttpClient(nullptr), HttpException);
+
+    auto policy = fastPolicy();
+    policy.requestsPerSecond = 0;
+    EXPECT_THROW(RateLimitedHttpClient(std::make_unique<ScriptedOrigin>(), policy), HttpException);
+}
+
+}  // namespace
+}  // namespace rickmorty
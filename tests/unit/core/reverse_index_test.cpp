@@ -0,0 +1,52 @@
+#include <gtest/gtest.h>
+#include "core/ReverseIndex.h"
+
+namespace rickmorty {
+namespace {
+
+TEST(ReverseIndexTest, UnknownKeysHaveNoLinks) {
+    ReverseIndex index;
+
+    EXPECT_TRUE(index.get(1).empty());
+    EXPECT_EQ(index.keyCount(), 0u);
+}
+
+TEST(ReverseIndexTest, KeepsLinksSortedAndUnique) {
+    ReverseIndex index;
+    for (int id : {28, 1, 14, 1, 28, 3}) {
+        index.add(2, id);
+    }
+    index.add(5, 1);
+
+    EXPECT_EQ(index.get(2), (std::vector<int>{1, 3, 14, 28}));
+    EXPECT_EQ(index.get(5), (std::vector<int>{1}));
+    EXPECT_EQ(index.keyCount(), 2u);
+}
+
+TEST(ReverseIndexTest, RemovesSingleLinks) {
+    ReverseIndex index;
+    index.add(3, 10);
+    index.add(3, 20);
+
+    index.remove(3, 10);
+    index.remove(3, 99);
+    index.remove(4, 10);
+
+    EXPECT_EQ(index.get(3), (std::vector<int>{20}));
+}
+
+TEST(ReverseIndexTest, DropsKeysWhoseLastLinkIsRemoved) {
+    ReverseIndex index;
+    index.add(3, 10);
+    index.add(4, 10);
+
+    index.remove(3, 10);
+
+    EXPECT_TRUE(index.get(3).empty());
+    EXPECT_EQ(index.keyCount(), 1u);
+    index.clear();
+    EXPECT_EQ(index.keyCount(), 0u);
+}
+
+}  // namespace
+}  // namespace rickmorty
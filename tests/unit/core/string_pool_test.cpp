@@ -0,0 +1,101 @@
+#include <gtest/gtest.h>
+#include <set>
+#include <sstream>
+#include <thread>
+#include <vector>
+#include "core/Models.h"
+#include "core/StringPool.h"
+
+namespace rickmorty {
+namespace {
+
+TEST(StringPoolTest, EqualValuesShareOnePooledCopy) {
+    std::string first = "Humanoid";
+    std::string second = "Human";
+    second += "oid";
+
+    InternedString a(first);
+    InternedString b(second);
+
+    EXPECT_EQ(a.pooled(), b.pooled());
+    EXPECT_EQ(a, b);
+    EXPECT_NE(a, InternedString("Human"));
+}
+
+TEST(StringPoolTest, DefaultIsTheEmptyString) {
+    InternedString empty;
+
+    EXPECT_TRUE(empty.empty());
+    EXPECT_EQ(empty, "");
+    EXPECT_EQ(empty.pooled(), InternedString("").pooled());
+}
+
+TEST(StringPoolTest, ReadsLikeAStdString) {
+    InternedString species("Alien");
+    const std::string& ref = species;
+    std::ostringstream out;
+    out << species;
+
+    EXPECT_EQ(ref, "Alien");
+    EXPECT_EQ(species.size(), 5u);
+    EXPECT_STREQ(species.c_str(), "Alien");
+    EXPECT_EQ(out.str(), "Alien");
+    EXPECT_TRUE(species == std::string("Alien"));
+    EXPECT_TRUE(std::string_view("Alien") == species);
+    EXPECT_TRUE(InternedString("Alien") < InternedString("Human"));
+}
+
+TEST(StringPoolTest, RepeatedInterningDoesNotGrowThePool) {
+    InternedString("string_pool_test unique value");
+    const auto before = StringPool::instance().stats();
+
+    for (int i = 0; i < 100; ++i) {
+        InternedString again("string_pool_test unique value");
+    }
+
+    const auto after = StringPool::instance().stats();
+    EXPECT_EQ(after.strings, before.strings);
+    EXPECT_EQ(after.bytes, before.bytes);
+}
+
+TEST(StringPoolTest, ConcurrentInterningAgreesOnAddresses) {
+    constexpr int THREADS = 8;
+    constexpr int VALUES = 200;
+    std::vector<std::vector<const std::string*>> seen(THREADS);
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < THREADS; ++t) {
+        threads.emplace_back([t, &seen]() {
+            for (int i = 0; i < VALUES; ++i) {
+                seen[t].push_back(InternedString("concurrent " + std::to_string(i)).pooled());
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    for (int t = 1; t < THREADS; ++t) {
+        EXPECT_EQ(seen[t], seen[0]);
+    }
+    EXPECT_EQ(std::set<const std::string*>(seen[0].begin(), seen[0].end()).size(),
+              static_cast<size_t>(VALUES));
+}
+
+TEST(StringPoolTest, ParsedCharactersShareLocationStrings) {
+    Character a = nlohmann::json::parse(R"json({"id": 1, "name": "A", "status": "Alive", "species": "Human",
+        "type": "", "gender": "Male", "origin": {"name": "Earth (C-137)", "url": ""},
+        "location": {"name": "Citadel of Ricks", "url": "https://rickandmortyapi.com/api/location/3"},
+        "image": "", "episode": [], "url": "", "created": ""})json").get<Character>();
+    Character b = a;
+    b.location = nlohmann::json::parse(
+        R"({"name": "Citadel of Ricks", "url": "https://rickandmortyapi.com/api/location/3"})")
+        .get<LocationReference>();
+
+    EXPECT_EQ(a.species.pooled(), InternedString("Human").pooled());
+    EXPECT_EQ(a.location.name.pooled(), b.location.name.pooled());
+    EXPECT_EQ(b.location.id, 3);
+}
+
+}  // namespace
+}  // namespace rickmorty
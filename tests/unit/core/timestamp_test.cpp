@@ -0,0 +1,54 @@
+#include <gtest/gtest.h>
+#include "core/Models.h"
+
+namespace rickmorty {
+namespace {
+
+TEST(TimestampTest, ParsesApiTimestampsToEpochMilliseconds) {
+    EXPECT_EQ(parseTimestamp("1970-01-01T00:00:00.000Z"), 0);
+    EXPECT_EQ(parseTimestamp("2017-11-04T18:48:46.250Z"), 1509821326250);
+    EXPECT_EQ(parseTimestamp("2017-11-10T12:56:33.798Z"), 1510318593798);
+}
+
+TEST(TimestampTest, FractionAndZoneDesignatorAreOptional) {
+    EXPECT_EQ(parseTimestamp("2017-11-04T18:48:46Z"), 1509821326000);
+    EXPECT_EQ(parseTimestamp("2017-11-04T18:48:46"), 1509821326000);
+    EXPECT_EQ(parseTimestamp("2017-11-04T18:48:46.5Z"), 1509821326500);
+    // Digits past milliseconds are truncated
+    EXPECT_EQ(parseTimestamp("2017-11-04T18:48:46.2509Z"), 1509821326250);
+}
+
+TEST(TimestampTest, HandlesLeapDaysAndDatesBeforeTheEpoch) {
+    EXPECT_EQ(parseTimestamp("2020-02-29T00:00:00Z"), 1582934400000);
+    EXPECT_EQ(parseTimestamp("2000-03-01T00:00:00Z"), 951868800000);
+    EXPECT_EQ(parseTimestamp("1969-12-31T23:59:59.999Z"), -1);
+}
+
+TEST(TimestampTest, MalformedTextYieldsZero) {
+    for (const char* text : {"", "2017", "2017-11-04", "2017-11-04 18:48:46Z", "2017-13-04T18:48:46Z",
+                             "2017-11-04T24:00:00Z", "2017-11-04T18:48:46.250Z junk", "x017-11-04T18:48:46Z"}) {
+        EXPECT_EQ(parseTimestamp(text), 0) << text;
+    }
+}
+
+TEST(TimestampTest, FormatsInTheApiLayout) {
+    EXPECT_EQ(formatTimestamp(0), "1970-01-01T00:00:00.000Z");
+    EXPECT_EQ(formatTimestamp(-1), "1969-12-31T23:59:59.999Z");
+    EXPECT_EQ(formatTimestamp(1582934400000), "2020-02-29T00:00:00.000Z");
+}
+
+TEST(TimestampTest, MissingCreatedDateFormatsAsEmpty) {
+    EXPECT_EQ(formatCreated(parseTimestamp("")), "");
+    EXPECT_EQ(formatCreated(parseTimestamp("not a date")), "");
+    EXPECT_EQ(formatCreated(parseTimestamp("2017-11-04T18:48:46.250Z")), "2017-11-04T18:48:46.250Z");
+}
+
+TEST(TimestampTest, RoundTripsFixtureTimestamps) {
+    for (const char* text : {"2017-11-04T18:48:46.250Z", "2017-11-10T12:42:04.162Z",
+                             "2017-11-10T12:56:36.618Z", "2017-11-04T19:26:56.301Z"}) {
+        EXPECT_EQ(formatTimestamp(parseTimestamp(text)), text);
+    }
+}
+
+}  // namespace
+}  // namespace rickmorty
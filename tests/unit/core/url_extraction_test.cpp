@@ -151,5 +151,103 @@ TEST_F(UrlExtractionTest, HandlesWhitespaceOnlyAfterSlash) {
     EXPECT_EQ(extractIdFromUrl(url), -1);
 }
 
+TEST_F(UrlExtractionTest, HandlesExplicitPlusSign) {
+    EXPECT_EQ(extractIdFromUrl("https://rickandmortyapi.com/api/character/+42"), 42);
+    EXPECT_EQ(extractIdFromUrl("https://rickandmortyapi.com/api/character/+-42"), -1);
+    EXPECT_EQ(extractIdFromUrl("https://rickandmortyapi.com/api/character/+"), -1);
+}
+
+TEST_F(UrlExtractionTest, HandlesIntBoundaries) {
+    EXPECT_EQ(extractIdFromUrl("/-2147483648"), -2147483647 - 1);
+    EXPECT_EQ(extractIdFromUrl("/2147483648"), -1);
+    EXPECT_EQ(extractIdFromUrl("/-2147483649"), -1);
+}
+
+TEST_F(UrlExtractionTest, AcceptsStringViewOfLargerBuffer) {
+    const std::string buffer = "https://rickandmortyapi.com/api/character/123,456";
+    const std::string_view url(buffer.data(), buffer.find(','));
+    EXPECT_EQ(extractIdFromUrl(url), 123);
+}
+
+// The from_chars version must agree with the std::stoi one it replaced
+TEST_F(UrlExtractionTest, MatchesStoiImplementation) {
+    auto stoiReference = [](const std::string& url) {
+        if (url.empty()) return -1;
+        auto pos = url.rfind('/');
+        if (pos != std::string::npos && pos + 1 < url.size()) {
+            try {
+                return std::stoi(url.substr(pos + 1));
+            } catch (...) {
+                return -1;
+            }
+        }
+        return -1;
+    };
+
+    for (const char* url : {"", "/", "//", "/0", "/00", "/-0", "/+0", "/ \t\n42", "/\v\f\r7x", "/ ", "/-",
+                            "/- 5", "/ -5", "/+ 5", "/12.5", "/1e3", "/0x1F", "/9999999999", "/-9999999999",
+                            "a/b/c/17", "no/digits/here", "/\x80", "https://rickandmortyapi.com/api/episode/51"}) {
+        EXPECT_EQ(extractIdFromUrl(url), stoiReference(url)) << '"' << url << '"';
+    }
+}
+
+// Bulk extraction
+
+TEST_F(UrlExtractionTest, ExtractsIdsFromUrlList) {
+    const std::vector<std::string> urls = {
+        "https://rickandmortyapi.com/api/character/1",
+        "https://rickandmortyapi.com/api/character/abc",
+        "https://rickandmortyapi.com/api/character/826"};
+    std::vector<int> ids = {99};
+
+    extractIdsFromUrls(urls, ids);
+
+    EXPECT_THAT(ids, ::testing::ElementsAre(99, 1, -1, 826));
+}
+
+TEST_F(UrlExtractionTest, ExtractsIdsFromStringViews) {
+    const std::vector<std::string_view> urls = {"/5", "/6"};
+    std::vector<int> ids;
+
+    extractIdsFromUrls(urls, ids);
+
+    EXPECT_THAT(ids, ::testing::ElementsAre(5, 6));
+}
+
+TEST_F(UrlExtractionTest, ExtractsIdsFromJsonArrayOrString) {
+    std::vector<int> ids;
+    extractIdsFromUrls(nlohmann::json::array({"/3", "/4"}), ids);
+    extractIdsFromUrls(nlohmann::json("/8"), ids);
+    extractIdsFromUrls(nlohmann::json(), ids);  // null iterates as empty
+
+    EXPECT_THAT(ids, ::testing::ElementsAre(3, 4, 8));
+    EXPECT_THROW(extractIdsFromUrls(nlohmann::json::array({1}), ids), nlohmann::json::type_error);
+}
+
+// Test URLs rebuilt from ids
+
+TEST_F(UrlExtractionTest, ResourceUrlRoundTripsThroughExtraction) {
+    for (int id : {0, 1, 826, 2147483647}) {
+        EXPECT_EQ(extractIdFromUrl(resourceUrl("character", id)), id);
+    }
+    EXPECT_EQ(resourceUrl("episode", 28), "https://rickandmortyapi.com/api/episode/28");
+}
+
+TEST_F(UrlExtractionTest, ModelUrlsAreRebuiltFromIds) {
+    Character character;
+    character.id = 1;
+    character.origin.id = 3;
+    Episode episode;
+    episode.id = 51;
+    Location location;
+    location.id = 126;
+
+    EXPECT_EQ(character.url(), "https://rickandmortyapi.com/api/character/1");
+    EXPECT_EQ(character.origin.url(), "https://rickandmortyapi.com/api/location/3");
+    EXPECT_EQ(character.location.url(), "");
+    EXPECT_EQ(episode.url(), "https://rickandmortyapi.com/api/episode/51");
+    EXPECT_EQ(location.url(), "https://rickandmortyapi.com/api/location/126");
+}
+
 }  // namespace
 }  // namespace rickmorty